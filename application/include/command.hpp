@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include "utility.hpp"
+
 #include <cstdint>
 
 //--------------------------------------------------------------------------------------------------
@@ -30,7 +32,20 @@ namespace command
     //  Public Data Types
     //----------------------------------------------------------------------------------------------
 
-    typedef char *(*CommandFunc)(uint32_t argc, char **argv);
+    /// @brief Command handler. Output is streamed through the writer in bounded chunks rather than
+    /// being built up in a buffer and returned. Long running commands do a first slice of work and
+    /// leave the rest pending, see resume().
+    ///
+    typedef void (*CommandFunc)(utility::Writer *out, uint32_t argc, char **argv);
+
+    /// @brief Commands sharing a prefix.
+    ///
+    struct Matches
+    {
+        const uint32_t *ids;        // IDs of the matches (indices into the name/function lists)
+        uint32_t        count;      // Number of matches
+        uint32_t        common_len; // Length of the longest prefix common to all matches
+    };
 
     //----------------------------------------------------------------------------------------------
     //  Classes
@@ -45,6 +60,14 @@ namespace command
 
     const char **get_name_list(uint32_t *size);
 
+    bool pending();
+
+    void resume(utility::Writer *out);
+
+    int32_t find(const char *name, uint32_t len);
+
+    Matches match(const char *prefix, uint32_t len);
+
     // End of Namespace
 }
 
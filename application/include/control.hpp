@@ -15,6 +15,7 @@
 #include "output.hpp"
 #include "io.hpp"
 #include "event.hpp"
+#include "utility.hpp"
 
 //--------------------------------------------------------------------------------------------------
 //  Macros and Error Checking
@@ -29,6 +30,7 @@ namespace control
 
     constexpr uint32_t MAX_NAME_LEN = 64;
     constexpr uint32_t CMD_STR_LEN  = 128;
+    constexpr uint32_t MAX_PARKED   = 4; // Events a control can have deferred at once
 
     //----------------------------------------------------------------------------------------------
     //  Public Data Types
@@ -38,6 +40,7 @@ namespace control
     {
         Handled,
         NotHandled,
+        Deferred, // Can't be handled yet, park it until the control recalls its parked events
     };
 
     enum class ID : uint32_t
@@ -68,6 +71,13 @@ namespace control
             ///
             const char *name;
 
+            /// @brief Events the control deferred, waiting to be redelivered. Managed by
+            /// disperse_event.
+            ///
+            event::Event parked[MAX_PARKED];
+            uint32_t     num_parked;
+            bool         recalled;
+
             // -----------------------------------------------------------------
             //  Class Public Functions
             // -----------------------------------------------------------------
@@ -89,9 +99,15 @@ namespace control
             ///
             virtual int32_t set_param(settings::ID setting, uintptr_t value, bool bootup);
 
+            /// @brief Has the parked events redelivered once the current event has been handled.
+            /// Should be called when the control changes to a state that might accept them.
+            ///
+            void recall();
+
             /// @brief Event handler for CLI.
             /// @param evt Event to handle.
-            /// @return Handled to prevent further processing of the event, otherwise NotHandled.
+            /// @return Handled to prevent further processing of the event, Deferred to have it
+            /// redelivered to this control after it calls recall(), otherwise NotHandled.
             ///
             virtual HandleStatus handle_event(event::Event evt) = 0;
 
@@ -116,7 +132,7 @@ namespace control
     //  Public Functions
     //----------------------------------------------------------------------------------------------
 
-    char *get_list_of_controls();
+    void write_list_of_controls(utility::Writer *out);
 
     Control *get_control_by_name(const char *name);
 
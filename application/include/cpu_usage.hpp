@@ -0,0 +1,56 @@
+/// @file cpu_usage.hpp
+/// @author Denver Hoggatt
+/// @brief CPU usage declarations
+///
+/// Copyright (c) 2025 Denver Hoggatt. All rights reserved.
+///
+/// This software is licensed under terms that can be found in the LICENSE file
+/// in the root directory of this software component.
+/// If no LICENSE file comes with this software, it is provided AS-IS.
+///
+
+#pragma once
+
+#include "task.hpp"
+#include "utility.hpp"
+
+#include <cstdint>
+
+//--------------------------------------------------------------------------------------------------
+//  Macros and Error Checking
+//--------------------------------------------------------------------------------------------------
+
+
+namespace cpu_usage
+{
+    //----------------------------------------------------------------------------------------------
+    //  Public Constants
+    //----------------------------------------------------------------------------------------------
+
+    constexpr uint32_t WINDOW_SAMPLES = 5; // Usage is shown over the last this many samples
+
+    // Tasks from tasks.def, plus the idle and timer tasks of the RTOS
+    constexpr uint32_t MAX_TASKS = (uint32_t)task::ID::NumIDs + 2;
+
+    //----------------------------------------------------------------------------------------------
+    //  Public Data Types
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Classes
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Public Functions
+    //----------------------------------------------------------------------------------------------
+
+    void write(utility::Writer *out);
+
+    void init();
+
+    // End of Namespace
+}
+
+// End of File
@@ -76,6 +76,8 @@ namespace error
 
     void ensure(bool ensures, Error err_on_fail, const char *file, const char *func, uint32_t line);
 
+    bool handling();
+
     int32_t get_param(settings::ID setting, uintptr_t value);
 
     int32_t set_param(settings::ID setting, uintptr_t value, bool boot);
@@ -0,0 +1,252 @@
+/// @file logging.hpp
+/// @author Denver Hoggatt
+/// @brief Deferred logging declarations
+///
+/// Copyright (c) 2025 Denver Hoggatt. All rights reserved.
+///
+/// This software is licensed under terms that can be found in the LICENSE file
+/// in the root directory of this software component.
+/// If no LICENSE file comes with this software, it is provided AS-IS.
+///
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+//--------------------------------------------------------------------------------------------------
+//  Macros and Error Checking
+//--------------------------------------------------------------------------------------------------
+
+
+namespace logging
+{
+    //----------------------------------------------------------------------------------------------
+    //  Public Constants
+    //----------------------------------------------------------------------------------------------
+
+    constexpr uint32_t MAX_ARGS    = 4;
+    constexpr uint32_t RING_SIZE   = 64; // Messages that can be waiting to be sent
+    constexpr uint32_t MAX_STR_LEN = 32; // String arguments are cut off after this
+
+    /// @brief Formats of the messages. Only used to check the arguments of write() at compile
+    /// time, so they never make it into the firmware.
+    ///
+    constexpr const char *FORMATS[] = {
+
+#define DEF(log_name, format) format,
+#include "logs.def"
+#undef DEF
+
+    };
+
+    //----------------------------------------------------------------------------------------------
+    //  Public Data Types
+    //----------------------------------------------------------------------------------------------
+
+    enum class ID : uint16_t
+    {
+
+#define DEF(log_name, format) log_name,
+#include "logs.def"
+#undef DEF
+
+        NumIDs,
+    };
+
+    /// @brief How an argument is sent. Two bits per argument are packed into Record::types.
+    ///
+    enum class ArgType : uint8_t
+    {
+        Int,
+        Float,
+        String,
+    };
+
+    /// @brief A message as it sits in the ring, waiting to be sent.
+    ///
+    struct Record
+    {
+        ID        id;
+        uint8_t   num_args;
+        uint8_t   types;
+        uintptr_t args[MAX_ARGS];
+    };
+
+    //----------------------------------------------------------------------------------------------
+    //  Classes
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Public Functions
+    //----------------------------------------------------------------------------------------------
+
+    /// @brief Gets how an argument of the given type is sent.
+    ///
+    template<typename T>
+    constexpr ArgType arg_type()
+    {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            return ArgType::Float;
+        }
+        else if constexpr (std::is_pointer_v<T>
+                           && std::is_same_v<std::remove_cv_t<std::remove_pointer_t<T>>, char>)
+        {
+            return ArgType::String;
+        }
+        else
+        {
+            return ArgType::Int;
+        }
+    }
+
+    /// @brief Checks if a character is one of the given characters.
+    ///
+    consteval bool is_one_of(char c, const char *chars)
+    {
+        for (uint32_t i = 0; chars[i] != '\0'; i++)
+        {
+            if (chars[i] == c)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /// @brief Gets how the decoder reads an argument with the given printf conversion.
+    /// @return False if the conversion isn't one the decoder knows.
+    ///
+    consteval bool conversion_type(char conversion, ArgType *type)
+    {
+        if (conversion == 's')
+        {
+            *type = ArgType::String;
+        }
+        else if (is_one_of(conversion, "fFeEgG"))
+        {
+            *type = ArgType::Float;
+        }
+        else if (is_one_of(conversion, "diouxXcp"))
+        {
+            *type = ArgType::Int;
+        }
+        else
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    /// @brief Checks that the arguments are sent the way the decoder reads them, which is decided
+    /// by the conversions of the format rather than the C++ types.
+    /// @param format Format of the message from logs.def.
+    /// @return True if there's one argument per conversion and every one of them matches.
+    ///
+    template<typename... Args>
+    consteval bool format_matches(const char *format)
+    {
+        const ArgType types[MAX_ARGS + 1] = { arg_type<Args>()... };
+        uint32_t      num_args            = 0;
+
+        for (uint32_t i = 0; format[i] != '\0'; i++)
+        {
+            if (format[i] != '%')
+            {
+                continue;
+            }
+
+            i++;
+            if (format[i] == '%')
+            {
+                continue;
+            }
+
+            // Flags, width, precision and length modifiers don't change how an argument is sent
+            while ((format[i] != '\0') && is_one_of(format[i], "-+ #0123456789.hljztL"))
+            {
+                i++;
+            }
+
+            ArgType type = ArgType::Int;
+            if (!conversion_type(format[i], &type) || (num_args >= sizeof...(Args))
+                || (types[num_args] != type))
+            {
+                return false;
+            }
+
+            num_args++;
+        }
+
+        return num_args == sizeof...(Args);
+    }
+
+    /// @brief Packs the types of the arguments, two bits each, first argument lowest.
+    ///
+    template<typename... Args>
+    constexpr uint8_t arg_types()
+    {
+        uint8_t  types = 0;
+        uint32_t shift = 0;
+
+        ((types |= (uint8_t)((uint32_t)arg_type<Args>() << shift), shift += 2), ...);
+
+        return types;
+    }
+
+    /// @brief Stores an argument as a raw value. Floats are stored as their (single precision)
+    /// bit pattern, strings as their address.
+    ///
+    template<typename T>
+    uintptr_t arg_value(T value)
+    {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            float    single = (float)value;
+            uint32_t bits   = 0;
+            memcpy(&bits, &single, sizeof(bits));
+
+            return bits;
+        }
+        else
+        {
+            return (uintptr_t)value;
+        }
+    }
+
+    void record(ID id, uint8_t types, uint32_t num_args, const uintptr_t *args);
+
+    /// @brief Logs a message. Only the ID and the raw arguments are stored, formatting is done on
+    /// the host (see logs.def), so this is cheap enough to call from anywhere, ISRs included.
+    /// @tparam id Message to log.
+    /// @param args Arguments of the message, checked against the format at compile time. Strings
+    /// aren't copied, so they must outlive the message (string literals and IO names do).
+    ///
+    template<ID id, typename... Args>
+    void write(Args... args)
+    {
+        static_assert(sizeof...(Args) <= MAX_ARGS, "Too many arguments for a log message");
+        static_assert(format_matches<Args...>(FORMATS[(uint32_t)id]),
+                      "Log arguments don't match the conversions of the format in logs.def");
+
+        constexpr uint8_t types            = arg_types<Args...>();
+        const uintptr_t   values[MAX_ARGS] = { arg_value(args)... };
+
+        record(id, types, sizeof...(Args), values);
+    }
+
+    bool pending();
+
+    void flush();
+
+    void init();
+
+    // End of Namespace
+}
+
+// End of File
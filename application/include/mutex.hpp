@@ -24,6 +24,7 @@ namespace mutex
     //  Public Constants
     //----------------------------------------------------------------------------------------------
 
+    constexpr uint32_t MAX_UART_PORTS = 4; // Ports that can have their own UARTTransmit mutex
 
     //----------------------------------------------------------------------------------------------
     //  Public Data Types
@@ -33,8 +34,10 @@ namespace mutex
     {
         EventHandle,
         Periodic,
+        CPUUsage,
+        UARTTransmit, // First of MAX_UART_PORTS, one per port so they transmit independently
 
-        NumIDs
+        NumIDs = UARTTransmit + MAX_UART_PORTS
     };
 
     //----------------------------------------------------------------------------------------------
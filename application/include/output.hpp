@@ -41,6 +41,8 @@ namespace output
             //  Class Private Variables
             // -----------------------------------------------------------------
 
+            void *shadow_data = nullptr; // Last staged value, see staged.
+            bool  dirty       = false;   // True if shadow_data has not been committed.
 
             // -----------------------------------------------------------------
             //  Class Private Functions
@@ -51,11 +53,38 @@ namespace output
             ///
             virtual void set_output(void *data) = 0;
 
+            /// @brief Writes the data to the hardware.
+            /// @param data Output value to write.
+            ///
+            void write(void *data)
+            {
+                if (this->print_io)
+                {
+                    this->print(data, io::IODirection::output);
+                }
+                this->set_output(data);
+            }
+
+            /// @brief Holds the data in the shadow buffer until the next commit.
+            /// @param data Output value to stage.
+            ///
+            void stage(void *data)
+            {
+                this->shadow_data = data;
+                this->dirty       = true;
+            }
+
         public:
             // -----------------------------------------------------------------
             //  Class Public Variables
             // -----------------------------------------------------------------
 
+            /// @brief True if sets should be held in a shadow buffer until output::commit() is
+            /// called, so that only the final value reaches the hardware. Only use this for outputs
+            /// that hold a level (e.g. GPIO), not a stream (e.g. UART), and only set staged outputs
+            /// from the control task, as that is where the commit happens.
+            ///
+            bool staged = false;
 
             // -----------------------------------------------------------------
             //  Class Public Functions
@@ -65,7 +94,8 @@ namespace output
 
             /// @brief Sets the output. This is implemented as a template to allow for type
             /// conversions, and generic type checking. The provided type must match the type
-            /// associated with the output. If it does not, this will throw an error.
+            /// associated with the output. If it does not, this will throw an error. If the output
+            /// is staged, the value will not be written until the next output::commit().
             /// @tparam T Type of the output.
             /// @param data Output value to set.
             ///
@@ -74,13 +104,18 @@ namespace output
             {
                 REQUIRE(this->output_type, error::InvalidPointer);
                 REQUIRE(typeid(T) == *(this->output_type), error::InvalidType);
-                if (this->print_io)
+                if (this->staged)
                 {
-                    this->print((void *)(uintptr_t)data, io::IODirection::output);
+                    this->stage((void *)(uintptr_t)data);
+                }
+                else
+                {
+                    this->write((void *)(uintptr_t)data);
                 }
-                this->set_output((void *)(uintptr_t)data);
             }
 
+            void commit();
+
             void init_output_info(const std::type_info *type_id, io::IOType io_type);
 
             // End of Class
@@ -101,6 +136,8 @@ namespace output
 
     Output *get_by_name(const char *name);
 
+    void commit();
+
     // End of Namespace
 }
 
@@ -24,6 +24,13 @@ namespace periodic
     //  Public Constants
     //----------------------------------------------------------------------------------------------
 
+    // Share of the CPU the periodics in periodics.def may take between them, if each ran for its
+    // whole budget at its shortest period. Checked at build time.
+    constexpr uint32_t MAX_UTILIZATION_PERCENT = 20;
+
+    // Upper bounds (exclusive) of the lateness histogram bins. The last bin takes everything else.
+    constexpr uint32_t LATENESS_BINS_US[] = { 250, 500, 1000, 2000, 5000, 10000 };
+    constexpr uint32_t NUM_LATENESS_BINS  = (sizeof(LATENESS_BINS_US) / sizeof(uint32_t)) + 1;
 
     //----------------------------------------------------------------------------------------------
     //  Public Data Types
@@ -33,12 +40,38 @@ namespace periodic
 
     enum class ID : uint32_t
     {
-        Test,
-        ADCConversion,
+
+#define DEF(periodic_name, period_ms, budget_us, context, exec) periodic_name,
+#include "periodics.def"
+#undef DEF
 
         NumIDs,
     };
 
+    /// @brief Where a periodic's callback runs.
+    ///
+    enum class Exec : uint32_t
+    {
+        ISR,    // Alarm interrupt, for short jitter-critical work that's safe in an ISR
+        Daemon, // Timer task of the RTOS, for light work
+        Task,   // Owning task, for heavy work or work that touches the task's state
+    };
+
+    /// @brief Timing of a periodic's calls. Lateness is how long after its deadline a call
+    /// started, execution time is how long the callback ran for.
+    ///
+    struct Stats
+    {
+        uint32_t calls;
+        uint32_t late_min_us;
+        uint32_t late_max_us;
+        uint32_t late_bins[NUM_LATENESS_BINS];
+        uint32_t exec_mean_us;
+        uint32_t exec_max_us;
+        uint32_t overruns; // Calls that ran for longer than the period
+        uint32_t skipped;  // Periods skipped because the call before was too late
+    };
+
     //----------------------------------------------------------------------------------------------
     //  Classes
     //----------------------------------------------------------------------------------------------
@@ -52,7 +85,19 @@ namespace periodic
 
     void start(ID id);
 
-    void create(ID id, uint32_t period_ms, CallbackFunc func);
+    void create(ID id, CallbackFunc func);
+
+    void set_period(ID id, uint32_t period_ms);
+
+    uint32_t budget_us(ID id);
+
+    const char *name(ID id);
+
+    Stats get_stats(ID id);
+
+    void reset_stats();
+
+    void run(ID id);
 
     // End of Namespace
 }
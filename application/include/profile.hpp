@@ -0,0 +1,129 @@
+/// @file profile.hpp
+/// @author Denver Hoggatt
+/// @brief Profiling zone declarations
+///
+/// Copyright (c) 2025 Denver Hoggatt. All rights reserved.
+///
+/// This software is licensed under terms that can be found in the LICENSE file
+/// in the root directory of this software component.
+/// If no LICENSE file comes with this software, it is provided AS-IS.
+///
+
+#pragma once
+
+#include "systime.hpp"
+
+#include <cstdint>
+
+//--------------------------------------------------------------------------------------------------
+//  Macros and Error Checking
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Times the rest of the enclosing scope as the given zone (see zones.def). Only one zone
+/// can be opened per scope. Compiles to nothing unless the build has profiling turned on.
+///
+#if defined(PROFILING)
+    #define PROFILE_ZONE(zone_name) \
+        profile::Scope profile_scope; \
+        profile_scope.open(profile::Zone::zone_name)
+#else
+    #define PROFILE_ZONE(zone_name) ((void)0)
+#endif
+
+namespace profile
+{
+    //----------------------------------------------------------------------------------------------
+    //  Public Constants
+    //----------------------------------------------------------------------------------------------
+
+#if defined(PROFILING)
+    constexpr bool ENABLED = true;
+#else
+    constexpr bool ENABLED = false;
+#endif
+
+    //----------------------------------------------------------------------------------------------
+    //  Public Data Types
+    //----------------------------------------------------------------------------------------------
+
+    enum class Zone : uint32_t
+    {
+
+#define DEF(zone_name, zone_str) zone_name,
+#include "zones.def"
+#undef DEF
+
+        NumZones,
+    };
+
+    /// @brief Time spent in a zone, per pass through it.
+    ///
+    struct Stats
+    {
+        uint32_t count;
+        uint32_t min_us;
+        uint32_t max_us;
+        uint32_t mean_us;
+    };
+
+    //----------------------------------------------------------------------------------------------
+    //  Classes
+    //----------------------------------------------------------------------------------------------
+
+    /// @brief Records the time from open() until it goes out of scope. Use PROFILE_ZONE rather
+    /// than this directly, so zones cost nothing when profiling is turned off.
+    ///
+    class Scope
+    {
+        private:
+            // -----------------------------------------------------------------
+            //  Class Private Variables
+            // -----------------------------------------------------------------
+
+            Zone     zone = Zone::NumZones; // Nothing is recorded until opened
+            uint32_t start = 0;
+
+            // -----------------------------------------------------------------
+            //  Class Private Functions
+            // -----------------------------------------------------------------
+
+
+        public:
+            // -----------------------------------------------------------------
+            //  Class Public Variables
+            // -----------------------------------------------------------------
+
+
+            // -----------------------------------------------------------------
+            //  Class Public Functions
+            // -----------------------------------------------------------------
+
+            void open(Zone zone)
+            {
+                this->zone  = zone;
+                this->start = systime::ticks();
+            }
+
+            ~Scope();
+
+            // End of Class
+    };
+
+    //----------------------------------------------------------------------------------------------
+    //  Public Functions
+    //----------------------------------------------------------------------------------------------
+
+    void record(Zone zone, uint32_t ticks);
+
+    Stats get(Zone zone);
+
+    const char *name(Zone zone);
+
+    void reset();
+
+    void init();
+
+    // End of Namespace
+}
+
+// End of File
@@ -0,0 +1,138 @@
+/// @file protocol.hpp
+/// @author Denver Hoggatt
+/// @brief Binary host protocol declarations
+///
+/// Copyright (c) 2025 Denver Hoggatt. All rights reserved.
+///
+/// This software is licensed under terms that can be found in the LICENSE file
+/// in the root directory of this software component.
+/// If no LICENSE file comes with this software, it is provided AS-IS.
+///
+
+#pragma once
+
+#include "io.hpp"
+#include "input.hpp"
+
+#include <cstdint>
+
+//--------------------------------------------------------------------------------------------------
+//  Macros and Error Checking
+//--------------------------------------------------------------------------------------------------
+
+
+namespace protocol
+{
+    //----------------------------------------------------------------------------------------------
+    //  Public Constants
+    //----------------------------------------------------------------------------------------------
+
+    constexpr char     FRAME_DELIMITER = 0x00;
+    constexpr uint32_t CRC_LEN         = 2;
+    constexpr uint32_t MAX_FRAME_LEN   = 256; // Decoded frame, including header and CRC
+    constexpr uint32_t MAX_ENCODED_LEN = MAX_FRAME_LEN + (MAX_FRAME_LEN / 254) + 1;
+
+    //----------------------------------------------------------------------------------------------
+    //  Public Data Types
+    //----------------------------------------------------------------------------------------------
+
+    // Frames are COBS encoded and terminated by FRAME_DELIMITER. Decoded, a frame is:
+    //
+    //     Request:   [FrameType][seq]         [records...][CRC-16 LE]
+    //     Response:  [FrameType][seq][Status] [records...][CRC-16 LE]
+    //     Telemetry: [FrameType][seq][Status] [samples...][CRC-16 LE]
+    //     Log:       [FrameType][seq]         [messages...][CRC-16 LE]
+    //
+    // Request records are [Op][payload], response records are [Op][Status][payload], where the
+    // payload is only present if the status is Ok. Multi-byte values are little endian.
+    //
+    //     Op          Request payload          Response payload
+    //     Exit        -                        -
+    //     SettingGet  [id:u16]                 [id:u16][len:u8][value]
+    //     SettingSet  [id:u16][len:u8][value]  [id:u16]
+    //     IOGet       [id:u16]                 [id:u16][value:u32]
+    //     IOSet       [id:u16][value:u32]      [id:u16]
+    //     Command     [len:u8][command line]   [len:u8][output]
+    //
+    // Telemetry samples are [id:u16][value:u32].
+    //
+    // Log frames are sent by the logging module whether or not the port is in binary mode, and are
+    // preceded by a delimiter so they can be picked out of text. Messages are [id:varint][args...]
+    // where each arg is a varint, a float as [u32], or a string as [len:u8][chars], as decided by
+    // the C++ type of the argument. The decoder goes by the conversions of the format in logs.def
+    // instead, which are checked against the types at compile time. Varints are LEB128, 7 bits
+    // per byte, low bits first.
+
+    enum class FrameType : uint8_t
+    {
+        Request = 1,
+        Response,
+        Telemetry,
+        Log,
+    };
+
+    enum class Op : uint8_t
+    {
+        Exit,
+        SettingGet,
+        SettingSet,
+        IOGet,
+        IOSet,
+        Command,
+    };
+
+    enum class Status : uint8_t
+    {
+        Ok,
+        BadFrame,
+        BadCRC,
+        UnknownOp,
+        InvalidID,
+        UnknownType,
+        Failed,
+        Truncated,
+    };
+
+    typedef void (*FrameSink)(void *context, const char *data, uint32_t len);
+
+    struct Sample
+    {
+        io::IOID id;
+        uint32_t value;
+    };
+
+    //----------------------------------------------------------------------------------------------
+    //  Classes
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Public Functions
+    //----------------------------------------------------------------------------------------------
+
+    uint16_t crc16(const uint8_t *data, uint32_t len);
+
+    uint32_t cobs_encode(const uint8_t *data, uint32_t len, uint8_t *encoded);
+
+    int32_t cobs_decode(const uint8_t *encoded, uint32_t len, uint8_t *data);
+
+    uint32_t receive(const char *data, uint32_t len);
+
+    Status read_input(input::Input *in, uint32_t *value);
+
+    void send_telemetry(const Sample *samples, uint32_t count);
+
+    bool active();
+
+    bool pending();
+
+    void resume();
+
+    void start();
+
+    void init(FrameSink sink, void *context);
+
+    // End of Namespace
+}
+
+// End of File
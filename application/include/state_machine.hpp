@@ -0,0 +1,261 @@
+/// @file state_machine.hpp
+/// @author Denver Hoggatt
+/// @brief Hierarchical state machine for controls
+///
+/// Copyright (c) 2025 Denver Hoggatt. All rights reserved.
+///
+/// This software is licensed under terms that can be found in the LICENSE file
+/// in the root directory of this software component.
+/// If no LICENSE file comes with this software, it is provided AS-IS.
+///
+
+#pragma once
+
+#include "control.hpp"
+#include "event.hpp"
+#include "error.hpp"
+
+#include <cstdint>
+
+//--------------------------------------------------------------------------------------------------
+//  Macros and Error Checking
+//--------------------------------------------------------------------------------------------------
+
+
+namespace state_machine
+{
+    //----------------------------------------------------------------------------------------------
+    //  Public Constants
+    //----------------------------------------------------------------------------------------------
+
+    /// @brief Transitions allowed within a single dispatch. Running into this means that the entry
+    /// actions of some states keep transitioning to each other.
+    ///
+    constexpr uint32_t MAX_TRANSITIONS = 16;
+
+    //----------------------------------------------------------------------------------------------
+    //  Public Data Types
+    //----------------------------------------------------------------------------------------------
+
+    /// @brief Definition of one state. The states of a machine are given as a table indexed by
+    /// their ID, where StateID::NumStates is used as the parent of top level states. Any of the
+    /// actions can be null.
+    ///
+    template<typename StateID>
+    struct State
+    {
+            StateID parent;
+
+            void (*entry)(); // Run when the state is entered
+            void (*exit)();  // Run when the state is left
+
+            /// Handles an event. Events the state doesn't handle go to its parent.
+            control::HandleStatus (*handle)(event::Event evt);
+    };
+
+    //----------------------------------------------------------------------------------------------
+    //  Classes
+    //----------------------------------------------------------------------------------------------
+
+    /// @brief Runs a table of states. Transitions requested while handling an event (or by entry
+    /// actions) are run to completion before dispatch() returns, so moving between states never
+    /// goes through the event queue. Only external stimuli need to be posted as events.
+    /// @tparam StateID State enum, ending with NumStates.
+    ///
+    template<typename StateID>
+    class Machine
+    {
+        private:
+            // -----------------------------------------------------------------
+            //  Class Private Variables
+            // -----------------------------------------------------------------
+
+            static constexpr uint32_t NUM_STATES = (uint32_t)StateID::NumStates;
+
+            const State<StateID> *states;
+
+            StateID current;
+            StateID target;
+            bool    pending;     // Transition to target requested
+            bool    dispatching; // Transitions will be run before returning
+
+            // -----------------------------------------------------------------
+            //  Class Private Functions
+            // -----------------------------------------------------------------
+
+            /// @brief Checks if a state is the given state or one of its descendants.
+            ///
+            bool within(StateID state, StateID ancestor)
+            {
+                while (state != StateID::NumStates)
+                {
+                    if (state == ancestor)
+                    {
+                        return true;
+                    }
+
+                    state = states[(uint32_t)state].parent;
+                }
+
+                return false;
+            }
+
+            /// @brief Finds the state that is left in place by a transition from the current state
+            /// to the target. Everything below it is exited and entered, so a transition to the
+            /// current state (or one of its ancestors) exits and re-enters it.
+            ///
+            StateID boundary()
+            {
+                StateID state = current;
+                while ((state != StateID::NumStates)
+                       && ((state == target) || !within(target, state)))
+                {
+                    state = states[(uint32_t)state].parent;
+                }
+
+                return state;
+            }
+
+            /// @brief Runs requested transitions until the machine settles.
+            ///
+            void run_transitions()
+            {
+                uint32_t count = 0;
+
+                while (pending)
+                {
+                    INVAR(count < MAX_TRANSITIONS, error::TooManyAttempts);
+                    count++;
+
+                    pending = false;
+
+                    StateID next = target;
+                    StateID top  = boundary();
+
+                    while (current != top)
+                    {
+                        if (states[(uint32_t)current].exit != nullptr)
+                        {
+                            states[(uint32_t)current].exit();
+                        }
+
+                        current = states[(uint32_t)current].parent;
+                    }
+
+                    StateID  path[NUM_STATES];
+                    uint32_t depth = 0;
+                    for (StateID state = next; state != top; state = states[(uint32_t)state].parent)
+                    {
+                        path[depth] = state;
+                        depth++;
+                    }
+
+                    while (depth > 0)
+                    {
+                        depth--;
+                        current = path[depth];
+
+                        if (states[(uint32_t)current].entry != nullptr)
+                        {
+                            states[(uint32_t)current].entry();
+                        }
+                    }
+                }
+            }
+
+        public:
+            // -----------------------------------------------------------------
+            //  Class Public Functions
+            // -----------------------------------------------------------------
+
+            /// @brief Gets the current (innermost) state.
+            ///
+            StateID state()
+            {
+                return current;
+            }
+
+            /// @brief Checks if the machine is in the given state, or one of its descendants.
+            ///
+            bool in(StateID state)
+            {
+                return within(current, state);
+            }
+
+            /// @brief Requests a transition to the given state. Called from an action, the
+            /// transition runs once the action returns. Otherwise it runs right away.
+            /// @param next State to transition to.
+            ///
+            void transition(StateID next)
+            {
+                REQUIRE(next < StateID::NumStates, error::InvalidState);
+
+                target  = next;
+                pending = true;
+
+                if (!dispatching)
+                {
+                    dispatching = true;
+                    run_transitions();
+                    dispatching = false;
+                }
+            }
+
+            /// @brief Has the current state, or the nearest ancestor that handles it, handle an
+            /// event, then runs any transitions that were requested.
+            /// @param evt Event to handle.
+            /// @return Status of the state that handled the event.
+            ///
+            control::HandleStatus dispatch(event::Event evt)
+            {
+                REQUIRE(states != nullptr, error::InvalidPointer);
+
+                control::HandleStatus ret_val = control::HandleStatus::NotHandled;
+
+                dispatching = true;
+
+                StateID state = current;
+                while ((state != StateID::NumStates)
+                       && (ret_val == control::HandleStatus::NotHandled) && !pending)
+                {
+                    if (states[(uint32_t)state].handle != nullptr)
+                    {
+                        ret_val = states[(uint32_t)state].handle(evt);
+                    }
+
+                    state = states[(uint32_t)state].parent;
+                }
+
+                run_transitions();
+
+                dispatching = false;
+
+                return ret_val;
+            }
+
+            /// @brief Initializes the machine, entering the initial state (and its ancestors).
+            /// @param table States, indexed by their ID.
+            /// @param initial State to start in.
+            ///
+            void init(const State<StateID> (&table)[NUM_STATES], StateID initial)
+            {
+                states      = table;
+                current     = StateID::NumStates;
+                pending     = false;
+                dispatching = false;
+
+                transition(initial);
+            }
+
+            // End of Class
+    };
+
+    //----------------------------------------------------------------------------------------------
+    //  Public Functions
+    //----------------------------------------------------------------------------------------------
+
+
+    // End of Namespace
+}
+
+// End of File
@@ -0,0 +1,55 @@
+/// @file systime.hpp
+/// @author Denver Hoggatt
+/// @brief Monotonic system time declarations
+///
+/// Copyright (c) 2025 Denver Hoggatt. All rights reserved.
+///
+/// This software is licensed under terms that can be found in the LICENSE file
+/// in the root directory of this software component.
+/// If no LICENSE file comes with this software, it is provided AS-IS.
+///
+
+#pragma once
+
+#include <cstdint>
+
+//--------------------------------------------------------------------------------------------------
+//  Macros and Error Checking
+//--------------------------------------------------------------------------------------------------
+
+
+namespace systime
+{
+    //----------------------------------------------------------------------------------------------
+    //  Public Constants
+    //----------------------------------------------------------------------------------------------
+
+    constexpr uint32_t US_PER_MS = 1000;
+    constexpr uint32_t US_PER_S  = 1000000;
+
+    //----------------------------------------------------------------------------------------------
+    //  Public Data Types
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Classes
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Public Functions
+    //----------------------------------------------------------------------------------------------
+
+    uint32_t ticks();
+
+    uint32_t ticks_to_us(uint32_t ticks);
+
+    uint64_t now_us();
+
+    uint32_t now_ms();
+
+    // End of Namespace
+}
+
+// End of File
@@ -12,6 +12,7 @@
 #pragma once
 
 #include "bits.hpp"
+#include "utility.hpp"
 
 #include <cstdint>
 #include <cstdio>
@@ -71,7 +72,9 @@ namespace task
     //  Public Functions
     //----------------------------------------------------------------------------------------------
 
-    void print_maximum_stack_usage(bool dump);
+    void write_stack_usage(utility::Writer *out, ID id);
+
+    bool write_stack_dump(utility::Writer *out, ID id, uint32_t *offset, uint32_t max_len);
 
     uint32_t num();
 
@@ -39,10 +39,21 @@ namespace uart
         UART_NONE,
 
         UART_CLI,
+#if defined(TESTING)
+        UART_AUX, // Second port for the multi-port tests
+#endif
 
         NumPorts,
     };
 
+    /// @brief Contiguous view into a UART's receive queue. Only valid until it's consumed.
+    ///
+    struct Span
+    {
+        const char *data;
+        uint32_t    len;
+    };
+
     class UART
         : public input::Input
         , public output::Output
@@ -76,6 +87,14 @@ namespace uart
 
             void init();
 
+            uint32_t peek(Span (&spans)[2]);
+
+            void consume(uint32_t len);
+
+            uint32_t dropped();
+
+            void write(const char *data, uint32_t len);
+
             // End of Class
     };
 
@@ -88,7 +107,13 @@ namespace uart
     //  Public Functions
     //----------------------------------------------------------------------------------------------
 
-    void isr_read(char c);
+    void isr_read(VirtualPort port, const char *data, uint32_t len);
+
+    bool isr_transmit(VirtualPort port, char *c);
+
+    bool write_stdout(const char *data, uint32_t len);
+
+    void drain(VirtualPort port);
 
     // End of Namespace
 }
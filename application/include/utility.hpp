@@ -25,16 +25,58 @@ namespace utility
     //  Public Constants
     //----------------------------------------------------------------------------------------------
 
+    constexpr uint32_t WRITER_CHUNK_SIZE = 128;
 
     //----------------------------------------------------------------------------------------------
     //  Public Data Types
     //----------------------------------------------------------------------------------------------
 
+    typedef void (*WriterSink)(void *context, const char *chunk);
 
     //----------------------------------------------------------------------------------------------
     //  Classes
     //----------------------------------------------------------------------------------------------
 
+    /// @brief Streams text to a sink in bounded chunks, so output can be produced incrementally
+    /// without building the whole result in a buffer first.
+    ///
+    class Writer
+    {
+        private:
+            // -----------------------------------------------------------------
+            //  Class Private Variables
+            // -----------------------------------------------------------------
+
+            WriterSink sink;
+            void      *context;
+            char       chunk[WRITER_CHUNK_SIZE + 1]; // +1 \0
+            uint32_t   len;
+
+            // -----------------------------------------------------------------
+            //  Class Private Functions
+            // -----------------------------------------------------------------
+
+
+        public:
+            // -----------------------------------------------------------------
+            //  Class Public Variables
+            // -----------------------------------------------------------------
+
+
+            // -----------------------------------------------------------------
+            //  Class Public Functions
+            // -----------------------------------------------------------------
+
+            void write(const char *str);
+
+            void print(const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+            void flush();
+
+            void init(WriterSink sink, void *context);
+
+            // End of Class
+    };
 
     //----------------------------------------------------------------------------------------------
     //  Public Functions
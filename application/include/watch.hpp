@@ -0,0 +1,60 @@
+/// @file watch.hpp
+/// @author Denver Hoggatt
+/// @brief Input watch declarations
+///
+/// Copyright (c) 2025 Denver Hoggatt. All rights reserved.
+///
+/// This software is licensed under terms that can be found in the LICENSE file
+/// in the root directory of this software component.
+/// If no LICENSE file comes with this software, it is provided AS-IS.
+///
+
+#pragma once
+
+#include "io.hpp"
+#include "utility.hpp"
+
+#include <cstdint>
+
+//--------------------------------------------------------------------------------------------------
+//  Macros and Error Checking
+//--------------------------------------------------------------------------------------------------
+
+
+namespace watch
+{
+    //----------------------------------------------------------------------------------------------
+    //  Public Constants
+    //----------------------------------------------------------------------------------------------
+
+    constexpr uint32_t MAX_INPUTS  = 8;
+    constexpr uint32_t MAX_RATE_HZ = 1000; // Periodics have a 1ms fidelity
+
+    //----------------------------------------------------------------------------------------------
+    //  Public Data Types
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Classes
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Public Functions
+    //----------------------------------------------------------------------------------------------
+
+    void sample(utility::Writer *out, uint32_t time_ms);
+
+    uint32_t overruns();
+
+    bool active();
+
+    void stop();
+
+    bool start(const io::IOID *ids, uint32_t count, uint32_t rate_hz);
+
+    // End of Namespace
+}
+
+// End of File
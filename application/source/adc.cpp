@@ -15,6 +15,7 @@
 #include "error.hpp"
 #include "event.hpp"
 #include "io.hpp"
+#include "logging.hpp"
 #include "periodic.hpp"
 #include "macros.hpp"
 
@@ -31,7 +32,6 @@ namespace
     //  Private Constants
     //----------------------------------------------------------------------------------------------
 
-    constexpr uint32_t CONVERSION_INTERVAL = 1;
 
     //----------------------------------------------------------------------------------------------
     //  Private Data Types
@@ -88,19 +88,22 @@ namespace adc
     //  Class Function Definitions
     //----------------------------------------------------------------------------------------------
 
-    /// @brief Prints the I/O access.
+    /// @brief Logs the I/O access.
     /// @param data Data associated with the access.
     /// @param dir Direction of the access.
     ///
     void ADC::print(void *data, io::IODirection dir)
     {
-        // sign + digits + dot + fractional + null
-        constexpr uint32_t NUM_DIGITS = 1 + 39 + 1 + 6 + 1;
+        float value = *(float *)data;
 
-        static char data_str[NUM_DIGITS + 1]; // +1 \0
-        sprintf(data_str, "%f", (double)(*(float *)data));
-
-        io::print("ADC", this->name, this->id, data_str, dir);
+        if (dir == io::IODirection::input)
+        {
+            logging::write<logging::ID::ADCReceived>(this->name, this->id, value);
+        }
+        else if (dir == io::IODirection::output)
+        {
+            logging::write<logging::ID::ADCSent>(this->name, this->id, value);
+        }
     }
 
     /// @brief Gets the input data.
@@ -119,7 +122,8 @@ namespace adc
         return (void *)(&this->read_val);
     }
 
-    /// @brief Initializes the IO.
+    /// @brief Initializes the IO. The conversions are only started periodically if the platform
+    /// has any to start, otherwise the alarm would wake the core every millisecond for nothing.
     ///
     void ADC::init()
     {
@@ -127,7 +131,12 @@ namespace adc
 
         this->init_input_info(&typeid(float *), io::IOType::ADC);
 
-        periodic::create(periodic::ID::ADCConversion, CONVERSION_INTERVAL, start_conversion);
+        if (!adc_hal::has_conversions())
+        {
+            return;
+        }
+
+        periodic::create(periodic::ID::ADCConversion, start_conversion);
 
         periodic::start(periodic::ID::ADCConversion);
     }
@@ -18,12 +18,20 @@
 #include "settings.hpp"
 #include "flash_hal.hpp"
 #include "power_hal.hpp"
+#include "task.hpp"
+#include "watch.hpp"
+#include "profile.hpp"
+#include "cpu_usage.hpp"
+#include "periodic.hpp"
 
 #include <cstdint>
 #include <cstring>
 #include <cinttypes>
 #include <cstdlib>
 #include <cstdio>
+#include <array>
+#include <algorithm>
+#include <string_view>
 
 //--------------------------------------------------------------------------------------------------
 //  Macros and Error Checking
@@ -38,16 +46,32 @@ namespace
     constexpr char NEWLINE[]      = "\r\n";
     constexpr char INVALID_ARGS[] = "Invalid Number of Arguments\r\n";
 
+    constexpr uint32_t STACK_DUMP_SLICE = 256; // Bytes of stack dumped per step
+
     //----------------------------------------------------------------------------------------------
     //  Private Data Types
     //----------------------------------------------------------------------------------------------
 
+    /// @brief Does the next bounded slice of work of a long running command.
+    /// @return True once the command has finished.
+    ///
+    typedef bool (*StepFunc)(utility::Writer *out);
+
+    /// @brief Where the memory command is in writing out the stacks.
+    ///
+    struct MemListState
+    {
+        uint32_t task;    // Task currently being written
+        uint32_t offset;  // Offset into the stack being dumped
+        bool     dump;    // Dump the stacks as well as their usage
+        bool     dumping; // Usage of the current task was written, now dumping its stack
+    };
 
     //----------------------------------------------------------------------------------------------
     //  Private Function Prototypes
     //----------------------------------------------------------------------------------------------
 
-#define DEF(str, func, descr) char *func(uint32_t argc, char **argv);
+#define DEF(str, func, descr) void func(utility::Writer *out, uint32_t argc, char **argv);
 #include "commands.def"
 #undef DEF
 
@@ -67,11 +91,85 @@ namespace
 #undef DEF
     };
 
+    StepFunc     continuation = nullptr; // Next step of the running command, if it isn't finished
+    MemListState mem_state;
+
+    constexpr std::string_view cmd_name_views[] = {
+#define DEF(str, func, descr) str,
+#include "commands.def"
+#undef DEF
+    };
+
+    constexpr uint32_t NUM_CMDS = sizeof(cmd_name_views) / sizeof(cmd_name_views[0]);
+
+    /// @brief Command IDs (indices into cmd_names/cmd_funcs), sorted by command name at compile
+    /// time so lookups and completion can binary search instead of scanning every command.
+    constexpr std::array<uint32_t, NUM_CMDS> sorted_ids = []() {
+        std::array<uint32_t, NUM_CMDS> ids {};
+        for (uint32_t i = 0; i < NUM_CMDS; i++)
+        {
+            ids[i] = i;
+        }
+
+        std::sort(ids.begin(), ids.end(), [](uint32_t a, uint32_t b) {
+            return cmd_name_views[a] < cmd_name_views[b];
+        });
+
+        return ids;
+    }();
+
+    static_assert(
+        []() {
+            for (uint32_t i = 1; i < NUM_CMDS; i++)
+            {
+                if (cmd_name_views[sorted_ids[i - 1]] == cmd_name_views[sorted_ids[i]])
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }(),
+        "Duplicate command in commands.def");
 
     //----------------------------------------------------------------------------------------------
     //  Private Functions
     //----------------------------------------------------------------------------------------------
 
+    /// @brief Finds the first position in sorted_ids whose name is not less than the given prefix
+    /// (or, if upper is set, whose name is greater than every name starting with the prefix).
+    ///
+    uint32_t bound(const char *prefix, uint32_t len, bool upper)
+    {
+        uint32_t low  = 0;
+        uint32_t high = NUM_CMDS;
+
+        while (low < high)
+        {
+            uint32_t mid = low + ((high - low) / 2);
+            int32_t  cmp = strncmp(cmd_names[sorted_ids[mid]], prefix, len);
+
+            if ((cmp < 0) || (upper && (cmp == 0)))
+            {
+                low = mid + 1;
+            }
+            else
+            {
+                high = mid;
+            }
+        }
+
+        return low;
+    }
+
+    /// @brief Has the rest of the current command run by the given step function, a slice at a
+    /// time, instead of completing it before returning.
+    ///
+    void defer(StepFunc step)
+    {
+        continuation = step;
+    }
+
     input::Input *_get_input_ptr(char *name_or_id)
     {
         uint32_t id = strtoul(name_or_id, NULL, 10);
@@ -90,37 +188,33 @@ namespace
         return ret_val;
     }
 
-    char *_get_input_val(input::Input *input)
+    void _write_input_val(utility::Writer *out, input::Input *input)
     {
-        static char ret_val[command::MAX_STR_LEN];
-
         if (*(input->input_type) == typeid(float *))
         {
             float *ptr = input->get<float *>();
-            sprintf(ret_val, "%f\r\n", (double)(*ptr));
+            out->print("%f\r\n", (double)(*ptr));
         }
         else if (*(input->input_type) == typeid(bool))
         {
-            sprintf(ret_val, "%1d\r\n", input->get<bool>());
+            out->print("%1d\r\n", input->get<bool>());
         }
         else if (*(input->input_type) == typeid(uint32_t))
         {
-            sprintf(ret_val, "%" PRIu32 "\r\n", input->get<uint32_t>());
+            out->print("%" PRIu32 "\r\n", input->get<uint32_t>());
         }
         else if (*(input->input_type) == typeid(int32_t))
         {
-            sprintf(ret_val, "%" PRId32 "\r\n", input->get<int32_t>());
+            out->print("%" PRId32 "\r\n", input->get<int32_t>());
         }
         else if (*(input->input_type) == typeid(char *))
         {
-            sprintf(ret_val, "%s\r\n", input->get<char *>());
+            out->print("%s\r\n", input->get<char *>());
         }
         else
         {
-            sprintf(ret_val, "%s", input->cmd_input());
+            out->write(input->cmd_input());
         }
-
-        return ret_val;
     }
 
     output::Output *_get_output_ptr(char *name_or_id)
@@ -141,25 +235,26 @@ namespace
         return ret_val;
     }
 
-    char *help_func(uint32_t argc, char **argv)
+    void help_func(utility::Writer *out, uint32_t argc, char **argv)
     {
         UNUSED(argc);
         UNUSED(argv);
 
-        static char descriptions[] =
+        static const char descriptions[] =
 #define DEF(str, func, descr) str ": " descr "\r\n"
 #include "commands.def"
 #undef DEF
             ;
 
-        return descriptions;
+        out->write(descriptions);
     }
 
-    char *control_on(uint32_t argc, char **argv)
+    void control_on(utility::Writer *out, uint32_t argc, char **argv)
     {
         if (argc < 1)
         {
-            return (char *)INVALID_ARGS;
+            out->write(INVALID_ARGS);
+            return;
         }
 
         for (uint32_t i = 0; i < argc; i++)
@@ -172,14 +267,15 @@ namespace
             }
         }
 
-        return (char *)NEWLINE;
+        out->write(NEWLINE);
     }
 
-    char *control_off(uint32_t argc, char **argv)
+    void control_off(utility::Writer *out, uint32_t argc, char **argv)
     {
         if (argc < 1)
         {
-            return (char *)INVALID_ARGS;
+            out->write(INVALID_ARGS);
+            return;
         }
 
         for (uint32_t i = 0; i < argc; i++)
@@ -192,46 +288,48 @@ namespace
             }
         }
 
-        return (char *)NEWLINE;
+        out->write(NEWLINE);
     }
 
-    char *control_list(uint32_t argc, char **argv)
+    void control_list(utility::Writer *out, uint32_t argc, char **argv)
     {
         UNUSED(argc);
         UNUSED(argv);
 
-        return control::get_list_of_controls();
+        control::write_list_of_controls(out);
     }
 
-    char *get_input(uint32_t argc, char **argv)
+    void get_input(utility::Writer *out, uint32_t argc, char **argv)
     {
         if (argc < 2)
         {
-            return (char *)INVALID_ARGS;
+            out->write(INVALID_ARGS);
+            return;
         }
 
         input::Input *input = _get_input_ptr(argv[0]);
         if (input == nullptr)
         {
-            static char invalid[] = "Invalid Input\r\n";
-            return invalid;
+            out->write("Invalid Input\r\n");
+            return;
         }
 
-        return _get_input_val(input);
+        _write_input_val(out, input);
     }
 
-    char *set_output(uint32_t argc, char **argv)
+    void set_output(utility::Writer *out, uint32_t argc, char **argv)
     {
         if (argc < 2)
         {
-            return (char *)INVALID_ARGS;
+            out->write(INVALID_ARGS);
+            return;
         }
 
         output::Output *output = _get_output_ptr(argv[0]);
         if (output == nullptr)
         {
-            static char invalid[] = "Invalid Output\r\n";
-            return invalid;
+            out->write("Invalid Output\r\n");
+            return;
         }
 
         uint32_t value = (uintptr_t)strtoul(argv[1], NULL, 10);
@@ -256,10 +354,10 @@ namespace
             output->cmd_output(argc - 1, &argv[1]);
         }
 
-        return (char *)NEWLINE;
+        out->write(NEWLINE);
     }
 
-    char *io_print(uint32_t argc, char **argv)
+    void io_print(utility::Writer *out, uint32_t argc, char **argv)
     {
         uint32_t id             = 0;
         bool     valid_num_args = (argc >= 1);
@@ -284,13 +382,13 @@ namespace
         }
         else
         {
-            printf("Unrecognized I/O\r\n");
+            out->write("Unrecognized I/O\r\n");
         }
 
-        return (char *)NEWLINE;
+        out->write(NEWLINE);
     }
 
-    char *io_quiet(uint32_t argc, char **argv)
+    void io_quiet(utility::Writer *out, uint32_t argc, char **argv)
     {
         uint32_t id             = 0;
         bool     valid_num_args = (argc >= 1);
@@ -315,40 +413,64 @@ namespace
         }
         else
         {
-            printf("Unrecognized I/O\r\n");
+            out->write("Unrecognized I/O\r\n");
         }
 
-        return (char *)NEWLINE;
+        out->write(NEWLINE);
     }
 
-    char *io_list(uint32_t argc, char **argv)
+    void io_watch(utility::Writer *out, uint32_t argc, char **argv)
     {
-        UNUSED(argc);
-        UNUSED(argv);
+        if ((argc == 1) && (strcmp(argv[0], "stop") == 0))
+        {
+            watch::stop();
+            out->print("Missed Samples: %" PRIu32 "\r\n", watch::overruns());
+            return;
+        }
 
-        constexpr uint32_t numids = (uint32_t)io::IOID::NumIDs;
+        if ((argc < 2) || (argc - 1 > watch::MAX_INPUTS))
+        {
+            out->write(INVALID_ARGS);
+            return;
+        }
 
-        constexpr char     first_line[]   = "ID    Name\r\n";
-        constexpr uint32_t first_line_len = const_str_len(first_line);
+        io::IOID ids[watch::MAX_INPUTS];
+        for (uint32_t i = 0; i < argc - 1; i++)
+        {
+            input::Input *input = _get_input_ptr(argv[i]);
+            if (input == nullptr)
+            {
+                out->write("Invalid Input\r\n");
+                return;
+            }
+
+            ids[i] = input->id;
+        }
+
+        uint32_t rate_hz = strtoul(argv[argc - 1], NULL, 10);
+        if (!watch::start(ids, argc - 1, rate_hz))
+        {
+            out->print("Rate must be 1 to %" PRIu32 " Hz and divide it evenly\r\n",
+                       watch::MAX_RATE_HZ);
+            return;
+        }
 
-        constexpr char     spaces[]         = "     ";
-        constexpr uint32_t spaces_len       = const_str_len(spaces);
-        constexpr uint32_t total_spaces_len = spaces_len * numids;
+        out->write(NEWLINE);
+    }
 
-        constexpr uint32_t id_len       = count_digits(numids);
-        constexpr uint32_t total_id_len = id_len * numids;
-        static_assert(spaces_len > id_len);
+    void io_list(utility::Writer *out, uint32_t argc, char **argv)
+    {
+        UNUSED(argc);
+        UNUSED(argv);
 
-        constexpr uint32_t newline_len       = const_str_len(NEWLINE);
-        constexpr uint32_t total_newline_len = newline_len * numids;
+        constexpr uint32_t numids = (uint32_t)io::IOID::NumIDs;
+        constexpr uint32_t id_len = count_digits(numids);
 
-        constexpr uint32_t str_len = first_line_len + newline_len + TOTAL_IO_NAME_SIZE
-                                     + total_spaces_len + total_id_len + total_newline_len;
-        static char ret_val[str_len + 1]; // +1 \0
-        ret_val[0] = '\0';                // Reset from previous call
+        constexpr char spaces[] = "     ";
+        static_assert(const_str_len(spaces) > id_len);
 
-        strcat(ret_val, first_line);
-        strcat(ret_val, NEWLINE);
+        out->write("ID    Name\r\n");
+        out->write(NEWLINE);
 
         for (uint32_t i = 0; i < numids; i++)
         {
@@ -363,145 +485,238 @@ namespace
                 continue; // Only show IO found in input or output lists
             }
 
-            char id_str[id_len + 1]; //+1 \0
-            snprintf(id_str, id_len + 1, "%" PRIu32 "", i);
+            out->print("%" PRIu32 "%s%s\r\n", i, &spaces[count_digits(i) - 1], i_o->name);
+        }
+    }
+
+    /// @brief Writes the usage of one stack, or one slice of a stack dump.
+    /// @return True once all stacks have been written.
+    ///
+    bool mem_list_step(utility::Writer *out)
+    {
+        task::ID id = (task::ID)mem_state.task;
 
-            strcat(ret_val, id_str);
-            strcat(ret_val, &spaces[count_digits(i) - 1]);
-            strcat(ret_val, i_o->name);
-            strcat(ret_val, NEWLINE);
+        if (!mem_state.dumping)
+        {
+            task::write_stack_usage(out, id);
+
+            mem_state.offset  = 0;
+            mem_state.dumping = mem_state.dump;
+        }
+        else if (task::write_stack_dump(out, id, &mem_state.offset, STACK_DUMP_SLICE))
+        {
+            mem_state.dumping = false;
         }
 
-        ENSURE(strlen(ret_val) <= str_len, error::InvalidLength);
+        if (!mem_state.dumping)
+        {
+            mem_state.task++;
+        }
 
-        return ret_val;
+        if (mem_state.task < task::num())
+        {
+            return false;
+        }
+
+        uint8_t *stack_pointer = mem_hal::get_stack_pointer();
+        out->print("Current Stack Pointer (addr): %p\r\n", stack_pointer);
+        out->write(NEWLINE);
+
+        return true;
     }
 
-    char *mem_list(uint32_t argc, char **argv)
+    void mem_list(utility::Writer *out, uint32_t argc, char **argv)
     {
         bool dump = (argc > 0) && (strcmp(argv[0], "dump") == 0);
 
         mem_hal::HeapInfo heap_info = mem_hal::get_heap_info();
-        printf("Heap Usage:\r\n");
-        printf("Heap Start            (addr): %p\r\n", heap_info.base);
-        printf("Heap End              (addr): %p\r\n", heap_info.end);
-        printf("Heap Size            (bytes): %" PRIu32 "\r\n",
-               (uint32_t)(heap_info.end - heap_info.base));
-        printf("Heap Max Used        (bytes): %" PRIu32 "\r\n",
-               (uint32_t)(heap_info.max - heap_info.base));
-        printf("%s", NEWLINE);
+        out->write("Heap Usage:\r\n");
+        out->print("Heap Start            (addr): %p\r\n", heap_info.base);
+        out->print("Heap End              (addr): %p\r\n", heap_info.end);
+        out->print("Heap Size            (bytes): %" PRIu32 "\r\n",
+                   (uint32_t)(heap_info.end - heap_info.base));
+        out->print("Heap Max Used        (bytes): %" PRIu32 "\r\n",
+                   (uint32_t)(heap_info.max - heap_info.base));
+        out->write(NEWLINE);
+
+        mem_state.task    = 0;
+        mem_state.offset  = 0;
+        mem_state.dump    = dump;
+        mem_state.dumping = false;
+
+        defer(mem_list_step);
+    }
+
+    void setting_set(utility::Writer *out, uint32_t argc, char **argv)
+    {
+        if (argc < 2)
+        {
+            out->write(INVALID_ARGS);
+            return;
+        }
 
-        task::print_maximum_stack_usage(dump);
+        uint32_t setting_id = strtoul(argv[0], NULL, 10);
 
-        uint8_t *stack_pointer = mem_hal::get_stack_pointer();
-        printf("Current Stack Pointer (addr): %p\r\n", stack_pointer);
+        settings::set((settings::ID)setting_id, (const char *)argv[1], true);
 
-        return (char *)NEWLINE;
+        out->write(NEWLINE);
     }
 
-    char *setting_set(uint32_t argc, char **argv)
+    void setting_get(utility::Writer *out, uint32_t argc, char **argv)
     {
-        char *ret_val = (char *)INVALID_ARGS;
-
-        if (argc >= 2)
+        if (argc < 1)
         {
-            uint32_t setting_id = strtoul(argv[0], NULL, 10);
+            out->write(INVALID_ARGS);
+            return;
+        }
 
-            settings::set((settings::ID)setting_id, (const char *)argv[1], true);
+        uint32_t setting_id = strtoul(argv[0], NULL, 10);
 
-            ret_val = (char *)NEWLINE;
-        }
+        char setting_val[settings::MAX_STR_LEN + 1];
+        setting_val[0] = '\0';
 
-        return ret_val;
+        settings::get((settings::ID)setting_id, setting_val);
+
+        out->write(setting_val);
+        out->write(NEWLINE);
     }
 
-    char *setting_get(uint32_t argc, char **argv)
+    void flash_write(utility::Writer *out, uint32_t argc, char **argv)
     {
-        char *ret_val = (char *)INVALID_ARGS;
-
-        if (argc >= 1)
+        if (argc <= 1)
         {
-            uint32_t setting_id = strtoul(argv[0], NULL, 10);
-
-            static char setting_val[settings::MAX_STR_LEN + 3];
+            out->write(INVALID_ARGS);
+            return;
+        }
 
-            settings::get((settings::ID)setting_id, setting_val);
+        uint32_t data = strtoul(argv[0], NULL, 16);
+        uint32_t addr = strtoul(argv[1], NULL, 16);
+        flash_hal::write(addr, (uint8_t *)&data, sizeof(uint32_t));
 
-            setting_val[strlen(setting_val)]     = '\r';
-            setting_val[strlen(setting_val) + 1] = '\n';
-            setting_val[strlen(setting_val) + 2] = '\0';
+        out->write(NEWLINE);
+    }
 
-            ret_val = setting_val;
+    void flash_read(utility::Writer *out, uint32_t argc, char **argv)
+    {
+        if (argc <= 0)
+        {
+            out->write(INVALID_ARGS);
+            return;
         }
 
-        return ret_val;
+        uint32_t addr = strtoul(argv[0], NULL, 16);
+        uint32_t data = 0;
+        flash_hal::read(addr, (uint8_t *)&data, sizeof(uint32_t));
+
+        out->print("0x%08" PRIX32 " \r\n", data);
     }
 
-    char *flash_write(uint32_t argc, char **argv)
+    void flash_erase(utility::Writer *out, uint32_t argc, char **argv)
     {
-        char *ret_val = (char *)INVALID_ARGS;
-
-        if (argc > 1)
+        if (argc <= 0)
         {
-            uint32_t data = strtoul(argv[0], NULL, 16);
-            uint32_t addr = strtoul(argv[1], NULL, 16);
-            flash_hal::write(addr, (uint8_t *)&data, sizeof(uint32_t));
-
-            ret_val = (char *)NEWLINE;
+            out->write(INVALID_ARGS);
+            return;
         }
 
-        return ret_val;
+        uint32_t addr = strtoul(argv[0], NULL, 16);
+        flash_hal::erase(addr);
+
+        out->write(NEWLINE);
     }
 
-    char *flash_read(uint32_t argc, char **argv)
+    void top(utility::Writer *out, uint32_t argc, char **argv)
     {
-        char *ret_val = (char *)INVALID_ARGS;
+        UNUSED(argc);
+        UNUSED(argv);
 
-        if (argc <= 0)
+        cpu_usage::write(out);
+    }
+
+    void profile_list(utility::Writer *out, uint32_t argc, char **argv)
+    {
+        bool reset = (argc > 0) && (strcmp(argv[0], "reset") == 0);
+
+        if (!profile::ENABLED)
         {
-            return ret_val;
+            out->write("Profiling is not compiled in, all zones are empty\r\n");
         }
 
-        uint32_t addr = strtoul(argv[0], NULL, 16);
-        uint32_t data = 0;
-        flash_hal::read(addr, (uint8_t *)&data, sizeof(uint32_t));
+        out->print("%-24s %10s %10s %10s %10s\r\n", "Zone", "Count", "Min (us)", "Max (us)",
+                   "Mean (us)");
 
-        constexpr uint32_t str_len = 14; // 0x + 8 + ' ' + \r\n + \0
-        static char        data_str[str_len];
-        snprintf(data_str, str_len, "0x%08" PRIX32 " \r\n", data);
+        for (uint32_t i = 0; i < (uint32_t)profile::Zone::NumZones; i++)
+        {
+            profile::Stats stats = profile::get((profile::Zone)i);
+            out->print("%-24s %10" PRIu32 " %10" PRIu32 " %10" PRIu32 " %10" PRIu32 "\r\n",
+                       profile::name((profile::Zone)i), stats.count, stats.min_us, stats.max_us,
+                       stats.mean_us);
+        }
 
-        ret_val = data_str;
+        if (reset)
+        {
+            profile::reset();
+        }
 
-        return ret_val;
+        out->write(NEWLINE);
     }
 
-    char *flash_erase(uint32_t argc, char **argv)
+    void periodic_stats(utility::Writer *out, uint32_t argc, char **argv)
     {
-        char *ret_val = (char *)INVALID_ARGS;
+        bool reset = (argc > 0) && (strcmp(argv[0], "reset") == 0);
 
-        if (argc <= 0)
+        out->print("%-16s %9s %9s %9s %9s %9s %9s %9s %9s\r\n", "Periodic", "Calls", "Late min",
+                   "Late max", "Exec mean", "Exec max", "Budget", "Overruns", "Skipped");
+
+        for (uint32_t i = 0; i < (uint32_t)periodic::ID::NumIDs; i++)
         {
-            return ret_val;
+            periodic::ID    id    = (periodic::ID)i;
+            periodic::Stats stats = periodic::get_stats(id);
+            out->print("%-16s %9" PRIu32 " %9" PRIu32 " %9" PRIu32 " %9" PRIu32 " %9" PRIu32
+                       " %9" PRIu32 " %9" PRIu32 " %9" PRIu32 "\r\n",
+                       periodic::name(id), stats.calls, stats.late_min_us, stats.late_max_us,
+                       stats.exec_mean_us, stats.exec_max_us, periodic::budget_us(id),
+                       stats.overruns, stats.skipped);
         }
 
-        uint32_t addr = strtoul(argv[0], NULL, 16);
-        flash_hal::erase(addr);
+        out->write("\r\nLateness (us)\r\n");
+        out->print("%-16s", "Periodic");
+        for (uint32_t bin = 0; bin < periodic::NUM_LATENESS_BINS - 1; bin++)
+        {
+            out->print(" <%-7" PRIu32, periodic::LATENESS_BINS_US[bin]);
+        }
+        out->write(" more\r\n");
 
-        ret_val = (char *)NEWLINE;
+        for (uint32_t i = 0; i < (uint32_t)periodic::ID::NumIDs; i++)
+        {
+            periodic::ID    id    = (periodic::ID)i;
+            periodic::Stats stats = periodic::get_stats(id);
 
-        return ret_val;
+            out->print("%-16s", periodic::name(id));
+            for (uint32_t bin = 0; bin < periodic::NUM_LATENESS_BINS; bin++)
+            {
+                out->print(" %8" PRIu32, stats.late_bins[bin]);
+            }
+            out->write(NEWLINE);
+        }
+
+        if (reset)
+        {
+            periodic::reset_stats();
+        }
+
+        out->write(NEWLINE);
     }
 
-    char *reboot(uint32_t argc, char **argv)
+    void reboot(utility::Writer *out, uint32_t argc, char **argv)
     {
         UNUSED(argc);
         UNUSED(argv);
 
-        printf("\r\n");
+        out->write(NEWLINE);
+        out->flush(); // Nothing is coming back after the reset
 
         power_hal::reset();
-
-        return (char *)NEWLINE;
     }
 
     // End of Anonymous Namespace
@@ -530,6 +745,78 @@ namespace command
         return cmd_funcs;
     }
 
+    /// @brief Checks if the last command executed still has work left to do.
+    /// @return True if resume needs to be called.
+    ///
+    bool pending()
+    {
+        return continuation != nullptr;
+    }
+
+    /// @brief Does the next slice of work of the last command executed. Long running commands are
+    /// broken up like this so that other events can be handled in between slices.
+    /// @param out Where the command writes its output.
+    ///
+    void resume(utility::Writer *out)
+    {
+        REQUIRE(continuation != nullptr, error::InvalidPointer);
+
+        if (continuation(out))
+        {
+            continuation = nullptr;
+        }
+    }
+
+    /// @brief Finds a command by its exact name.
+    /// @param name Name to look for (doesn't need to be null terminated).
+    /// @param len Length of the name.
+    /// @return ID of the command (index into the name/function lists), -1 if not found.
+    ///
+    int32_t find(const char *name, uint32_t len)
+    {
+        REQUIRE(name != nullptr, error::InvalidPointer);
+
+        uint32_t pos = bound(name, len, false);
+
+        bool found = (pos < NUM_CMDS) && (strlen(cmd_names[sorted_ids[pos]]) == len)
+                     && (strncmp(cmd_names[sorted_ids[pos]], name, len) == 0);
+
+        return found ? (int32_t)sorted_ids[pos] : -1;
+    }
+
+    /// @brief Finds all commands starting with the given prefix.
+    /// @param prefix Prefix to match (doesn't need to be null terminated).
+    /// @param len Length of the prefix.
+    /// @return Matching commands, in alphabetical order, and the length of their common prefix.
+    ///
+    Matches match(const char *prefix, uint32_t len)
+    {
+        REQUIRE(prefix != nullptr, error::InvalidPointer);
+
+        uint32_t first = bound(prefix, len, false);
+        uint32_t last  = bound(prefix, len, true);
+
+        Matches ret_val;
+        ret_val.ids        = &sorted_ids[first];
+        ret_val.count      = last - first;
+        ret_val.common_len = 0;
+
+        if (ret_val.count > 0)
+        {
+            // The list is sorted, so the first and last matches share the least with each other
+            const char *first_name = cmd_names[sorted_ids[first]];
+            const char *last_name  = cmd_names[sorted_ids[last - 1]];
+
+            while ((first_name[ret_val.common_len] != '\0')
+                   && (first_name[ret_val.common_len] == last_name[ret_val.common_len]))
+            {
+                ret_val.common_len++;
+            }
+        }
+
+        return ret_val;
+    }
+
     /// @brief Returns the list of command names.
     /// @param size Will be set to the size of the list.
     /// @return Command names.
@@ -10,6 +10,7 @@
 ///
 
 #include "control.hpp"
+#include "profile.hpp"
 #include "error.hpp"
 #include "macros.hpp"
 
@@ -51,6 +52,52 @@ namespace
     //  Private Functions
     //----------------------------------------------------------------------------------------------
 
+    /// @brief Parks an event the control couldn't handle yet. An event that's already parked isn't
+    /// parked twice, since delivering it again wouldn't do anything more (e.g. UART input).
+    ///
+    void park(control::Control *ctrl, event::Event event)
+    {
+        for (uint32_t i = 0; i < ctrl->num_parked; i++)
+        {
+            if ((ctrl->parked[i].id == event.id) && (ctrl->parked[i].arg == event.arg))
+            {
+                return;
+            }
+        }
+
+        INVAR(ctrl->num_parked < control::MAX_PARKED, error::QueueOverflow);
+
+        ctrl->parked[ctrl->num_parked] = event;
+        ctrl->num_parked++;
+    }
+
+    /// @brief Redelivers the parked events of a control, if it has recalled them. Events that are
+    /// deferred again go back into the parking buffer. If the control recalls while they are being
+    /// redelivered, they get redelivered again after the next event.
+    ///
+    void redeliver(control::Control *ctrl)
+    {
+        if (!ctrl->recalled)
+        {
+            return;
+        }
+
+        ctrl->recalled = false;
+
+        event::Event events[control::MAX_PARKED];
+        uint32_t     num_events = ctrl->num_parked;
+
+        memcpy(events, ctrl->parked, num_events * sizeof(events[0]));
+        ctrl->num_parked = 0;
+
+        for (uint32_t i = 0; i < num_events; i++)
+        {
+            if (ctrl->handle_event(events[i]) == control::HandleStatus::Deferred)
+            {
+                park(ctrl, events[i]);
+            }
+        }
+    }
 
     // End of Anonymous Namespace
 }
@@ -61,33 +108,17 @@ namespace control
     //  Public Functions
     //----------------------------------------------------------------------------------------------
 
-    char *get_list_of_controls()
+    void write_list_of_controls(utility::Writer *out)
     {
-        constexpr uint32_t sep_len      = 2;
-        constexpr uint32_t disabled_len = 8; // Len Disabled > Enabled
-        constexpr uint32_t newline_len  = 2;
-        constexpr uint32_t line_len     = MAX_NAME_LEN + sep_len + disabled_len + newline_len;
-
-        static char ret_val[(line_len * (uint32_t)ID::NumIDs) + 1]; //+1 \0
-
-        static char sep[sep_len + 1]           = ": ";
-        static char enabled[disabled_len + 1]  = "enabled";
-        static char disabled[disabled_len + 1] = "disabled";
-        static char newline[newline_len + 1]   = "\r\n";
+        REQUIRE(out, error::InvalidPointer);
 
-        ret_val[0] = '\0'; // Reset from last call
         for (uint32_t i = 0; i < (uint32_t)ID::NumIDs; i++)
         {
-            strcat(ret_val, controls[i]->name);
-            strcat(ret_val, sep);
-
-            char *en_dis = controls[i]->enabled ? enabled : disabled;
-            strcat(ret_val, en_dis);
-
-            strcat(ret_val, newline);
+            out->write(controls[i]->name);
+            out->write(": ");
+            out->write(controls[i]->enabled ? "enabled" : "disabled");
+            out->write("\r\n");
         }
-
-        return ret_val;
     }
 
     Control *get_control_by_name(const char *name)
@@ -111,6 +142,8 @@ namespace control
 
     void disperse_event(event::Event event)
     {
+        PROFILE_ZONE(DisperseEvent);
+
         REQUIRE(event.id < event::ID::NumEvents, error::InvalidID);
 
         for (uint32_t i = 0; i < (uint32_t)ID::NumIDs; i++)
@@ -122,6 +155,13 @@ namespace control
 
             HandleStatus status = controls[i]->handle_event(event);
 
+            if (status == HandleStatus::Deferred)
+            {
+                park(controls[i], event);
+            }
+
+            redeliver(controls[i]);
+
             if (status != HandleStatus::NotHandled)
             {
                 break;
@@ -181,6 +221,11 @@ namespace control
     //  Class Function Definitions
     //----------------------------------------------------------------------------------------------
 
+    void Control::recall()
+    {
+        recalled = true;
+    }
+
     int32_t Control::get_param(settings::ID setting, uintptr_t value)
     {
         UNUSED(setting);
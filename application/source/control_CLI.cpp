@@ -14,6 +14,9 @@
 #include "command.hpp"
 #include "event.hpp"
 #include "macros.hpp"
+#include "protocol.hpp"
+#include "watch.hpp"
+#include "state_machine.hpp"
 
 #include <cstdint>
 #include <cinttypes>
@@ -39,22 +42,50 @@ namespace
 
     enum class CLIState : uint32_t
     {
+        Root,
         WritingPrompt,
         WaitingForInput,
+        Busy, // Running a command, input has to wait
         ExecutingCommand,
+        ResumingCommand,
+
+        NumStates
     };
 
     //----------------------------------------------------------------------------------------------
     //  Private Function Prototypes
     //----------------------------------------------------------------------------------------------
 
+    control::HandleStatus handle_root(event::Event evt);
+    void                  enter_writing_prompt();
+    void                  enter_waiting_for_input();
+    control::HandleStatus handle_waiting_for_input(event::Event evt);
+    control::HandleStatus handle_busy(event::Event evt);
+    void                  enter_executing_command();
+    void                  enter_resuming_command();
+    control::HandleStatus handle_resuming_command(event::Event evt);
 
     //----------------------------------------------------------------------------------------------
     //  File Variables
     //----------------------------------------------------------------------------------------------
 
-    CLIState    current_state;
-    uart::UART *console;
+    // Format: { PARENT, ENTRY, EXIT, HANDLE }. Must be in the same order as CLIState.
+    constexpr state_machine::State<CLIState> cli_states[] = {
+        { CLIState::NumStates, nullptr, nullptr, handle_root },
+        { CLIState::Root, enter_writing_prompt, nullptr, nullptr },
+        { CLIState::Root, enter_waiting_for_input, nullptr, handle_waiting_for_input },
+        { CLIState::Root, nullptr, nullptr, handle_busy },
+        { CLIState::Busy, enter_executing_command, nullptr, nullptr },
+        { CLIState::Busy, enter_resuming_command, nullptr, handle_resuming_command },
+    };
+
+    static_assert(sizeof(cli_states) / sizeof(cli_states[0]) == (uint32_t)CLIState::NumStates);
+
+    state_machine::Machine<CLIState> machine;
+    control::Control                *cli_control;
+
+    uart::UART     *console;
+    utility::Writer console_out; // Output of the current event, sent in one write once it's handled
 
     char     current_cmd[control::CMD_STR_LEN + 1]; // +1 for \0
     char     last_cmd[control::CMD_STR_LEN + 1];
@@ -68,15 +99,41 @@ namespace
     ///
     void write_header()
     {
-        console->set<const char *>("Starting Command Line Interface:");
+        console_out.write("Starting Command Line Interface:");
     }
 
     /// @brief Newline sequence
     ///
     void write_newline()
+    {
+        console_out.write("\r\n");
+    }
+
+    /// @brief Writer sink that sends a chunk of output to the console.
+    ///
+    void write_chunk(void *context, const char *chunk)
+    {
+        uart::UART *uart = (uart::UART *)context;
+        uart->set<const char *>(chunk);
+    }
+
+    /// @brief Protocol sink that sends an encoded frame to the console.
+    ///
+    void write_frame(void *context, const char *data, uint32_t len)
+    {
+        console_out.flush(); // Anything written before the frame goes out before it
+
+        uart::UART *uart = (uart::UART *)context;
+        uart->write(data, len);
+    }
+
+    /// @brief Sends everything written while handling the current event to the console. Anything
+    /// printed to stdout in the meantime goes out first.
+    ///
+    void flush_output()
     {
         fflush(stdout);
-        console->set<const char *>("\r\n");
+        console_out.flush();
     }
 
     /// @brief Prompt string
@@ -84,7 +141,7 @@ namespace
     void write_prompt()
     {
         write_newline();
-        console->set<const char *>(">");
+        console_out.write(">");
     }
 
     /// @brief Writes the current command to the console.
@@ -93,26 +150,12 @@ namespace
     {
         write_newline();
         write_prompt();
-        console->set<const char *>(current_cmd);
-    }
-
-    /// @brief Advances the FSM.
-    ///
-    void advance_state(CLIState next_state, bool advance)
-    {
-        current_state = next_state;
-
-        if (advance)
-        {
-            event::post(event::ID::control_UpdateCLIState, nullptr);
-        }
+        console_out.write(current_cmd);
     }
 
-    /// @brief Attempts basic tab completion. A command can be completed if:
-    /// 1) It matches the command that has been entered thus far.
-    /// 2) There is only one match in the existing command list.
-    ///
-    /// If 1 holds, but not 2, then we cannot do tab completion.
+    /// @brief Attempts basic tab completion. The command is extended to the longest prefix shared
+    /// by every command that matches what has been entered thus far. If that adds nothing (no
+    /// match, or the matches diverge right away), then we cannot do tab completion.
     ///
     /// @return True if the tab complete succeeded.
     ///
@@ -122,34 +165,21 @@ namespace
         const char **cmd_list = command::get_name_list(&size);
         REQUIRE(size > 0, error::TooSmall);
 
-        uint32_t    cmd_len         = strlen(current_cmd);
-        const char *remaining_chars = nullptr;
-        for (uint32_t i = 0; i < size; i++)
-        {
-            bool previous_match = remaining_chars != nullptr;
-            bool matches        = strncmp(current_cmd, cmd_list[i], cmd_len) == 0;
-            if (matches && !previous_match)
-            {
-                remaining_chars = &cmd_list[i][strlen(current_cmd)];
-            }
-            else if (matches && previous_match)
-            {
-                remaining_chars = nullptr;
-                break;
-            }
-        }
+        uint32_t         cmd_len = strlen(current_cmd);
+        command::Matches matches = command::match(current_cmd, cmd_len);
 
-        if (remaining_chars == nullptr)
+        if ((matches.count == 0) || (matches.common_len <= cmd_len))
         {
             return false;
         }
 
-        uint32_t remaining_len = strlen(remaining_chars);
+        const char *remaining_chars = &cmd_list[matches.ids[0]][cmd_len];
+        uint32_t    remaining_len   = matches.common_len - cmd_len;
         INVAR(cmd_len + remaining_len <= control::CMD_STR_LEN, error::InvalidLength);
 
-        strncpy(&current_cmd[current_position], remaining_chars, remaining_len + 1);
-        current_cmd[control::CMD_STR_LEN] = '\0'; // Truncate if too long
+        memcpy(&current_cmd[current_position], remaining_chars, remaining_len);
         current_position += remaining_len;
+        current_cmd[current_position] = '\0';
 
         return true;
     }
@@ -167,24 +197,17 @@ namespace
 
         write_newline();
 
-        uint32_t cmd_len = strlen(current_cmd);
-        for (uint32_t i = 0; i < size; i++)
+        uint32_t         cmd_len = strlen(current_cmd);
+        command::Matches matches = command::match(current_cmd, cmd_len);
+        for (uint32_t i = 0; (cmd_len > 0) && (i < matches.count); i++)
         {
-            if (cmd_len == 0)
-            {
-                break;
-            }
-
-            if (strncmp(current_cmd, cmd_list[i], cmd_len) == 0)
-            {
-                console->set<const char *>((char *)cmd_list[i]);
-                console->set<const char *>(" ");
-            }
+            console_out.write(cmd_list[matches.ids[i]]);
+            console_out.write(" ");
         }
 
         write_newline();
         write_prompt();
-        console->set<const char *>(current_cmd);
+        console_out.write(current_cmd);
     }
 
     /// @brief Handles the case where backspace was sent when nothing has been entered yet. If
@@ -244,7 +267,7 @@ namespace
             current_position--;
             exec_cmd = false;
         }
-        else
+        else if (current_position < control::CMD_STR_LEN)
         {
             current_cmd[current_position] = cmd_char;
             current_position++;
@@ -301,7 +324,7 @@ namespace
             write_prompt();
         }
 
-        console->set<const char *>(last_cmd);
+        console_out.write(last_cmd);
 
         strncpy(current_cmd, last_cmd, control::CMD_STR_LEN + 1);
         current_cmd[control::CMD_STR_LEN] = '\0';
@@ -343,7 +366,7 @@ namespace
             char send_str[2];
             send_str[0] = rcvd_char;
             send_str[1] = '\0';
-            console->set<const char *>(send_str);
+            console_out.write(send_str);
         }
     }
 
@@ -361,28 +384,35 @@ namespace
     ///
     void arrow_response()
     {
-        console->set<const char *>("B"); // B = Down
+        console_out.write("B"); // B = Down
     }
 
-    /// @brief Process the UART input.
+    /// @brief Process the UART input. Stops after the character that completes a command, so
+    /// anything received after it is left for the next command. A frame delimiter switches the
+    /// console over to the binary host protocol, which gets everything after it.
+    /// @param cmd Received characters (not null terminated).
+    /// @param len Number of received characters, set to the number of characters processed.
+    /// @return True if the command needs to be executed.
     ///
-    bool process_input(const char *cmd)
+    bool process_input(const char *cmd, uint32_t *len)
     {
         REQUIRE(cmd, error::InvalidPointer);
+        REQUIRE(len, error::InvalidPointer);
 
-        uint32_t cmd_len = strlen(cmd);
-        if (cmd_len > control::CMD_STR_LEN)
-        {
-            cmd_len = control::CMD_STR_LEN;
-        }
+        uint32_t cmd_len = *len;
 
-        bool exec_cmd = false;
-        for (uint32_t i = 0; i < cmd_len; i++)
+        bool     exec_cmd = false;
+        uint32_t i        = 0;
+        while ((i < cmd_len) && !exec_cmd && !protocol::active())
         {
             bool up   = (current_position < 2) ? false : is_up_arrow(cmd[i]);
             bool down = (current_position < 2) ? false : is_down_arrow(cmd[i]);
 
-            if (up)
+            if (cmd[i] == protocol::FRAME_DELIMITER)
+            {
+                protocol::start();
+            }
+            else if (up)
             {
                 arrow_response();
                 load_last_cmd();
@@ -399,15 +429,75 @@ namespace
                 exec_cmd = process_character(cmd[i]);
             }
 
-            if (exec_cmd)
+            i++;
+        }
+
+        *len = i;
+
+        return exec_cmd;
+    }
+
+    /// @brief Processes the received characters in-place in the UART's receive queue, releasing
+    /// only the characters that were processed. While in binary mode, they go to the host protocol,
+    /// and the rest are left in the queue while a command from a frame is still running.
+    /// @return True if the command needs to be executed.
+    ///
+    bool process_received()
+    {
+        uart::Span spans[2];
+        console->peek(spans);
+
+        bool exec_cmd = false;
+        for (uint32_t i = 0; (i < 2) && !exec_cmd && !protocol::pending(); i++)
+        {
+            uint32_t pos = 0;
+            while ((pos < spans[i].len) && !exec_cmd && !protocol::pending())
             {
-                break;
+                uint32_t len = spans[i].len - pos;
+
+                if (protocol::active())
+                {
+                    len = protocol::receive(&spans[i].data[pos], len);
+                    if (!protocol::active())
+                    {
+                        write_prompt(); // Host left binary mode, back to text
+                    }
+                }
+                else
+                {
+                    exec_cmd = process_input(&spans[i].data[pos], &len);
+                }
+
+                console->consume(len);
+                pos += len;
             }
         }
 
         return exec_cmd;
     }
 
+    /// @brief Checks whether an event is input on the console, as every UART port posts the same
+    /// input event with its port as the argument.
+    /// @param evt Event to check.
+    /// @return True if it's console input.
+    ///
+    bool is_console_input(event::Event evt)
+    {
+        return (evt.id == event::ID::control_UARTInput)
+               && ((uart::VirtualPort)(uintptr_t)evt.arg == console->uart_port);
+    }
+
+    /// @brief Checks for input that was received while a command was being executed.
+    ///
+    void check_pending_input()
+    {
+        uart::Span spans[2];
+        if (console->peek(spans) > 0)
+        {
+            event::post(event::ID::control_UARTInput, (void *)(uintptr_t)console->uart_port);
+        }
+    }
+
     /// @brief Gets the arguments list for the current command.
     ///
     char **get_args(uint32_t *size)
@@ -448,50 +538,35 @@ namespace
     ///
     void execute_command()
     {
-        uint32_t     size     = 0;
-        const char **cmd_list = command::get_name_list(&size);
-        REQUIRE(size > 0, error::InvalidLength);
-
-        const char *command_to_exec = nullptr;
-        uint32_t    command_pos     = 0;
-        for (command_pos = 0; command_pos < size; command_pos++)
+        uint32_t name_len = 0;
+        while ((current_cmd[name_len] != ' ') && (current_cmd[name_len] != '\0'))
         {
-            uint32_t cmd_len = strlen(cmd_list[command_pos]);
-
-            bool cmd_match      = strncmp(current_cmd, cmd_list[command_pos], cmd_len) == 0;
-            bool valid_len      = strlen(current_cmd) >= cmd_len;
-            bool valid_arg_list = false;
-            if (valid_len)
-            {
-                valid_arg_list = (current_cmd[cmd_len] == ' ') || (current_cmd[cmd_len] == '\0');
-            }
-
-            if (cmd_match && valid_len && valid_arg_list)
-            {
-                command_to_exec = cmd_list[command_pos];
-                break;
-            }
+            name_len++;
         }
 
-        if ((command_to_exec == nullptr) && (strlen(current_cmd) == 0))
+        int32_t command_pos = command::find(current_cmd, name_len);
+
+        if ((command_pos < 0) && (strlen(current_cmd) == 0))
         {
             return;
         }
 
-        if (command_to_exec == nullptr)
+        if (command_pos < 0)
         {
             save_last_cmd();
 
             write_newline();
-            console->set<const char *>("Invalid Command");
+            console_out.write("Invalid Command");
             write_newline();
-            console->set<const char *>("Please type 'help' for a list of commands");
+            console_out.write("Please type 'help' for a list of commands");
             write_newline();
 
             return;
         }
 
+        uint32_t              size          = 0;
         command::CommandFunc *cmd_func_list = command::get_func_list(&size);
+        REQUIRE((uint32_t)command_pos < size, error::InvalidLength);
 
         save_last_cmd();
 
@@ -499,36 +574,148 @@ namespace
 
         uint32_t argc = 0;
         char   **argv = get_args(&argc);
-        char    *out  = cmd_func_list[command_pos](argc, argv);
-        console->set<const char *>(out);
+
+        cmd_func_list[command_pos](&console_out, argc, argv);
     }
 
-    /// @brief CLI state handler.
+    /// @brief Does the next slice of a long running command, whether it came from the console or
+    /// from a host protocol frame.
     ///
-    void handle_state(const char *rcvd_str)
+    void resume_command()
     {
-        switch (current_state)
+        if (protocol::pending())
         {
-            case CLIState::WaitingForInput: {
-                bool     exec_cmd = process_input(rcvd_str);
-                CLIState next_state
-                    = exec_cmd ? CLIState::ExecutingCommand : CLIState::WaitingForInput;
+            protocol::resume();
+        }
+        else
+        {
+            command::resume(&console_out);
+        }
+    }
 
-                advance_state(next_state, exec_cmd);
-            }
-            break;
+    /// @brief Writes out a sample of the watched inputs.
+    /// @param time_ms Time the sample was taken at.
+    ///
+    void write_watch_sample(uint32_t time_ms)
+    {
+        watch::sample(&console_out, time_ms);
+    }
+
+    /// @brief State to go to once a slice of command has run. Each slice after the first is run
+    /// off its own event, so the events of other controls get handled in between. There's no
+    /// prompt in binary mode.
+    ///
+    CLIState after_command()
+    {
+        if (command::pending() || protocol::pending())
+        {
+            return CLIState::ResumingCommand;
+        }
+
+        return protocol::active() ? CLIState::WaitingForInput : CLIState::WritingPrompt;
+    }
+
+    /// @brief Handles events that don't depend on the state.
+    ///
+    control::HandleStatus handle_root(event::Event evt)
+    {
+        control::HandleStatus ret_val = control::HandleStatus::NotHandled;
+
+        switch (evt.id)
+        {
+            case event::ID::control_IOWatch:
+                write_watch_sample((uint32_t)(uintptr_t)evt.arg);
+                ret_val = control::HandleStatus::Handled;
+                break;
 
-            case CLIState::ExecutingCommand:
-                execute_command();
-                advance_state(CLIState::WritingPrompt, true);
+            case event::ID::control_CLIOutput:
+                console_out.write((const char *)evt.arg);
                 break;
 
-            case CLIState::WritingPrompt:
             default:
-                write_prompt();
-                advance_state(CLIState::WaitingForInput, false);
                 break;
         }
+
+        return ret_val;
+    }
+
+    /// @brief Writes the prompt, then waits for input.
+    ///
+    void enter_writing_prompt()
+    {
+        write_prompt();
+        machine.transition(CLIState::WaitingForInput);
+    }
+
+    /// @brief Gets any input that was deferred, or left over after the last command, handled.
+    ///
+    void enter_waiting_for_input()
+    {
+        cli_control->recall();
+        check_pending_input();
+    }
+
+    /// @brief Processes input, executing the command once it's complete.
+    ///
+    control::HandleStatus handle_waiting_for_input(event::Event evt)
+    {
+        if (!is_console_input(evt))
+        {
+            return control::HandleStatus::NotHandled;
+        }
+
+        if (process_received())
+        {
+            machine.transition(CLIState::ExecutingCommand);
+        }
+        else if (protocol::pending())
+        {
+            machine.transition(CLIState::ResumingCommand);
+        }
+
+        return control::HandleStatus::NotHandled;
+    }
+
+    /// @brief Defers input until the command is done. It's recalled on entering WaitingForInput.
+    ///
+    control::HandleStatus handle_busy(event::Event evt)
+    {
+        if (is_console_input(evt))
+        {
+            return control::HandleStatus::Deferred;
+        }
+
+        return control::HandleStatus::NotHandled;
+    }
+
+    /// @brief Executes the command, then either writes the prompt or starts resuming it.
+    ///
+    void enter_executing_command()
+    {
+        execute_command();
+        machine.transition(after_command());
+    }
+
+    /// @brief Yields until the next slice, by way of the event queue.
+    ///
+    void enter_resuming_command()
+    {
+        event::post(event::ID::control_UpdateCLIState, nullptr);
+    }
+
+    /// @brief Does the next slice of the command.
+    ///
+    control::HandleStatus handle_resuming_command(event::Event evt)
+    {
+        if (evt.id != event::ID::control_UpdateCLIState)
+        {
+            return control::HandleStatus::NotHandled;
+        }
+
+        resume_command();
+        machine.transition(after_command());
+
+        return control::HandleStatus::Handled;
     }
 
     // End of Anonymous Namespace
@@ -551,32 +738,9 @@ namespace control
     ///
     HandleStatus CLI::handle_event(event::Event evt)
     {
-        HandleStatus ret_val = HandleStatus::NotHandled;
-
-        switch (evt.id)
-        {
-            case event::ID::control_UARTInput:
-                if (current_state == CLIState::WaitingForInput)
-                {
-                    handle_state(console->get<const char *>());
-                }
-                else // Currently executing cmd, need to wait until done
-                {
-                    event::post(evt.id, evt.arg);
-                }
-                break;
-
-            case event::ID::control_UpdateCLIState:
-                handle_state(nullptr);
-                ret_val = HandleStatus::Handled;
-                break;
+        HandleStatus ret_val = machine.dispatch(evt);
 
-            case event::ID::control_CLIOutput:
-                console->set<const char *>((const char *)evt.arg);
-
-            default:
-                break;
-        }
+        flush_output();
 
         return ret_val;
     }
@@ -588,12 +752,18 @@ namespace control
         console = dynamic_cast<uart::UART *>(output::get_by_id(io::IOID::UART_CONSOLE));
         REQUIRE(console != nullptr, error::DeviceNotFound);
 
+        console_out.init(write_chunk, console);
+        protocol::init(write_frame, console);
+
+        cli_control = this;
+
         fflush(stdout);
         write_newline();
         write_header();
 
-        current_state = CLIState::WritingPrompt;
-        handle_state(0); // Write first prompt
+        machine.init(cli_states, CLIState::WritingPrompt); // Writes the first prompt
+
+        flush_output();
     }
 
     //----------------------------------------------------------------------------------------------
@@ -11,11 +11,10 @@
 
 #include "control.hpp"
 #include "event.hpp"
-#include "uart.hpp"
+#include "logging.hpp"
 #include "macros.hpp"
 
 #include <cstdint>
-#include <cinttypes>
 
 //--------------------------------------------------------------------------------------------------
 //  Macros and Error Checking
@@ -42,7 +41,6 @@ namespace
     //  File Variables
     //----------------------------------------------------------------------------------------------
 
-    uart::UART *console;
 
     //----------------------------------------------------------------------------------------------
     //  Private Functions
@@ -65,28 +63,21 @@ namespace control
 
     HandleStatus EvtPrint::handle_event(event::Event evt)
     {
-        constexpr uint32_t MAX_STR_SIZE = 128;
-
         HandleStatus ret_val = HandleStatus::NotHandled;
 
         event::QueueInfo info = event::get_queue_info(event::get_associated_task(evt.id));
 
-        char str[MAX_STR_SIZE];
-        snprintf(str,
-                 MAX_STR_SIZE,
-                 "evt id:%" PRIu32 ", arg:0x%p, %" PRIu32 ", size:%" PRIu32 "\r\n",
-                 (uint32_t)evt.id,
-                 evt.arg,
-                 (uint32_t)evt.task,
-                 info.rear_pos - info.front_pos + 1);
-        console->set<const char *>(str);
+        logging::write<logging::ID::Event>(evt.id,
+                                           evt.arg,
+                                           evt.task,
+                                           info.rear_pos - info.front_pos + 1);
 
         return ret_val;
     }
 
     void EvtPrint::init_control()
     {
-        console = dynamic_cast<uart::UART *>(output::get_by_id(io::IOID::UART_CONSOLE));
+        // Nothing to set up, events are logged through the log task.
     }
 
     //----------------------------------------------------------------------------------------------
@@ -0,0 +1,226 @@
+/// @file cpu_usage.cpp
+/// @author Denver Hoggatt
+/// @brief CPU usage definitions
+///
+/// Copyright (c) 2025 Denver Hoggatt. All rights reserved.
+///
+/// This software is licensed under terms that can be found in the LICENSE file
+/// in the root directory of this software component.
+/// If no LICENSE file comes with this software, it is provided AS-IS.
+///
+
+#include "cpu_usage.hpp"
+#include "error.hpp"
+#include "macros.hpp"
+#include "mutex.hpp"
+#include "periodic.hpp"
+#include "systime.hpp"
+#include "task_osal.hpp"
+
+#include <cinttypes>
+#include <cstdint>
+#include <cstring>
+
+//--------------------------------------------------------------------------------------------------
+//  Macros and Error Checking
+//--------------------------------------------------------------------------------------------------
+
+namespace
+{
+    //----------------------------------------------------------------------------------------------
+    //  Private Constants
+    //----------------------------------------------------------------------------------------------
+
+    constexpr uint32_t PERMILLE = 1000; // Usage is worked out in tenths of a percent
+    constexpr uint32_t TENTHS   = 10;
+    constexpr uint32_t MS_PER_S = 1000;
+
+    //----------------------------------------------------------------------------------------------
+    //  Private Data Types
+    //----------------------------------------------------------------------------------------------
+
+    /// @brief Run time of every task at one point in time.
+    ///
+    struct Sample
+    {
+        uint32_t            total_time;
+        uint32_t            idle_wakes;
+        uint32_t            num_tasks;
+        task_osal::RunStats stats[cpu_usage::MAX_TASKS];
+    };
+
+    //----------------------------------------------------------------------------------------------
+    //  Private Function Prototypes
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  File Variables
+    //----------------------------------------------------------------------------------------------
+
+    // Last samples taken, the oldest of which is the start of the window
+    Sample   samples[cpu_usage::WINDOW_SAMPLES];
+    uint32_t next_sample = 0;
+    uint32_t num_samples = 0;
+
+    //----------------------------------------------------------------------------------------------
+    //  Private Functions
+    //----------------------------------------------------------------------------------------------
+
+    void take_sample(Sample *sample)
+    {
+        sample->num_tasks = task_osal::get_run_stats(
+            sample->stats, cpu_usage::MAX_TASKS, &sample->total_time);
+        sample->idle_wakes = task_osal::get_idle_wakes();
+    }
+
+    /// @brief Periodic callback, which moves the window on.
+    /// @param curr_time_ms Current system time.
+    ///
+    void sample_usage(uint32_t curr_time_ms)
+    {
+        UNUSED(curr_time_ms);
+
+        mutex::take(mutex::ID::CPUUsage);
+
+        take_sample(&samples[next_sample]);
+        next_sample = (next_sample + 1) % cpu_usage::WINDOW_SAMPLES;
+        if (num_samples < cpu_usage::WINDOW_SAMPLES)
+        {
+            num_samples++;
+        }
+
+        mutex::give(mutex::ID::CPUUsage);
+    }
+
+    /// @brief Finds a task in a sample.
+    /// @return Stats of the task, or nullptr if it isn't in the sample (e.g. it's new).
+    ///
+    const task_osal::RunStats *find(const Sample *sample, uint32_t number)
+    {
+        for (uint32_t i = 0; i < sample->num_tasks; i++)
+        {
+            if (sample->stats[i].number == number)
+            {
+                return &sample->stats[i];
+            }
+        }
+
+        return nullptr;
+    }
+
+    // End of Anonymous Namespace
+}
+
+namespace cpu_usage
+{
+    //----------------------------------------------------------------------------------------------
+    //  Public Functions
+    //----------------------------------------------------------------------------------------------
+
+    /// @brief Writes how much of the CPU each task has used since the start of the window. Counts
+    /// are differences of wrapping counters, so they're right as long as the window is shorter
+    /// than the run time counter's range. Also writes how often the core was woken up while idle,
+    /// which is what keeps it from sleeping for longer.
+    /// @param out Where to write the usage.
+    ///
+    void write(utility::Writer *out)
+    {
+        REQUIRE(out != nullptr, error::InvalidPointer);
+
+        static Sample start; // Too big for the stack of the calling task
+        static Sample now;
+
+        mutex::take(mutex::ID::CPUUsage);
+
+        if (num_samples > 0)
+        {
+            uint32_t oldest = (next_sample + WINDOW_SAMPLES - num_samples) % WINDOW_SAMPLES;
+            start           = samples[oldest];
+        }
+        else
+        {
+            memset(&start, 0, sizeof(start)); // Nothing sampled yet, go from the start
+        }
+
+        take_sample(&now);
+
+        mutex::give(mutex::ID::CPUUsage);
+
+        uint32_t window_time = now.total_time - start.total_time;
+        uint32_t window_ms   = systime::ticks_to_us(window_time) / systime::US_PER_MS;
+
+        out->print("CPU usage over the last %" PRIu32 " ms:\r\n", window_ms);
+        out->print("%-16s %7s %10s\r\n", "Task", "CPU", "Switches");
+
+        for (uint32_t i = 0; i < now.num_tasks; i++)
+        {
+            const task_osal::RunStats *task  = &now.stats[i];
+            const task_osal::RunStats *begin = find(&start, task->number);
+
+            uint32_t run_time = task->run_time - ((begin != nullptr) ? begin->run_time : 0);
+            uint32_t switches = task->switches - ((begin != nullptr) ? begin->switches : 0);
+
+            uint32_t usage = 0;
+            if (window_time > 0)
+            {
+                usage = (uint32_t)(((uint64_t)run_time * PERMILLE) / window_time);
+            }
+
+            out->print("%-16s %5" PRIu32 ".%" PRIu32 "%% %10" PRIu32 "\r\n",
+                       task->name,
+                       usage / TENTHS,
+                       usage % TENTHS,
+                       switches);
+        }
+
+        uint32_t idle_wakes = now.idle_wakes - start.idle_wakes;
+        uint32_t wake_rate  = 0;
+        if (window_ms > 0)
+        {
+            wake_rate = (uint32_t)(((uint64_t)idle_wakes * MS_PER_S) / window_ms);
+        }
+
+        out->print("Idle wake ups: %" PRIu32 " (%" PRIu32 "/s)\r\n", idle_wakes, wake_rate);
+
+        out->write("\r\n");
+    }
+
+    /// @brief Initializes CPU usage, starting the sampling.
+    ///
+    void init()
+    {
+        sample_usage(0);
+
+        periodic::create(periodic::ID::CPUSample, sample_usage);
+        periodic::start(periodic::ID::CPUSample);
+    }
+
+    //----------------------------------------------------------------------------------------------
+    //  Class Function Definitions
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Class Operator Definitions
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Class Constructor Definitions
+    //----------------------------------------------------------------------------------------------
+
+
+    // End of Namespace
+}
+
+//--------------------------------------------------------------------------------------------------
+// Global Namespace Functions
+//--------------------------------------------------------------------------------------------------
+
+
+//--------------------------------------------------------------------------------------------------
+// Unit Test Accessors
+//--------------------------------------------------------------------------------------------------
+
+// End of File
@@ -59,6 +59,8 @@ namespace
     error::HandlerType handler = error::HandlerType::Reboot;
 #endif
 
+    bool handling_error = false;
+
     ErrorInfo error_defaults[] = {
 
         {
@@ -130,6 +132,8 @@ namespace
     ///
     void handle_error(ErrorInfo err_info)
     {
+        handling_error = true; // Output is polled from here on, see error::handling()
+
         notify(err_info);
 
         switch (handler)
@@ -146,6 +150,7 @@ namespace
                 break;
 
             case error::HandlerType::Exception:
+                handling_error = false; // Execution carries on
 #if defined(TESTING)
                 throw std::runtime_error(err_info.err_str);
 #endif
@@ -221,6 +226,15 @@ namespace error
         do_assert(ensures, error, file, func, line);
     }
 
+    /// @brief Checks whether an error is being handled. Output has to be polled out from then on,
+    /// as the error may have come from an interrupt or left the system unable to drain a queue.
+    /// @return True once an error has been detected, until execution carries on past it.
+    ///
+    bool handling()
+    {
+        return handling_error;
+    }
+
     /// @brief Gets the given parameter.
     /// @param setting Parameter to get.
     /// @param value Value that will be set to the parameter.
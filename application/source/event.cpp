@@ -10,6 +10,7 @@
 ///
 
 #include "event.hpp"
+#include "profile.hpp"
 #include "error.hpp"
 #include "mutex.hpp"
 
@@ -47,7 +48,19 @@ namespace
     std::atomic_uint_fast16_t queue_rears[static_cast<int32_t>(task::ID::NumIDs)];
     std::atomic_uint_fast16_t queue_fronts[static_cast<int32_t>(task::ID::NumIDs)];
 
-    task::ID event_task_assoc[static_cast<uint32_t>(event::ID::NumEvents)];
+    // Indexed by event::ID, as both are generated from events.def in the same order
+    constexpr task::ID event_task_assoc[] = {
+        task::ID::open, // NullEvent, which is never posted
+
+#define DEF(task_name, event_name) task::ID::task_name,
+#include "events.def"
+#undef DEF
+
+    };
+
+    static_assert(sizeof(event_task_assoc) / sizeof(event_task_assoc[0])
+                      == (uint32_t)event::ID::NumEvents,
+                  "Every event needs an entry in event_task_assoc");
 
     //----------------------------------------------------------------------------------------------
     //  Private Functions
@@ -92,6 +105,8 @@ namespace event
     ///
     void post(ID event_id, void *arg)
     {
+        PROFILE_ZONE(EventPost);
+
         REQUIRE(event_id < ID::NumEvents, error::InvalidID);
 
         const uint32_t id      = static_cast<uint32_t>(event_id);
@@ -164,12 +179,6 @@ namespace event
                 task_queues[task][i].task = static_cast<task::ID>(task);
             }
         }
-
-#define DEF(task_name, event_name)                                                      \
-    const uint32_t event_name    = static_cast<uint32_t>(ID::task_name##_##event_name); \
-    event_task_assoc[event_name] = task::ID::task_name;
-#include "events.def"
-#undef DEF
     }
 
     //----------------------------------------------------------------------------------------------
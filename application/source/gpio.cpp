@@ -12,10 +12,10 @@
 #include "gpio.hpp"
 #include "gpio_hal.hpp"
 #include "io.hpp"
+#include "logging.hpp"
 #include "macros.hpp"
 
 #include <cstring>
-#include <cstdio>
 #include <cinttypes>
 
 //--------------------------------------------------------------------------------------------------
@@ -65,10 +65,14 @@ namespace gpio
 
     void GPIO::print(void *data, io::IODirection dir)
     {
-        char data_str[1 + 1]; // +1 \0
-        sprintf(data_str, "%01d", (bool)data);
-
-        io::print("GPIO", this->name, this->id, data_str, dir);
+        if (dir == io::IODirection::input)
+        {
+            logging::write<logging::ID::GPIOReceived>(this->name, this->id, (bool)data);
+        }
+        else if (dir == io::IODirection::output)
+        {
+            logging::write<logging::ID::GPIOSent>(this->name, this->id, (bool)data);
+        }
     }
 
     void *GPIO::get_by_id()
@@ -0,0 +1,388 @@
+/// @file logging.cpp
+/// @author Denver Hoggatt
+/// @brief Deferred logging definitions
+///
+/// Copyright (c) 2025 Denver Hoggatt. All rights reserved.
+///
+/// This software is licensed under terms that can be found in the LICENSE file
+/// in the root directory of this software component.
+/// If no LICENSE file comes with this software, it is provided AS-IS.
+///
+
+#include "logging.hpp"
+#include "error.hpp"
+#include "isr_hal.hpp"
+#include "macros.hpp"
+#include "periodic.hpp"
+#include "protocol.hpp"
+#include "task.hpp"
+#include "uart.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+//--------------------------------------------------------------------------------------------------
+//  Macros and Error Checking
+//--------------------------------------------------------------------------------------------------
+
+namespace
+{
+    //----------------------------------------------------------------------------------------------
+    //  Private Constants
+    //----------------------------------------------------------------------------------------------
+
+    constexpr uint32_t HEADER_LEN = 2; // Type, sequence
+
+    constexpr uint32_t MAX_VARINT_LEN = ((sizeof(uintptr_t) * 8) + 6) / 7;
+
+    // Largest a single message can get once encoded
+    constexpr uint32_t MAX_MESSAGE_LEN
+        = MAX_VARINT_LEN + (logging::MAX_ARGS * (1 + logging::MAX_STR_LEN));
+
+    constexpr uint32_t FRAME_SIZE = protocol::MAX_FRAME_LEN - protocol::CRC_LEN;
+
+    static_assert(HEADER_LEN + MAX_MESSAGE_LEN <= FRAME_SIZE, "Log message can't fit in a frame");
+
+    //----------------------------------------------------------------------------------------------
+    //  Private Data Types
+    //----------------------------------------------------------------------------------------------
+
+    /// @brief Slot in the ring. A slot is claimed by moving the rear past it, and only handed to
+    /// the drain once the message has been written into it.
+    ///
+    struct Slot
+    {
+        std::atomic<bool> ready;
+        logging::Record   record;
+    };
+
+    /// @brief Frame being built up.
+    ///
+    struct Frame
+    {
+        uint8_t  data[protocol::MAX_FRAME_LEN];
+        uint32_t len;
+        uint32_t num_messages;
+    };
+
+    //----------------------------------------------------------------------------------------------
+    //  Private Function Prototypes
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  File Variables
+    //----------------------------------------------------------------------------------------------
+
+    Slot ring[logging::RING_SIZE];
+
+    std::atomic<uint32_t> ring_front; // Next slot to send, only moved by the drain
+    std::atomic<uint32_t> ring_rear;  // Next slot to claim
+    std::atomic<uint32_t> num_dropped;
+
+    uint8_t frame_seq = 0;
+
+    std::atomic<bool> drain_created; // The drain periodic can't be started before init()
+
+    //----------------------------------------------------------------------------------------------
+    //  Private Functions
+    //----------------------------------------------------------------------------------------------
+
+    /// @brief Periodic callback. Only runs once per arm_drain(), so nothing wakes while the ring
+    /// stays empty. Stops itself before checking, so a message logged after the check re-arms it.
+    /// @param curr_time_ms Current system time.
+    ///
+    void signal_drain(uint32_t curr_time_ms)
+    {
+        UNUSED(curr_time_ms);
+
+        periodic::stop(periodic::ID::LogDrain);
+
+        if (logging::pending())
+        {
+            task::send_signal(task::ID::log, task::Signal::GlobalEvent);
+        }
+    }
+
+    /// @brief Makes sure the log task wakes up to send what's in the ring. From a task this starts
+    /// the drain periodic, so messages logged close together go out in one flush. Starting a
+    /// periodic takes a mutex, so from an ISR the log task is signaled directly instead.
+    ///
+    void arm_drain()
+    {
+        if (!drain_created.load())
+        {
+            return;
+        }
+
+        if (isr_hal::is_in_interrupt())
+        {
+            task::send_signal(task::ID::log, task::Signal::GlobalEvent);
+        }
+        else
+        {
+            periodic::start(periodic::ID::LogDrain);
+        }
+    }
+
+    void put_u8(Frame *frame, uint8_t value)
+    {
+        frame->data[frame->len] = value;
+        frame->len++;
+    }
+
+    void put_varint(Frame *frame, uintptr_t value)
+    {
+        while (value >= 0x80)
+        {
+            put_u8(frame, (uint8_t)(value | 0x80));
+            value >>= 7;
+        }
+
+        put_u8(frame, (uint8_t)value);
+    }
+
+    void put_u32(Frame *frame, uint32_t value)
+    {
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            put_u8(frame, (uint8_t)(value >> (8 * i)));
+        }
+    }
+
+    void put_string(Frame *frame, const char *str)
+    {
+        uint32_t len = 0;
+        while ((str != nullptr) && (len < logging::MAX_STR_LEN) && (str[len] != '\0'))
+        {
+            len++;
+        }
+
+        put_u8(frame, (uint8_t)len);
+        if (len > 0)
+        {
+            memcpy(&frame->data[frame->len], str, len);
+            frame->len += len;
+        }
+    }
+
+    /// @brief Encodes a message into the frame. The frame must have MAX_MESSAGE_LEN free.
+    ///
+    void put_message(Frame *frame, const logging::Record *record)
+    {
+        put_varint(frame, (uintptr_t)record->id);
+
+        for (uint32_t i = 0; i < record->num_args; i++)
+        {
+            logging::ArgType type = (logging::ArgType)((record->types >> (2 * i)) & 0x3);
+
+            switch (type)
+            {
+                case logging::ArgType::Float:
+                    put_u32(frame, (uint32_t)record->args[i]);
+                    break;
+
+                case logging::ArgType::String:
+                    put_string(frame, (const char *)record->args[i]);
+                    break;
+
+                default:
+                    put_varint(frame, record->args[i]);
+                    break;
+            }
+        }
+
+        frame->num_messages++;
+    }
+
+    void start_frame(Frame *frame)
+    {
+        frame->len          = 0;
+        frame->num_messages = 0;
+
+        put_u8(frame, (uint8_t)protocol::FrameType::Log);
+        put_u8(frame, frame_seq);
+    }
+
+    /// @brief Adds the CRC, COBS encodes the frame and writes it to the console between two
+    /// delimiters, so that it can be told apart from any text around it. If the console isn't
+    /// open yet the messages in the frame are counted as dropped.
+    ///
+    void send_frame(Frame *frame)
+    {
+        uint16_t crc = protocol::crc16(frame->data, frame->len);
+        put_u8(frame, (uint8_t)crc);
+        put_u8(frame, (uint8_t)(crc >> 8));
+
+        uint8_t encoded[protocol::MAX_ENCODED_LEN + 2]; // +2 delimiters
+        encoded[0]   = protocol::FRAME_DELIMITER;
+        uint32_t len = protocol::cobs_encode(frame->data, frame->len, &encoded[1]) + 1;
+        encoded[len] = protocol::FRAME_DELIMITER;
+
+        if (uart::write_stdout((const char *)encoded, len + 1))
+        {
+            frame_seq++;
+        }
+        else
+        {
+            num_dropped += frame->num_messages;
+        }
+    }
+
+    // End of Anonymous Namespace
+}
+
+namespace logging
+{
+    //----------------------------------------------------------------------------------------------
+    //  Public Functions
+    //----------------------------------------------------------------------------------------------
+
+    /// @brief Adds a message to the ring. Use write() rather than calling this directly, it checks
+    /// the ID and arguments at compile time. Safe to call from any task or ISR: a slot is claimed
+    /// with a single compare-and-swap, and if the ring is full the message is dropped and counted
+    /// instead of waiting on the drain. A failed check here is reported with polled output, which
+    /// is also fine from an ISR (see error::handling()). Arms the drain when the message is the
+    /// first one waiting.
+    /// @param id Message to log.
+    /// @param types Types of the arguments, see arg_types().
+    /// @param num_args Number of arguments.
+    /// @param args Raw arguments.
+    ///
+    void record(ID id, uint8_t types, uint32_t num_args, const uintptr_t *args)
+    {
+        REQUIRE(id < ID::NumIDs, error::InvalidID);
+        REQUIRE(num_args <= MAX_ARGS, error::InvalidLength);
+
+        uint32_t rear = ring_rear.load();
+        do
+        {
+            if (rear - ring_front.load() >= RING_SIZE)
+            {
+                num_dropped++;
+                return;
+            }
+        } while (!ring_rear.compare_exchange_weak(rear, rear + 1));
+
+        Slot *slot = &ring[rear % RING_SIZE];
+
+        slot->record.id       = id;
+        slot->record.num_args = (uint8_t)num_args;
+        slot->record.types    = types;
+        for (uint32_t i = 0; i < num_args; i++)
+        {
+            slot->record.args[i] = args[i];
+        }
+
+        slot->ready.store(true, std::memory_order_release);
+
+        // Checked after the claim, so it can't miss a flush that emptied the ring in the meantime
+        if (ring_front.load() == rear)
+        {
+            arm_drain();
+        }
+    }
+
+    /// @brief Checks if there's anything waiting to be sent.
+    /// @return True if flush() has something to do.
+    ///
+    bool pending()
+    {
+        return (ring_front.load() != ring_rear.load()) || (num_dropped.load() != 0);
+    }
+
+    /// @brief Sends everything in the ring, packing as many messages into each frame as fit.
+    /// Stops early at a slot that has been claimed but not written yet, the rest goes out on the
+    /// next flush, which is armed here. Only the log task should call this.
+    ///
+    void flush()
+    {
+        Frame frame;
+        start_frame(&frame);
+
+        uint32_t dropped = num_dropped.exchange(0);
+        if (dropped != 0)
+        {
+            Record note = { ID::Dropped, 1, (uint8_t)ArgType::Int, { dropped } };
+            put_message(&frame, &note);
+        }
+
+        uint32_t front = ring_front.load();
+        while (front != ring_rear.load())
+        {
+            Slot *slot = &ring[front % RING_SIZE];
+            if (!slot->ready.load(std::memory_order_acquire))
+            {
+                break;
+            }
+
+            if (frame.len + MAX_MESSAGE_LEN > FRAME_SIZE)
+            {
+                send_frame(&frame);
+                start_frame(&frame);
+            }
+
+            put_message(&frame, &slot->record);
+
+            slot->ready = false;
+            front++;
+            ring_front = front; // Frees the slot
+        }
+
+        if (frame.num_messages > 0)
+        {
+            send_frame(&frame);
+        }
+
+        // Unwritten slots, messages dropped while the port is closed, or ones added mid-flush
+        if (pending())
+        {
+            arm_drain();
+        }
+    }
+
+    /// @brief Initializes logging, creating the periodic that wakes the log task. Messages logged
+    /// before this are kept, and go out with the first flush.
+    ///
+    void init()
+    {
+        frame_seq = 0;
+
+        periodic::create(periodic::ID::LogDrain, signal_drain);
+        drain_created = true;
+
+        if (pending())
+        {
+            arm_drain();
+        }
+    }
+
+    //----------------------------------------------------------------------------------------------
+    //  Class Function Definitions
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Class Operator Definitions
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Class Constructor Definitions
+    //----------------------------------------------------------------------------------------------
+
+
+    // End of Namespace
+}
+
+//--------------------------------------------------------------------------------------------------
+// Global Namespace Functions
+//--------------------------------------------------------------------------------------------------
+
+
+//--------------------------------------------------------------------------------------------------
+// Unit Test Accessors
+//--------------------------------------------------------------------------------------------------
+
+// End of File
@@ -103,6 +103,17 @@ namespace output
         return ret_val;
     }
 
+    /// @brief Writes any staged output values to the hardware. Should be called once all events in
+    /// a batch have been handled, so that each staged output is written at most once per batch.
+    ///
+    void commit()
+    {
+        for (uint32_t i = 0; i < output_list_size; i++)
+        {
+            output_list[i]->commit();
+        }
+    }
+
     /// @brief Initializes the output list.
     /// @param list List of outputs.
     /// @param size Size of the list.
@@ -143,6 +154,20 @@ namespace output
         this->print_io = false;
     }
 
+    /// @brief Writes the staged value of this output to the hardware, if it has changed since the
+    /// last commit.
+    ///
+    void Output::commit()
+    {
+        if (!this->dirty)
+        {
+            return;
+        }
+
+        this->dirty = false;
+        this->write(this->shadow_data);
+    }
+
     /// @brief Commands will call this to print out the output. Outputs can override this to have
     /// the relevant commands support setting their values.
     /// @return String containing the value of the output.
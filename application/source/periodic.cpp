@@ -11,72 +11,269 @@
 
 #include "periodic.hpp"
 #include "timer_osal.hpp"
+#include "alarm_hal.hpp"
+#include "event.hpp"
+#include "systime.hpp"
 #include "error.hpp"
 #include "mutex.hpp"
+#include "macros.hpp"
 
+#include <atomic>
 #include <cstdint>
+#include <cstring>
 
 //--------------------------------------------------------------------------------------------------
 //  Macros and Error Checking
 //--------------------------------------------------------------------------------------------------
 
+// Event that runs a periodic in its owning task. Only Task periodics have one, so only their owners
+// need a RunPeriodic event.
+#define RUN_EVENT_ISR(context)    event::ID::NullEvent
+#define RUN_EVENT_Daemon(context) event::ID::NullEvent
+#define RUN_EVENT_Task(context)   event::ID::context##_RunPeriodic
+
 namespace
 {
     //----------------------------------------------------------------------------------------------
     //  Private Constants
     //----------------------------------------------------------------------------------------------
 
-    constexpr uint32_t FIDELITY_MS = 1;
+    constexpr uint32_t NUM_PERIODICS = (uint32_t)periodic::ID::NumIDs;
+
+    constexpr uint32_t MIN_DELAY_MS = 1; // Timer can't be armed for less than a tick
+
+    constexpr uint64_t PPM         = 1000000; // Utilization is worked out in parts per million
+    constexpr uint64_t PPM_PER_PCT = PPM / 100;
+
+    const char *periodic_names[NUM_PERIODICS] = {
+
+#define DEF(periodic_name, period_ms, budget_us, context, exec) #periodic_name,
+#include "periodics.def"
+#undef DEF
+
+    };
+
+    constexpr uint32_t declared_periods_ms[NUM_PERIODICS] = {
+
+#define DEF(periodic_name, period_ms, budget_us, context, exec) period_ms,
+#include "periodics.def"
+#undef DEF
+
+    };
+
+    constexpr uint32_t declared_budgets_us[NUM_PERIODICS] = {
+
+#define DEF(periodic_name, period_ms, budget_us, context, exec) budget_us,
+#include "periodics.def"
+#undef DEF
+
+    };
+
+    constexpr periodic::Exec declared_execs[NUM_PERIODICS] = {
+
+#define DEF(periodic_name, period_ms, budget_us, context, exec) periodic::Exec::exec,
+#include "periodics.def"
+#undef DEF
+
+    };
+
+    constexpr event::ID run_events[NUM_PERIODICS] = {
+
+#define DEF(periodic_name, period_ms, budget_us, context, exec) RUN_EVENT_##exec(context),
+#include "periodics.def"
+#undef DEF
+
+    };
+
+    static_assert(
+        []() {
+            for (uint32_t i = 0; i < NUM_PERIODICS; i++)
+            {
+                if (declared_periods_ms[i] == 0)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }(),
+        "Periodic with a zero period in periodics.def");
+
+    /// @brief Worst-case share of the CPU taken by the periodics, if every one of them ran for its
+    /// whole budget at its shortest period. Each share is rounded up, so this errs high.
+    constexpr uint64_t UTILIZATION_PPM = []() {
+        uint64_t total = 0;
+        for (uint32_t i = 0; i < NUM_PERIODICS; i++)
+        {
+            uint64_t period_us = (uint64_t)declared_periods_ms[i] * systime::US_PER_MS;
+            total += ((declared_budgets_us[i] * PPM) + period_us - 1) / period_us;
+        }
+
+        return total;
+    }();
+
+    static_assert(UTILIZATION_PPM <= periodic::MAX_UTILIZATION_PERCENT * PPM_PER_PCT,
+                  "Periodics in periodics.def exceed periodic::MAX_UTILIZATION_PERCENT");
 
     //----------------------------------------------------------------------------------------------
     //  Private Data Types
     //----------------------------------------------------------------------------------------------
 
+    /// @brief Running totals behind periodic::Stats.
+    ///
+    struct Timing
+    {
+            uint32_t calls;
+            uint32_t late_min_us;
+            uint32_t late_max_us;
+            uint32_t late_bins[periodic::NUM_LATENESS_BINS];
+            uint64_t exec_total_us;
+            uint32_t exec_max_us;
+            uint32_t overruns;
+            uint32_t skipped;
+    };
+
     struct Periodic
     {
             uint32_t               period_ms;
             periodic::CallbackFunc callback;
 
-            bool     enabled;      // True if the periodic is currently running
-            uint32_t last_call_ms; // Time of the last call
+            std::atomic<bool> enabled; // True if the periodic is currently running
+
+            uint32_t next_ms;  // Deadline of the next call
+            uint32_t heap_pos; // Position in the deadline heap, if enabled and not an ISR periodic
+
+            bool     run_pending; // Task periodics only, true while the owner has yet to run it
+            uint32_t pending_ms;  // Deadline the pending run is for
+
+            Timing timing;
     };
 
-    Periodic periodic_list[(uint32_t)periodic::ID::NumIDs];
+    /// @brief A call that's due, and how it went.
+    ///
+    struct Call
+    {
+            uint32_t id;
+            uint32_t deadline_ms;
+            uint32_t late_us;
+            uint32_t exec_us;
+    };
+
+    Periodic periodic_list[NUM_PERIODICS];
 
     //----------------------------------------------------------------------------------------------
     //  Private Function Prototypes
     //----------------------------------------------------------------------------------------------
 
+    void call_callbacks(uint32_t timer_time_ms);
+
+    void call_isr_callbacks();
 
     //----------------------------------------------------------------------------------------------
     //  File Variables
     //----------------------------------------------------------------------------------------------
 
+    // Running periodics, other than ISR periodics, as a min-heap on their deadlines. The timer is
+    // only ever armed for the deadline at the top.
+    uint32_t deadline_heap[NUM_PERIODICS];
+    uint32_t heap_size = 0;
 
     //----------------------------------------------------------------------------------------------
     //  Private Functions
     //----------------------------------------------------------------------------------------------
 
-    /// @brief Loops through all callbacks, and calls them.
-    /// @param curr_time_ms Current system time.
+    /// @brief Compares two times in a way that works across a wrap, as long as they're less than
+    /// half the range apart.
+    /// @return True if time_a comes before time_b.
     ///
-    void call_callbacks(uint32_t curr_time_ms)
+    bool is_before(uint32_t time_a, uint32_t time_b)
+    {
+        return (int32_t)(time_a - time_b) < 0;
+    }
+
+    bool is_earlier(uint32_t pos_a, uint32_t pos_b)
+    {
+        return is_before(periodic_list[deadline_heap[pos_a]].next_ms,
+                         periodic_list[deadline_heap[pos_b]].next_ms);
+    }
+
+    void swap(uint32_t pos_a, uint32_t pos_b)
     {
-        for (uint32_t i = 0; i < (uint32_t)periodic::ID::NumIDs; i++)
+        uint32_t id_a = deadline_heap[pos_a];
+        uint32_t id_b = deadline_heap[pos_b];
+
+        deadline_heap[pos_a] = id_b;
+        deadline_heap[pos_b] = id_a;
+
+        periodic_list[id_b].heap_pos = pos_a;
+        periodic_list[id_a].heap_pos = pos_b;
+    }
+
+    void sift_up(uint32_t pos)
+    {
+        while ((pos > 0) && is_earlier(pos, (pos - 1) / 2))
+        {
+            swap(pos, (pos - 1) / 2);
+            pos = (pos - 1) / 2;
+        }
+    }
+
+    void sift_down(uint32_t pos)
+    {
+        while (true)
         {
-            bool elapsed
-                = (curr_time_ms - periodic_list[i].last_call_ms) >= periodic_list[i].period_ms;
+            uint32_t earliest = pos;
+            uint32_t left     = (2 * pos) + 1;
+            uint32_t right    = left + 1;
+
+            if ((left < heap_size) && is_earlier(left, earliest))
+            {
+                earliest = left;
+            }
 
-            if (periodic_list[i].enabled && elapsed)
+            if ((right < heap_size) && is_earlier(right, earliest))
             {
-                INVAR(periodic_list[i].callback != nullptr, error::InvalidPointer);
+                earliest = right;
+            }
 
-                periodic_list[i].callback(curr_time_ms);
+            if (earliest == pos)
+            {
+                return;
             }
+
+            swap(pos, earliest);
+            pos = earliest;
         }
     }
 
-    /// @brief Creates the timer.
+    void heap_push(uint32_t id)
+    {
+        INVAR(heap_size < NUM_PERIODICS, error::QueueOverflow);
+
+        deadline_heap[heap_size]   = id;
+        periodic_list[id].heap_pos = heap_size;
+        heap_size++;
+
+        sift_up(heap_size - 1);
+    }
+
+    void heap_remove(uint32_t id)
+    {
+        uint32_t pos = periodic_list[id].heap_pos;
+        INVAR((pos < heap_size) && (deadline_heap[pos] == id), error::InvalidIndex);
+
+        heap_size--;
+        if (pos == heap_size)
+        {
+            return;
+        }
+
+        swap(pos, heap_size);
+        sift_up(pos);
+        sift_down(periodic_list[deadline_heap[pos]].heap_pos);
+    }
+
+    /// @brief Creates the timer. It's one-shot, and armed for the next deadline each time.
     ///
     void create_timer()
     {
@@ -86,45 +283,271 @@ namespace
             return;
         }
 
-        error::Error err
-            = timer_osal::create(timer_osal::TimerID::Periodic, call_callbacks, FIDELITY_MS, true);
+        error::Error err = timer_osal::create(
+            timer_osal::TimerID::Periodic, call_callbacks, MIN_DELAY_MS, false);
 
         INVAR(err == error::NoError, error::AppInitFailed);
 
         timer_created = true;
     }
 
-    /// @brief Stops the timer if it should stop.
+    /// @brief Arms the timer for the earliest deadline, or stops it if nothing is running.
+    /// @param curr_time_ms Current time.
     ///
-    void stop_timer()
+    void arm_timer(uint32_t curr_time_ms)
     {
         create_timer();
 
-        bool periodic_running = false;
-        for (uint32_t i = 0; i < (uint32_t)periodic::ID::NumIDs; i++)
+        if (heap_size == 0)
         {
-            periodic_running |= periodic_list[i].enabled;
+            timer_osal::stop(timer_osal::TimerID::Periodic);
+            return;
         }
 
-        if (timer_osal::is_running(timer_osal::TimerID::Periodic))
+        uint32_t next_ms  = periodic_list[deadline_heap[0]].next_ms;
+        uint32_t delay_ms = is_before(curr_time_ms, next_ms) ? (next_ms - curr_time_ms) : 0;
+
+        delay_ms = (delay_ms < MIN_DELAY_MS) ? MIN_DELAY_MS : delay_ms;
+
+        error::Error err = timer_osal::set_period(timer_osal::TimerID::Periodic, delay_ms);
+        INVAR(err == error::NoError, error::StartFailed);
+    }
+
+    /// @brief Works out how long after a deadline a time is.
+    /// @param time_us Time, from the monotonic clock.
+    /// @param deadline_ms Deadline, which is on the same clock but wraps.
+    /// @return Lateness.
+    ///
+    uint32_t lateness_us(uint64_t time_us, uint32_t deadline_ms)
+    {
+        uint32_t late_ms = (uint32_t)(time_us / systime::US_PER_MS) - deadline_ms;
+
+        return (late_ms * systime::US_PER_MS) + (uint32_t)(time_us % systime::US_PER_MS);
+    }
+
+    /// @brief Adds a call to the timing of a periodic.
+    ///
+    void record_call(Periodic *periodic, const Call *call)
+    {
+        Timing *timing = &periodic->timing;
+
+        if ((timing->calls == 0) || (call->late_us < timing->late_min_us))
         {
-            return;
+            timing->late_min_us = call->late_us;
+        }
+
+        if (call->late_us > timing->late_max_us)
+        {
+            timing->late_max_us = call->late_us;
+        }
+
+        uint32_t bin = 0;
+        while ((bin < periodic::NUM_LATENESS_BINS - 1)
+               && (call->late_us >= periodic::LATENESS_BINS_US[bin]))
+        {
+            bin++;
         }
 
-        timer_osal::stop(timer_osal::TimerID::Periodic);
+        timing->late_bins[bin]++;
+
+        timing->exec_total_us += call->exec_us;
+        if (call->exec_us > timing->exec_max_us)
+        {
+            timing->exec_max_us = call->exec_us;
+        }
+
+        if (call->exec_us > periodic->period_ms * systime::US_PER_MS)
+        {
+            timing->overruns++;
+        }
+
+        timing->calls++;
     }
 
-    /// @brief Starts the timer.
+    /// @brief Moves a periodic that's due on to its next deadline. Each deadline moves on by whole
+    /// periods from the one before, so calls stay locked to the phase the periodic was started
+    /// with rather than drifting by however late they were. If whole periods were missed, they're
+    /// skipped rather than made up with a burst of calls.
+    /// @param periodic Periodic that's due.
+    /// @param curr_time_ms Current time.
+    /// @return Deadline that was due.
     ///
-    void start_timer()
+    uint32_t advance(Periodic *periodic, uint32_t curr_time_ms)
     {
-        create_timer();
-        if (timer_osal::is_running(timer_osal::TimerID::Periodic))
+        uint32_t deadline_ms = periodic->next_ms;
+        uint32_t missed      = (curr_time_ms - deadline_ms) / periodic->period_ms;
+
+        periodic->next_ms        += (missed + 1) * periodic->period_ms;
+        periodic->timing.skipped += missed;
+
+        return deadline_ms;
+    }
+
+    /// @brief Calls a callback, timing how late it started and how long it ran for.
+    ///
+    void timed_call(periodic::CallbackFunc func, uint32_t curr_time_ms, Call *call)
+    {
+        INVAR(func != nullptr, error::InvalidPointer);
+
+        uint64_t start_us = systime::now_us();
+        func(curr_time_ms);
+        uint64_t end_us = systime::now_us();
+
+        call->late_us = lateness_us(start_us, call->deadline_ms);
+        call->exec_us = (uint32_t)(end_us - start_us);
+    }
+
+    /// @brief Arms the alarm for the earliest deadline of the running ISR periodics, or disarms it
+    /// if there aren't any. This runs both from tasks, which the alarm can interrupt part way
+    /// through, and from the alarm itself. The alarm only ever moves deadlines later, so the worst
+    /// an interruption can do is leave the alarm armed early, in which case it finds nothing due
+    /// and arms itself again.
+    ///
+    void arm_alarm()
+    {
+        uint64_t curr_time_us = systime::now_us();
+        uint32_t curr_time_ms = (uint32_t)(curr_time_us / systime::US_PER_MS);
+
+        bool     found       = false;
+        uint32_t earliest_ms = 0;
+        for (uint32_t i = 0; i < NUM_PERIODICS; i++)
+        {
+            if ((declared_execs[i] != periodic::Exec::ISR) || !periodic_list[i].enabled)
+            {
+                continue;
+            }
+
+            uint32_t next_ms = periodic_list[i].next_ms;
+            if (!found || is_before(next_ms, earliest_ms))
+            {
+                earliest_ms = next_ms;
+                found       = true;
+            }
+        }
+
+        if (!found)
         {
+            alarm_hal::disarm();
             return;
         }
 
-        timer_osal::start(timer_osal::TimerID::Periodic);
+        uint32_t delay_us = 0;
+        if (is_before(curr_time_ms, earliest_ms))
+        {
+            delay_us = ((earliest_ms - curr_time_ms) * systime::US_PER_MS)
+                       - (uint32_t)(curr_time_us % systime::US_PER_MS);
+        }
+
+        error::Error err = alarm_hal::arm(delay_us, call_isr_callbacks);
+        INVAR(err == error::NoError, error::StartFailed);
+    }
+
+    /// @brief Calls the ISR periodics that are due, from the alarm interrupt, then arms the alarm
+    /// for the next deadline. The mutex can't be taken here, but while an ISR periodic is running
+    /// nothing else writes its deadline or timing, other than reset_stats() (which at worst loses
+    /// a call from the stats).
+    ///
+    void call_isr_callbacks()
+    {
+        uint32_t curr_time_ms = systime::now_ms();
+
+        for (uint32_t i = 0; i < NUM_PERIODICS; i++)
+        {
+            Periodic *periodic = &periodic_list[i];
+            if ((declared_execs[i] != periodic::Exec::ISR) || !periodic->enabled
+                || is_before(curr_time_ms, periodic->next_ms))
+            {
+                continue;
+            }
+
+            Call call        = {};
+            call.id          = i;
+            call.deadline_ms = advance(periodic, curr_time_ms);
+
+            timed_call(periodic->callback, curr_time_ms, &call);
+            record_call(periodic, &call);
+        }
+
+        arm_alarm();
+    }
+
+    /// @brief Handles the periodics that are due on the timer, then arms it for the next deadline.
+    /// Daemon periodics are called here. Task periodics get an event posted to their owner instead,
+    /// unless the owner has yet to run the one before, in which case the period is skipped. Time is
+    /// taken from the monotonic clock rather than the timer, whose time is only as fine as the
+    /// RTOS tick.
+    /// @param timer_time_ms Time according to the timer (unused).
+    ///
+    void call_callbacks(uint32_t timer_time_ms)
+    {
+        UNUSED(timer_time_ms);
+
+        Call                   due[NUM_PERIODICS];
+        periodic::CallbackFunc funcs[NUM_PERIODICS];
+        uint32_t               num_due = 0;
+
+        uint32_t posts[NUM_PERIODICS];
+        uint32_t num_posts = 0;
+
+        uint32_t curr_time_ms = systime::now_ms();
+
+        mutex::take(mutex::ID::Periodic);
+
+        while (heap_size > 0)
+        {
+            uint32_t  id       = deadline_heap[0];
+            Periodic *periodic = &periodic_list[id];
+            if (is_before(curr_time_ms, periodic->next_ms))
+            {
+                break;
+            }
+
+            uint32_t deadline_ms = advance(periodic, curr_time_ms);
+            sift_down(0);
+
+            if (declared_execs[id] == periodic::Exec::Task)
+            {
+                if (periodic->run_pending)
+                {
+                    periodic->timing.skipped++;
+                    continue;
+                }
+
+                periodic->run_pending = true;
+                periodic->pending_ms  = deadline_ms;
+                posts[num_posts++]    = id;
+                continue;
+            }
+
+            due[num_due].id          = id;
+            due[num_due].deadline_ms = deadline_ms;
+            funcs[num_due]           = periodic->callback;
+            num_due++;
+        }
+
+        mutex::give(mutex::ID::Periodic);
+
+        for (uint32_t i = 0; i < num_posts; i++)
+        {
+            event::post(run_events[posts[i]], (void *)(uintptr_t)posts[i]);
+        }
+
+        // Called without the lock, so callbacks can start and stop periodics
+        for (uint32_t i = 0; i < num_due; i++)
+        {
+            timed_call(funcs[i], curr_time_ms, &due[i]);
+        }
+
+        mutex::take(mutex::ID::Periodic);
+
+        for (uint32_t i = 0; i < num_due; i++)
+        {
+            record_call(&periodic_list[due[i].id], &due[i]);
+        }
+
+        arm_timer(systime::now_ms());
+
+        mutex::give(mutex::ID::Periodic);
     }
 
     // End of Anonymous Namespace
@@ -143,15 +566,32 @@ namespace periodic
     {
         REQUIRE(id < ID::NumIDs, error::InvalidID);
 
+        Periodic *periodic = &periodic_list[(uint32_t)id];
+
         mutex::take(mutex::ID::Periodic);
 
-        periodic_list[(uint32_t)id].enabled = false;
-        stop_timer();
+        periodic->run_pending = false; // Drops a run already posted to the owner
+
+        if (periodic->enabled)
+        {
+            periodic->enabled = false;
+
+            if (declared_execs[(uint32_t)id] == Exec::ISR)
+            {
+                arm_alarm();
+            }
+            else
+            {
+                heap_remove((uint32_t)id);
+                arm_timer(systime::now_ms());
+            }
+        }
 
         mutex::give(mutex::ID::Periodic);
     }
 
-    /// @brief Starts the given timer.
+    /// @brief Starts the given timer. The first call is one period from now, and each call after
+    /// that is a whole number of periods on from it.
     /// @param id ID of the timer.
     ///
     void start(ID id)
@@ -159,42 +599,180 @@ namespace periodic
         REQUIRE(id < ID::NumIDs, error::InvalidID);
         REQUIRE(periodic_list[(uint32_t)id].callback != nullptr, error::InvalidPointer);
 
+        Periodic *periodic = &periodic_list[(uint32_t)id];
+        bool      isr      = (declared_execs[(uint32_t)id] == Exec::ISR);
+
         mutex::take(mutex::ID::Periodic);
 
-        periodic_list[(uint32_t)id].last_call_ms = timer_osal::curr_time_ms();
-        periodic_list[(uint32_t)id].enabled      = true;
-        start_timer();
+        // Restarting sets a new phase. ISR periodics are disabled while their deadline changes, so
+        // the alarm can't see it half written.
+        if (periodic->enabled && !isr)
+        {
+            heap_remove((uint32_t)id);
+        }
+
+        periodic->enabled     = false;
+        periodic->run_pending = false;
+
+        uint32_t curr_time_ms = systime::now_ms();
+
+        periodic->next_ms = curr_time_ms + periodic->period_ms;
+        periodic->enabled = true;
+
+        if (isr)
+        {
+            arm_alarm();
+        }
+        else
+        {
+            heap_push((uint32_t)id);
+            arm_timer(curr_time_ms);
+        }
 
         mutex::give(mutex::ID::Periodic);
     }
 
-    /// @brief Creates a timer.
-    /// @param id ID of the timer to create.
-    /// @param period_ms Period of the timer.
+    /// @brief Creates a periodic, running at the period given in periodics.def.
+    /// @param id ID of the periodic to create.
     /// @param func Callback that will be called when the periodic expires.
     ///
-    void create(ID id, uint32_t period_ms, CallbackFunc func)
+    void create(ID id, CallbackFunc func)
     {
         REQUIRE(id < ID::NumIDs, error::InvalidID);
-        REQUIRE(period_ms > 0, error::InvalidTime);
         REQUIRE(func != nullptr, error::InvalidPointer);
 
         mutex::take(mutex::ID::Periodic);
 
         if (periodic_list[(uint32_t)id].enabled == true)
         {
-            INVAR(periodic_list[(uint32_t)id].period_ms == period_ms, error::TooManyAttempts);
             INVAR(periodic_list[(uint32_t)id].callback == func, error::TooManyAttempts);
         }
         else
         {
-            periodic_list[(uint32_t)id].period_ms = period_ms;
+            periodic_list[(uint32_t)id].period_ms = declared_periods_ms[(uint32_t)id];
             periodic_list[(uint32_t)id].callback  = func;
         }
 
         mutex::give(mutex::ID::Periodic);
     }
 
+    /// @brief Changes the period of a periodic. The period can't be shorter than the one in
+    /// periodics.def, as that's what the utilization check at build time assumed. If the periodic
+    /// is running, the call already scheduled keeps its deadline.
+    /// @param id ID of the periodic.
+    /// @param period_ms New period.
+    ///
+    void set_period(ID id, uint32_t period_ms)
+    {
+        REQUIRE(id < ID::NumIDs, error::InvalidID);
+        REQUIRE(period_ms >= declared_periods_ms[(uint32_t)id], error::InvalidTime);
+
+        mutex::take(mutex::ID::Periodic);
+        periodic_list[(uint32_t)id].period_ms = period_ms;
+        mutex::give(mutex::ID::Periodic);
+    }
+
+    /// @brief Gets the worst-case execution time of a periodic's callback, from periodics.def.
+    /// @param id ID of the periodic.
+    /// @return Budget in microseconds.
+    ///
+    uint32_t budget_us(ID id)
+    {
+        REQUIRE(id < ID::NumIDs, error::InvalidID);
+
+        return declared_budgets_us[(uint32_t)id];
+    }
+
+    /// @brief Gets the name of a periodic.
+    /// @param id ID of the periodic.
+    /// @return Name of the periodic.
+    ///
+    const char *name(ID id)
+    {
+        REQUIRE(id < ID::NumIDs, error::InvalidID);
+
+        return periodic_names[(uint32_t)id];
+    }
+
+    /// @brief Gets the timing of a periodic's calls since the stats were last reset.
+    /// @param id ID of the periodic.
+    /// @return Timing stats.
+    ///
+    Stats get_stats(ID id)
+    {
+        REQUIRE(id < ID::NumIDs, error::InvalidID);
+
+        mutex::take(mutex::ID::Periodic);
+        Timing timing = periodic_list[(uint32_t)id].timing;
+        mutex::give(mutex::ID::Periodic);
+
+        Stats stats       = {};
+        stats.calls       = timing.calls;
+        stats.late_min_us = timing.late_min_us;
+        stats.late_max_us = timing.late_max_us;
+        stats.exec_max_us = timing.exec_max_us;
+        stats.overruns    = timing.overruns;
+        stats.skipped     = timing.skipped;
+
+        memcpy(stats.late_bins, timing.late_bins, sizeof(stats.late_bins));
+
+        if (timing.calls > 0)
+        {
+            stats.exec_mean_us = (uint32_t)(timing.exec_total_us / timing.calls);
+        }
+
+        return stats;
+    }
+
+    /// @brief Runs a Task periodic. The owning task calls this on its RunPeriodic event, with the
+    /// ID that came with the event.
+    /// @param id ID of the periodic.
+    ///
+    void run(ID id)
+    {
+        REQUIRE(id < ID::NumIDs, error::InvalidID);
+        REQUIRE(declared_execs[(uint32_t)id] == Exec::Task, error::InvalidType);
+
+        Periodic *periodic = &periodic_list[(uint32_t)id];
+
+        mutex::take(mutex::ID::Periodic);
+
+        bool pending          = periodic->run_pending;
+        periodic->run_pending = false;
+
+        Call call                   = {};
+        call.id                     = (uint32_t)id;
+        call.deadline_ms            = periodic->pending_ms;
+        periodic::CallbackFunc func = periodic->callback;
+
+        mutex::give(mutex::ID::Periodic);
+
+        if (!pending)
+        {
+            return; // Stopped since the event was posted
+        }
+
+        timed_call(func, systime::now_ms(), &call);
+
+        mutex::take(mutex::ID::Periodic);
+        record_call(periodic, &call);
+        mutex::give(mutex::ID::Periodic);
+    }
+
+    /// @brief Clears the timing stats of all periodics.
+    ///
+    void reset_stats()
+    {
+        mutex::take(mutex::ID::Periodic);
+
+        for (uint32_t i = 0; i < NUM_PERIODICS; i++)
+        {
+            memset(&periodic_list[i].timing, 0, sizeof(Timing));
+        }
+
+        mutex::give(mutex::ID::Periodic);
+    }
+
     //----------------------------------------------------------------------------------------------
     //  Class Function Definitions
     //----------------------------------------------------------------------------------------------
@@ -0,0 +1,200 @@
+/// @file profile.cpp
+/// @author Denver Hoggatt
+/// @brief Profiling zone definitions
+///
+/// Copyright (c) 2025 Denver Hoggatt. All rights reserved.
+///
+/// This software is licensed under terms that can be found in the LICENSE file
+/// in the root directory of this software component.
+/// If no LICENSE file comes with this software, it is provided AS-IS.
+///
+
+#include "profile.hpp"
+#include "systime.hpp"
+#include "error.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+//--------------------------------------------------------------------------------------------------
+//  Macros and Error Checking
+//--------------------------------------------------------------------------------------------------
+
+namespace
+{
+    //----------------------------------------------------------------------------------------------
+    //  Private Constants
+    //----------------------------------------------------------------------------------------------
+
+    constexpr uint32_t NUM_ZONES = (uint32_t)profile::Zone::NumZones;
+
+    constexpr uint32_t NO_MIN = 0xFFFFFFFF;
+
+    const char *zone_names[NUM_ZONES] = {
+
+#define DEF(zone_name, zone_str) zone_str,
+#include "zones.def"
+#undef DEF
+
+    };
+
+    //----------------------------------------------------------------------------------------------
+    //  Private Data Types
+    //----------------------------------------------------------------------------------------------
+
+    /// @brief Running totals for a zone, kept in clock ticks. Zones can be entered from any task
+    /// (or interrupt) at once, so each total is updated on its own with an atomic
+    /// read-modify-write. The versatilepb has no exclusive load/store, so those mask IRQs for the
+    /// one access (see the __atomic helpers in its main.c). A reader may see a pass half
+    /// recorded, which is fine for statistics. The total wraps after about 71 minutes spent in
+    /// the zone at 1MHz, so reset before then.
+    ///
+    struct Accumulator
+    {
+        std::atomic<uint32_t> count;
+        std::atomic<uint32_t> min;
+        std::atomic<uint32_t> max;
+        std::atomic<uint32_t> total;
+    };
+
+    //----------------------------------------------------------------------------------------------
+    //  Private Function Prototypes
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  File Variables
+    //----------------------------------------------------------------------------------------------
+
+    Accumulator accumulators[NUM_ZONES];
+
+    //----------------------------------------------------------------------------------------------
+    //  Private Functions
+    //----------------------------------------------------------------------------------------------
+
+
+    // End of Anonymous Namespace
+}
+
+namespace profile
+{
+    //----------------------------------------------------------------------------------------------
+    //  Public Functions
+    //----------------------------------------------------------------------------------------------
+
+    /// @brief Adds a pass through a zone to its statistics.
+    /// @param zone Zone that was passed through.
+    /// @param ticks Clock ticks spent in the zone (see systime::ticks()).
+    ///
+    void record(Zone zone, uint32_t ticks)
+    {
+        REQUIRE(zone < Zone::NumZones, error::InvalidID);
+
+        Accumulator *acc = &accumulators[(uint32_t)zone];
+
+        acc->count.fetch_add(1);
+        acc->total.fetch_add(ticks);
+
+        uint32_t min = acc->min.load();
+        while ((ticks < min) && !acc->min.compare_exchange_weak(min, ticks))
+        {
+        }
+
+        uint32_t max = acc->max.load();
+        while ((ticks > max) && !acc->max.compare_exchange_weak(max, ticks))
+        {
+        }
+    }
+
+    /// @brief Gets the statistics of a zone.
+    /// @param zone Zone to get.
+    /// @return Statistics, all zero if the zone hasn't been passed through.
+    ///
+    Stats get(Zone zone)
+    {
+        REQUIRE(zone < Zone::NumZones, error::InvalidID);
+
+        Accumulator *acc = &accumulators[(uint32_t)zone];
+
+        Stats stats = {};
+        stats.count = acc->count.load();
+        if (stats.count == 0)
+        {
+            return stats;
+        }
+
+        stats.min_us  = systime::ticks_to_us(acc->min.load());
+        stats.max_us  = systime::ticks_to_us(acc->max.load());
+        stats.mean_us = systime::ticks_to_us(acc->total.load() / stats.count);
+
+        return stats;
+    }
+
+    /// @brief Gets the name of a zone.
+    /// @param zone Zone to get.
+    /// @return Name of the zone.
+    ///
+    const char *name(Zone zone)
+    {
+        REQUIRE(zone < Zone::NumZones, error::InvalidID);
+
+        return zone_names[(uint32_t)zone];
+    }
+
+    /// @brief Clears the statistics of all zones.
+    ///
+    void reset()
+    {
+        for (uint32_t i = 0; i < NUM_ZONES; i++)
+        {
+            accumulators[i].count = 0;
+            accumulators[i].min   = NO_MIN;
+            accumulators[i].max   = 0;
+            accumulators[i].total = 0;
+        }
+    }
+
+    /// @brief Initializes the profile module.
+    ///
+    void init()
+    {
+        reset();
+    }
+
+    //----------------------------------------------------------------------------------------------
+    //  Class Function Definitions
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Class Operator Definitions
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Class Constructor Definitions
+    //----------------------------------------------------------------------------------------------
+
+    /// @brief Records the time spent in the zone, if one was opened.
+    ///
+    Scope::~Scope()
+    {
+        if (zone < Zone::NumZones)
+        {
+            record(zone, systime::ticks() - start);
+        }
+    }
+
+    // End of Namespace
+}
+
+//--------------------------------------------------------------------------------------------------
+// Global Namespace Functions
+//--------------------------------------------------------------------------------------------------
+
+
+//--------------------------------------------------------------------------------------------------
+// Unit Test Accessors
+//--------------------------------------------------------------------------------------------------
+
+// End of File
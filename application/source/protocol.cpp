@@ -0,0 +1,905 @@
+/// @file protocol.cpp
+/// @author Denver Hoggatt
+/// @brief Binary host protocol definitions
+///
+/// Copyright (c) 2025 Denver Hoggatt. All rights reserved.
+///
+/// This software is licensed under terms that can be found in the LICENSE file
+/// in the root directory of this software component.
+/// If no LICENSE file comes with this software, it is provided AS-IS.
+///
+
+#include "protocol.hpp"
+#include "error.hpp"
+#include "macros.hpp"
+#include "command.hpp"
+#include "settings.hpp"
+#include "input.hpp"
+#include "output.hpp"
+#include "utility.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+//--------------------------------------------------------------------------------------------------
+//  Macros and Error Checking
+//--------------------------------------------------------------------------------------------------
+
+namespace
+{
+    //----------------------------------------------------------------------------------------------
+    //  Private Constants
+    //----------------------------------------------------------------------------------------------
+
+    constexpr uint16_t CRC_INIT = 0xFFFF;
+    constexpr uint16_t CRC_POLY = 0x1021; // CRC-16/CCITT
+
+    constexpr uint32_t REQUEST_HEADER_LEN  = 2; // Type, sequence
+    constexpr uint32_t RESPONSE_HEADER_LEN = 3; // Type, sequence, status
+
+    constexpr uint32_t MAX_ARGS = (command::MAX_STR_LEN / 2) + 1;
+
+    //----------------------------------------------------------------------------------------------
+    //  Private Data Types
+    //----------------------------------------------------------------------------------------------
+
+    /// @brief Read position in a decoded frame.
+    ///
+    struct Reader
+    {
+        const uint8_t *data;
+        uint32_t       len;
+        uint32_t       pos;
+    };
+
+    /// @brief Frame being built up. The size leaves room for the CRC.
+    ///
+    struct Builder
+    {
+        uint8_t *data;
+        uint32_t size;
+        uint32_t len;
+    };
+
+    //----------------------------------------------------------------------------------------------
+    //  Private Function Prototypes
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  File Variables
+    //----------------------------------------------------------------------------------------------
+
+    protocol::FrameSink frame_sink    = nullptr;
+    void               *frame_context = nullptr;
+
+    bool binary_mode = false;
+    bool exit_after  = false; // Exit was requested, leave binary mode once the response is sent
+
+    char     rx_buf[protocol::MAX_ENCODED_LEN];
+    uint32_t rx_len      = 0;
+    bool     rx_overflow = false;
+
+    uint8_t telemetry_seq = 0;
+
+    // Request being handled. Kept between events while a command in it runs in slices.
+    uint8_t  req_data[protocol::MAX_ENCODED_LEN];
+    Reader   frame_req;
+    uint8_t  resp_data[protocol::MAX_FRAME_LEN];
+    Builder  frame_resp;
+    uint32_t resp_status_pos = 0;
+
+    // Command still running, its arguments point into cmd_line
+    char            cmd_line[UINT8_MAX + 1];
+    Builder         cmd_capture;
+    utility::Writer cmd_out;
+    uint32_t        cmd_len_pos = 0;
+    bool            cmd_running = false;
+
+    //----------------------------------------------------------------------------------------------
+    //  Private Functions
+    //----------------------------------------------------------------------------------------------
+
+    bool read_u8(Reader *reader, uint8_t *value)
+    {
+        if (reader->pos + 1 > reader->len)
+        {
+            return false;
+        }
+
+        *value = reader->data[reader->pos];
+        reader->pos++;
+
+        return true;
+    }
+
+    bool read_u16(Reader *reader, uint16_t *value)
+    {
+        if (reader->pos + 2 > reader->len)
+        {
+            return false;
+        }
+
+        *value = (uint16_t)(reader->data[reader->pos] | (reader->data[reader->pos + 1] << 8));
+        reader->pos += 2;
+
+        return true;
+    }
+
+    bool read_u32(Reader *reader, uint32_t *value)
+    {
+        if (reader->pos + 4 > reader->len)
+        {
+            return false;
+        }
+
+        *value = 0;
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            *value |= (uint32_t)reader->data[reader->pos + i] << (8 * i);
+        }
+        reader->pos += 4;
+
+        return true;
+    }
+
+    bool read_bytes(Reader *reader, char *bytes, uint32_t len)
+    {
+        if (reader->pos + len > reader->len)
+        {
+            return false;
+        }
+
+        memcpy(bytes, &reader->data[reader->pos], len);
+        reader->pos += len;
+
+        return true;
+    }
+
+    bool put_u8(Builder *builder, uint8_t value)
+    {
+        if (builder->len + 1 > builder->size)
+        {
+            return false;
+        }
+
+        builder->data[builder->len] = value;
+        builder->len++;
+
+        return true;
+    }
+
+    bool put_u16(Builder *builder, uint16_t value)
+    {
+        return put_u8(builder, (uint8_t)value) && put_u8(builder, (uint8_t)(value >> 8));
+    }
+
+    bool put_u32(Builder *builder, uint32_t value)
+    {
+        return put_u16(builder, (uint16_t)value) && put_u16(builder, (uint16_t)(value >> 16));
+    }
+
+    bool put_bytes(Builder *builder, const char *bytes, uint32_t len)
+    {
+        if (builder->len + len > builder->size)
+        {
+            return false;
+        }
+
+        memcpy(&builder->data[builder->len], bytes, len);
+        builder->len += len;
+
+        return true;
+    }
+
+    protocol::Status handle_setting_get(Reader *req, Builder *resp)
+    {
+        uint16_t id = 0;
+        if (!read_u16(req, &id))
+        {
+            return protocol::Status::BadFrame;
+        }
+
+        if (id >= (uint16_t)settings::ID::NumSettings)
+        {
+            return protocol::Status::InvalidID;
+        }
+
+        char value[settings::MAX_STR_LEN + 1];
+        value[settings::MAX_STR_LEN] = '\0';
+        if (settings::get((settings::ID)id, value) != (int32_t)error::NoError)
+        {
+            return protocol::Status::Failed;
+        }
+
+        uint8_t len = (uint8_t)strlen(value);
+        if (!put_u16(resp, id) || !put_u8(resp, len) || !put_bytes(resp, value, len))
+        {
+            return protocol::Status::Truncated;
+        }
+
+        return protocol::Status::Ok;
+    }
+
+    protocol::Status handle_setting_set(Reader *req, Builder *resp)
+    {
+        uint16_t id  = 0;
+        uint8_t  len = 0;
+        char     value[UINT8_MAX + 1];
+        if (!read_u16(req, &id) || !read_u8(req, &len) || !read_bytes(req, value, len))
+        {
+            return protocol::Status::BadFrame;
+        }
+
+        value[len] = '\0';
+
+        if (id >= (uint16_t)settings::ID::NumSettings)
+        {
+            return protocol::Status::InvalidID;
+        }
+
+        if ((len > settings::MAX_STR_LEN)
+            || (settings::set((settings::ID)id, value, true) != (int32_t)error::NoError))
+        {
+            return protocol::Status::Failed;
+        }
+
+        return put_u16(resp, id) ? protocol::Status::Ok : protocol::Status::Truncated;
+    }
+
+    protocol::Status handle_io_get(Reader *req, Builder *resp)
+    {
+        uint16_t id = 0;
+        if (!read_u16(req, &id))
+        {
+            return protocol::Status::BadFrame;
+        }
+
+        input::Input *in = nullptr;
+        if (id < (uint16_t)io::IOID::NumIDs)
+        {
+            in = input::get_by_id((io::IOID)id);
+        }
+
+        if (in == nullptr)
+        {
+            return protocol::Status::InvalidID;
+        }
+
+        uint32_t         value  = 0;
+        protocol::Status status = protocol::read_input(in, &value);
+        if (status != protocol::Status::Ok)
+        {
+            return status;
+        }
+
+        if (!put_u16(resp, id) || !put_u32(resp, value))
+        {
+            return protocol::Status::Truncated;
+        }
+
+        return protocol::Status::Ok;
+    }
+
+    protocol::Status handle_io_set(Reader *req, Builder *resp)
+    {
+        uint16_t id    = 0;
+        uint32_t value = 0;
+        if (!read_u16(req, &id) || !read_u32(req, &value))
+        {
+            return protocol::Status::BadFrame;
+        }
+
+        output::Output *out = nullptr;
+        if (id < (uint16_t)io::IOID::NumIDs)
+        {
+            out = output::get_by_id((io::IOID)id);
+        }
+
+        if (out == nullptr)
+        {
+            return protocol::Status::InvalidID;
+        }
+
+        const std::type_info &type = *(out->output_type);
+        if (type == typeid(bool))
+        {
+            out->set<bool>(value != 0);
+        }
+        else if (type == typeid(uint32_t))
+        {
+            out->set<uint32_t>(value);
+        }
+        else if (type == typeid(int32_t))
+        {
+            out->set<int32_t>((int32_t)value);
+        }
+        else
+        {
+            return protocol::Status::UnknownType;
+        }
+
+        return put_u16(resp, id) ? protocol::Status::Ok : protocol::Status::Truncated;
+    }
+
+    /// @brief Writer sink for command output. Output that doesn't fit in the response is dropped.
+    ///
+    void capture_output(void *context, const char *chunk)
+    {
+        Builder *capture = (Builder *)context;
+
+        uint32_t len  = strlen(chunk);
+        uint32_t left = capture->size - capture->len;
+        len           = (len > left) ? left : len;
+
+        put_bytes(capture, chunk, len);
+    }
+
+    /// @brief Adds the output of the last command to the response.
+    ///
+    void finish_command(Builder *resp)
+    {
+        cmd_out.flush();
+
+        resp->data[cmd_len_pos] = (uint8_t)cmd_capture.len;
+        resp->len += cmd_capture.len;
+    }
+
+    /// @brief Runs a command. If it's sliced, only the first slice runs and the rest are left to
+    /// protocol::resume().
+    ///
+    protocol::Status handle_command(Reader *req, Builder *resp)
+    {
+        uint8_t len = 0;
+        char   *cmd = cmd_line;
+        if (!read_u8(req, &len) || !read_bytes(req, cmd, len))
+        {
+            return protocol::Status::BadFrame;
+        }
+
+        cmd[len] = '\0';
+
+        uint32_t name_len = 0;
+        while ((cmd[name_len] != ' ') && (cmd[name_len] != '\0'))
+        {
+            name_len++;
+        }
+
+        int32_t command_pos = command::find(cmd, name_len);
+        if (command_pos < 0)
+        {
+            return protocol::Status::InvalidID;
+        }
+
+        char    *argv[MAX_ARGS];
+        uint32_t argc = 0;
+        for (uint32_t i = name_len; (i < len) && (argc < MAX_ARGS); i++)
+        {
+            if ((cmd[i] == ' ') && (cmd[i + 1] != ' ') && (cmd[i + 1] != '\0'))
+            {
+                argv[argc] = &cmd[i + 1];
+                argc++;
+            }
+
+            if (cmd[i] == ' ')
+            {
+                cmd[i] = '\0';
+            }
+        }
+
+        cmd_len_pos = resp->len;
+        if (!put_u8(resp, 0))
+        {
+            return protocol::Status::Truncated;
+        }
+
+        uint32_t left = resp->size - resp->len;
+        cmd_capture   = { &resp->data[resp->len], (left > UINT8_MAX) ? UINT8_MAX : left, 0 };
+
+        uint32_t              size      = 0;
+        command::CommandFunc *func_list = command::get_func_list(&size);
+        REQUIRE((uint32_t)command_pos < size, error::InvalidLength);
+
+        cmd_out.init(capture_output, &cmd_capture);
+        func_list[command_pos](&cmd_out, argc, argv);
+
+        if (command::pending())
+        {
+            cmd_running = true;
+            return protocol::Status::Ok;
+        }
+
+        finish_command(resp);
+
+        return protocol::Status::Ok;
+    }
+
+    /// @brief Adds the CRC, COBS encodes the frame and sends it.
+    ///
+    void send_frame(Builder *frame)
+    {
+        REQUIRE(frame_sink != nullptr, error::InvalidPointer);
+        REQUIRE(frame->len + protocol::CRC_LEN <= protocol::MAX_FRAME_LEN, error::InvalidLength);
+
+        uint16_t crc = protocol::crc16(frame->data, frame->len);
+        frame->data[frame->len]     = (uint8_t)crc;
+        frame->data[frame->len + 1] = (uint8_t)(crc >> 8);
+
+        uint8_t  encoded[protocol::MAX_ENCODED_LEN + 1]; // +1 delimiter
+        uint32_t len = protocol::cobs_encode(frame->data, frame->len + protocol::CRC_LEN, encoded);
+        encoded[len] = protocol::FRAME_DELIMITER;
+
+        frame_sink(frame_context, (const char *)encoded, len + 1);
+    }
+
+    /// @brief Handles the records of a request, adding the result of each to the response. Stops
+    /// early if a command is left running, and is called again once it finishes.
+    /// @return Status of the frame as a whole.
+    ///
+    protocol::Status handle_records(Reader *req, Builder *resp)
+    {
+        while (req->pos < req->len)
+        {
+            uint8_t op = 0;
+            read_u8(req, &op);
+
+            uint32_t record_start = resp->len;
+            if (!put_u8(resp, op) || !put_u8(resp, (uint8_t)protocol::Status::Ok))
+            {
+                resp->len = record_start;
+                return protocol::Status::Truncated;
+            }
+
+            protocol::Status status;
+            switch ((protocol::Op)op)
+            {
+                case protocol::Op::Exit:
+                    exit_after = true;
+                    status     = protocol::Status::Ok;
+                    break;
+
+                case protocol::Op::SettingGet:
+                    status = handle_setting_get(req, resp);
+                    break;
+
+                case protocol::Op::SettingSet:
+                    status = handle_setting_set(req, resp);
+                    break;
+
+                case protocol::Op::IOGet:
+                    status = handle_io_get(req, resp);
+                    break;
+
+                case protocol::Op::IOSet:
+                    status = handle_io_set(req, resp);
+                    break;
+
+                case protocol::Op::Command:
+                    status = handle_command(req, resp);
+                    break;
+
+                default:
+                    status = protocol::Status::UnknownOp;
+                    break;
+            }
+
+            if (status == protocol::Status::Truncated)
+            {
+                resp->len = record_start; // Drop the record, the host can send it again
+                return status;
+            }
+
+            resp->data[record_start + 1] = (uint8_t)status;
+
+            if (status != protocol::Status::Ok)
+            {
+                resp->len = record_start + 2; // No payload on failure
+            }
+
+            if ((status == protocol::Status::BadFrame) || (status == protocol::Status::UnknownOp))
+            {
+                return status; // Can't tell where the next record starts
+            }
+
+            if (cmd_running)
+            {
+                return protocol::Status::Ok;
+            }
+        }
+
+        return protocol::Status::Ok;
+    }
+
+    /// @brief Sets the status of the response and sends it.
+    ///
+    void finish_frame(protocol::Status status)
+    {
+        resp_data[resp_status_pos] = (uint8_t)status;
+
+        send_frame(&frame_resp);
+    }
+
+    /// @brief Leaves binary mode if the host asked to, now that the response has been sent.
+    ///
+    void check_exit()
+    {
+        if (exit_after)
+        {
+            exit_after  = false;
+            binary_mode = false;
+        }
+    }
+
+    /// @brief Decodes and handles a received frame, and sends the response. If a command is left
+    /// running, the response is sent by protocol::resume() instead.
+    ///
+    void handle_frame()
+    {
+        uint8_t *frame     = req_data;
+        int32_t  frame_len = -1;
+        if (!rx_overflow)
+        {
+            frame_len = protocol::cobs_decode((const uint8_t *)rx_buf, rx_len, frame);
+        }
+
+        frame_resp = { resp_data, protocol::MAX_FRAME_LEN - protocol::CRC_LEN, 0 };
+
+        put_u8(&frame_resp, (uint8_t)protocol::FrameType::Response);
+
+        bool valid = (frame_len >= (int32_t)(REQUEST_HEADER_LEN + protocol::CRC_LEN))
+                     && (frame_len <= (int32_t)protocol::MAX_FRAME_LEN);
+        if (!valid)
+        {
+            put_u8(&frame_resp, 0);
+            put_u8(&frame_resp, (uint8_t)protocol::Status::BadFrame);
+            send_frame(&frame_resp);
+            return;
+        }
+
+        uint32_t data_len = frame_len - protocol::CRC_LEN;
+        uint16_t crc      = (uint16_t)(frame[data_len] | (frame[data_len + 1] << 8));
+
+        put_u8(&frame_resp, frame[1]); // Sequence
+
+        resp_status_pos = frame_resp.len;
+        put_u8(&frame_resp, (uint8_t)protocol::Status::Ok);
+        INVAR(frame_resp.len == RESPONSE_HEADER_LEN, error::InvalidLength);
+
+        protocol::Status status = protocol::Status::Ok;
+        if (crc != protocol::crc16(frame, data_len))
+        {
+            status = protocol::Status::BadCRC;
+        }
+        else if (frame[0] != (uint8_t)protocol::FrameType::Request)
+        {
+            status = protocol::Status::BadFrame;
+        }
+        else
+        {
+            frame_req = { frame, data_len, REQUEST_HEADER_LEN };
+            status    = handle_records(&frame_req, &frame_resp);
+        }
+
+        if (!cmd_running)
+        {
+            finish_frame(status);
+        }
+    }
+
+    // End of Anonymous Namespace
+}
+
+namespace protocol
+{
+    //----------------------------------------------------------------------------------------------
+    //  Public Functions
+    //----------------------------------------------------------------------------------------------
+
+    /// @brief Calculates the CRC-16/CCITT-FALSE of the given data.
+    /// @param data Data.
+    /// @param len Length of the data.
+    /// @return CRC.
+    ///
+    uint16_t crc16(const uint8_t *data, uint32_t len)
+    {
+        REQUIRE((data != nullptr) || (len == 0), error::InvalidPointer);
+
+        uint16_t crc = CRC_INIT;
+
+        for (uint32_t i = 0; i < len; i++)
+        {
+            crc ^= (uint16_t)(data[i] << 8);
+
+            for (uint32_t bit = 0; bit < 8; bit++)
+            {
+                crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ CRC_POLY) : (uint16_t)(crc << 1);
+            }
+        }
+
+        return crc;
+    }
+
+    /// @brief COBS encodes data, so that it contains no FRAME_DELIMITER bytes.
+    /// @param data Data to encode.
+    /// @param len Length of the data.
+    /// @param encoded Filled with the encoded data. Must fit len + (len / 254) + 1 bytes.
+    /// @return Length of the encoded data (not including a delimiter).
+    ///
+    uint32_t cobs_encode(const uint8_t *data, uint32_t len, uint8_t *encoded)
+    {
+        REQUIRE((data != nullptr) || (len == 0), error::InvalidPointer);
+        REQUIRE(encoded != nullptr, error::InvalidPointer);
+
+        uint32_t code_pos = 0;
+        uint32_t out_pos  = 1;
+        uint8_t  code     = 1;
+
+        for (uint32_t i = 0; i < len; i++)
+        {
+            if (data[i] != 0)
+            {
+                encoded[out_pos] = data[i];
+                out_pos++;
+                code++;
+            }
+
+            if ((data[i] == 0) || (code == 0xFF))
+            {
+                encoded[code_pos] = code;
+                code_pos          = out_pos;
+                out_pos++;
+                code = 1;
+            }
+        }
+
+        encoded[code_pos] = code;
+
+        return out_pos;
+    }
+
+    /// @brief Decodes COBS encoded data.
+    /// @param encoded Encoded data, not including the delimiter.
+    /// @param len Length of the encoded data.
+    /// @param data Filled with the decoded data. Must fit len bytes.
+    /// @return Length of the decoded data, or -1 if the encoding is invalid.
+    ///
+    int32_t cobs_decode(const uint8_t *encoded, uint32_t len, uint8_t *data)
+    {
+        REQUIRE((encoded != nullptr) || (len == 0), error::InvalidPointer);
+        REQUIRE(data != nullptr, error::InvalidPointer);
+
+        uint32_t in_pos  = 0;
+        uint32_t out_pos = 0;
+
+        while (in_pos < len)
+        {
+            uint8_t code = encoded[in_pos];
+            if ((code == 0) || ((in_pos + code) > len))
+            {
+                return -1;
+            }
+
+            in_pos++;
+            for (uint32_t i = 1; i < code; i++)
+            {
+                if (encoded[in_pos] == 0)
+                {
+                    return -1;
+                }
+
+                data[out_pos] = encoded[in_pos];
+                out_pos++;
+                in_pos++;
+            }
+
+            if ((code != 0xFF) && (in_pos < len))
+            {
+                data[out_pos] = 0;
+                out_pos++;
+            }
+        }
+
+        return (int32_t)out_pos;
+    }
+
+    /// @brief Feeds received bytes to the protocol. Every complete frame is handled and answered
+    /// as it's received.
+    /// @param data Received bytes (may contain frame delimiters).
+    /// @param len Number of received bytes.
+    /// @return Number of bytes used. Less than len if the host asked to leave binary mode, in which
+    /// case the rest belongs to whoever owns the port in text mode, or if a command was left
+    /// running, in which case the rest should be given once pending() is false.
+    ///
+    uint32_t receive(const char *data, uint32_t len)
+    {
+        REQUIRE(data != nullptr, error::InvalidPointer);
+
+        for (uint32_t i = 0; i < len; i++)
+        {
+            if (data[i] != FRAME_DELIMITER)
+            {
+                if (rx_len < MAX_ENCODED_LEN)
+                {
+                    rx_buf[rx_len] = data[i];
+                    rx_len++;
+                }
+                else
+                {
+                    rx_overflow = true;
+                }
+
+                continue;
+            }
+
+            if ((rx_len > 0) || rx_overflow) // Back to back delimiters are just padding
+            {
+                handle_frame();
+            }
+
+            rx_len      = 0;
+            rx_overflow = false;
+
+            if (cmd_running)
+            {
+                return i + 1;
+            }
+
+            check_exit();
+            if (!binary_mode)
+            {
+                return i + 1;
+            }
+        }
+
+        return len;
+    }
+
+    /// @brief Sends a frame of input samples, unprompted by the host.
+    /// @param samples Samples to send.
+    /// @param count Number of samples. Anything that doesn't fit in a single frame is dropped.
+    ///
+    void send_telemetry(const Sample *samples, uint32_t count)
+    {
+        REQUIRE(samples != nullptr, error::InvalidPointer);
+
+        uint8_t frame_data[MAX_FRAME_LEN];
+        Builder frame = { frame_data, MAX_FRAME_LEN - CRC_LEN, 0 };
+
+        put_u8(&frame, (uint8_t)FrameType::Telemetry);
+        put_u8(&frame, telemetry_seq);
+        put_u8(&frame, (uint8_t)Status::Ok);
+
+        telemetry_seq++;
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            uint32_t sample_start = frame.len;
+            if (!put_u16(&frame, (uint16_t)samples[i].id) || !put_u32(&frame, samples[i].value))
+            {
+                frame.len     = sample_start;
+                frame_data[2] = (uint8_t)Status::Truncated;
+                break;
+            }
+        }
+
+        send_frame(&frame);
+    }
+
+    /// @brief Reads an input as a raw 32-bit value. Floats are sent as their bit pattern.
+    /// @param in Input to read.
+    /// @param value Filled with the value of the input.
+    /// @return Ok, or UnknownType if the input can't be represented in 32 bits.
+    ///
+    Status read_input(input::Input *in, uint32_t *value)
+    {
+        REQUIRE(in != nullptr, error::InvalidPointer);
+        REQUIRE(value != nullptr, error::InvalidPointer);
+
+        const std::type_info &type = *(in->input_type);
+
+        if (type == typeid(bool))
+        {
+            *value = in->get<bool>() ? 1 : 0;
+        }
+        else if (type == typeid(uint32_t))
+        {
+            *value = in->get<uint32_t>();
+        }
+        else if (type == typeid(int32_t))
+        {
+            *value = (uint32_t)in->get<int32_t>();
+        }
+        else if (type == typeid(float *))
+        {
+            float *ptr = in->get<float *>();
+            memcpy(value, ptr, sizeof(*value));
+        }
+        else
+        {
+            return Status::UnknownType;
+        }
+
+        return Status::Ok;
+    }
+
+    /// @brief Checks if a command from the last frame is still running. Its response hasn't been
+    /// sent yet, and no more data should be received until it is.
+    /// @return True if resume() should be called.
+    ///
+    bool pending()
+    {
+        return cmd_running;
+    }
+
+    /// @brief Runs the next slice of the pending command. Once it finishes, the rest of the frame
+    /// is handled and the response sent.
+    ///
+    void resume()
+    {
+        REQUIRE(cmd_running, error::InvalidState);
+
+        command::resume(&cmd_out);
+        if (command::pending())
+        {
+            return;
+        }
+
+        cmd_running = false;
+        finish_command(&frame_resp);
+
+        Status status = handle_records(&frame_req, &frame_resp);
+        if (cmd_running)
+        {
+            return;
+        }
+
+        finish_frame(status);
+        check_exit();
+    }
+
+    /// @brief Checks if the port is in binary mode.
+    /// @return True if received data should go to receive().
+    ///
+    bool active()
+    {
+        return binary_mode;
+    }
+
+    /// @brief Switches to binary mode, dropping any partially received frame.
+    ///
+    void start()
+    {
+        rx_len      = 0;
+        rx_overflow = false;
+        exit_after  = false;
+        binary_mode = true;
+    }
+
+    /// @brief Initializes the protocol.
+    /// @param sink Function that transmits encoded frames.
+    /// @param context Passed to the sink along with each frame.
+    ///
+    void init(FrameSink sink, void *context)
+    {
+        REQUIRE(sink != nullptr, error::InvalidPointer);
+
+        frame_sink    = sink;
+        frame_context = context;
+        binary_mode   = false;
+        cmd_running   = false;
+        telemetry_seq = 0;
+    }
+
+    // End of Namespace
+}
+
+//--------------------------------------------------------------------------------------------------
+// Global Namespace Functions
+//--------------------------------------------------------------------------------------------------
+
+
+//--------------------------------------------------------------------------------------------------
+// Unit Test Accessors
+//--------------------------------------------------------------------------------------------------
+
+// End of File
@@ -10,6 +10,7 @@
 ///
 
 #include "settings.hpp"
+#include "profile.hpp"
 #include "settings_backend.hpp"
 #include "error.hpp"
 #include "version.hpp"
@@ -203,6 +204,8 @@ namespace settings
     ///
     int32_t set(ID id, const char *value, bool save)
     {
+        PROFILE_ZONE(SettingsWrite);
+
         REQUIRE(id < ID::NumSettings, error::IDNotFound);
         REQUIRE(value != nullptr, error::InvalidPointer);
 
@@ -17,8 +17,11 @@
 #include "control.hpp"
 #include "hal.hpp"
 #include "settings.hpp"
+#include "profile.hpp"
+#include "cpu_usage.hpp"
 #include "macros.hpp"
 
+#include <cstdint>
 #include <cstdio>
 
 //--------------------------------------------------------------------------------------------------
@@ -31,6 +34,7 @@ namespace
     //  Private Constants
     //----------------------------------------------------------------------------------------------
 
+    constexpr uint32_t STDOUT_BUF_SIZE = 256;
 
     //----------------------------------------------------------------------------------------------
     //  Private Data Types
@@ -46,6 +50,7 @@ namespace
     //  File Variables
     //----------------------------------------------------------------------------------------------
 
+    char stdout_buf[STDOUT_BUF_SIZE];
 
     //----------------------------------------------------------------------------------------------
     //  Private Functions
@@ -69,7 +74,11 @@ namespace setup
 
         task::init();
 
-        setvbuf(stdout, NULL, _IONBF, 0);
+        profile::init();
+
+        // Line buffered: each line goes out in one write, and output that has to go out sooner
+        // (e.g. prompts, errors) is flushed explicitly.
+        setvbuf(stdout, stdout_buf, _IOLBF, STDOUT_BUF_SIZE);
 
         event::init();
 
@@ -87,6 +96,8 @@ namespace setup
         io::open();
 
         control::open();
+
+        cpu_usage::init();
     }
 
     //----------------------------------------------------------------------------------------------
@@ -0,0 +1,160 @@
+/// @file systime.cpp
+/// @author Denver Hoggatt
+/// @brief Monotonic system time definitions
+///
+/// Copyright (c) 2025 Denver Hoggatt. All rights reserved.
+///
+/// This software is licensed under terms that can be found in the LICENSE file
+/// in the root directory of this software component.
+/// If no LICENSE file comes with this software, it is provided AS-IS.
+///
+
+#include "systime.hpp"
+#include "clock_hal.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+//--------------------------------------------------------------------------------------------------
+//  Macros and Error Checking
+//--------------------------------------------------------------------------------------------------
+
+namespace
+{
+    //----------------------------------------------------------------------------------------------
+    //  Private Constants
+    //----------------------------------------------------------------------------------------------
+
+    constexpr uint32_t HALF_BIT = 31; // Top bit of the counter
+
+    //----------------------------------------------------------------------------------------------
+    //  Private Data Types
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Private Function Prototypes
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  File Variables
+    //----------------------------------------------------------------------------------------------
+
+    // Number of times the counter has gone past half its range. The low bit always matches the top
+    // bit of the counter as of the last read, the rest is the number of times it has wrapped.
+    std::atomic<uint32_t> half_periods;
+
+    //----------------------------------------------------------------------------------------------
+    //  Private Functions
+    //----------------------------------------------------------------------------------------------
+
+    /// @brief Reads the counter, extended to 64 bits. Whoever first reads the counter after it
+    /// crosses into the other half of its range moves half_periods on, so this stays lock free and
+    /// safe from any context, as long as the time is read at least once per half range. That's
+    /// over half an hour at 1MHz, and running periodics read it every millisecond.
+    /// @return Ticks since the counter started.
+    ///
+    uint64_t extended_ticks()
+    {
+        uint32_t half  = half_periods.load();
+        uint32_t ticks = clock_hal::ticks();
+
+        if ((ticks >> HALF_BIT) != (half & 1))
+        {
+            // If this fails someone else already moved it on, and half has been updated to match
+            half_periods.compare_exchange_strong(half, half + 1);
+            half = half_periods.load();
+        }
+
+        return ((uint64_t)(half >> 1) << 32) | ticks;
+    }
+
+    /// @brief Converts a tick count to microseconds, without overflowing for large counts.
+    ///
+    uint64_t to_us(uint64_t ticks, uint32_t rate_hz)
+    {
+        if (rate_hz == systime::US_PER_S)
+        {
+            return ticks;
+        }
+
+        uint64_t whole_s = ticks / rate_hz;
+        uint64_t part_us = ((ticks % rate_hz) * systime::US_PER_S) / rate_hz;
+
+        return (whole_s * systime::US_PER_S) + part_us;
+    }
+
+    // End of Anonymous Namespace
+}
+
+namespace systime
+{
+    //----------------------------------------------------------------------------------------------
+    //  Public Functions
+    //----------------------------------------------------------------------------------------------
+
+    /// @brief Reads the raw counter. This is the cheapest way to time short intervals, as the
+    /// difference between two reads is correct across a wrap. Intervals have to be shorter than the
+    /// full range of the counter (over an hour at 1MHz).
+    /// @return Current count.
+    ///
+    uint32_t ticks()
+    {
+        return clock_hal::ticks();
+    }
+
+    /// @brief Converts a difference of ticks() to microseconds.
+    /// @param ticks Number of ticks.
+    /// @return Microseconds.
+    ///
+    uint32_t ticks_to_us(uint32_t ticks)
+    {
+        return (uint32_t)to_us(ticks, clock_hal::rate_hz());
+    }
+
+    /// @brief Gets the monotonic time.
+    /// @return Microseconds since the clock started.
+    ///
+    uint64_t now_us()
+    {
+        return to_us(extended_ticks(), clock_hal::rate_hz());
+    }
+
+    /// @brief Gets the monotonic time in milliseconds. This wraps after about 49 days, so use the
+    /// difference between two times rather than comparing them.
+    /// @return Milliseconds since the clock started.
+    ///
+    uint32_t now_ms()
+    {
+        return (uint32_t)(now_us() / US_PER_MS);
+    }
+
+    //----------------------------------------------------------------------------------------------
+    //  Class Function Definitions
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Class Operator Definitions
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Class Constructor Definitions
+    //----------------------------------------------------------------------------------------------
+
+
+    // End of Namespace
+}
+
+//--------------------------------------------------------------------------------------------------
+// Global Namespace Functions
+//--------------------------------------------------------------------------------------------------
+
+
+//--------------------------------------------------------------------------------------------------
+// Unit Test Accessors
+//--------------------------------------------------------------------------------------------------
+
+// End of File
@@ -14,6 +14,7 @@
 #include "error.hpp"
 #include "task_open.hpp"
 #include "task_control.hpp"
+#include "task_log.hpp"
 
 #include <cstring>
 #include <cinttypes>
@@ -42,17 +43,13 @@ namespace
         Highest,
     };
 
-    struct Task
+    /// @brief Fixed description of a task, from tasks.def.
+    ///
+    struct TaskInfo
     {
-            const task::ID     id;
-            const TaskPriority priority;
-            const uint16_t     stack_depth;
-            const task::Func   func;
-            uint32_t           stack_base;
-
-            void *handle;
-
-            uint32_t open_signal;
+            TaskPriority priority;
+            uint16_t     stack_depth;
+            task::Func   func;
     };
 
     //----------------------------------------------------------------------------------------------
@@ -64,136 +61,125 @@ namespace
     //  File Variables
     //----------------------------------------------------------------------------------------------
 
-    Task tasks[] = {
+    // Indexed by task::ID, as both are generated from tasks.def in the same order
+    constexpr TaskInfo task_infos[] = {
 
 #define DEF(task_name, prior, depth)                \
     {                                               \
-        .id          = task::ID::task_name,         \
         .priority    = TaskPriority::prior,         \
         .stack_depth = depth,                       \
         .func        = task_##task_name::task_func, \
-        .stack_base  = 0,                           \
-        .handle      = nullptr,                     \
-        .open_signal = 0,                           \
     },
 #include "tasks.def"
 #undef DEF
 
     };
 
+    static_assert(sizeof(task_infos) / sizeof(task_infos[0]) == (uint32_t)task::ID::NumIDs,
+                  "Every task needs an entry in task_infos");
+
+    void    *handles[(uint32_t)task::ID::NumIDs];
+    uint32_t open_signals[(uint32_t)task::ID::NumIDs];
+
     //----------------------------------------------------------------------------------------------
     //  Private Functions
     //----------------------------------------------------------------------------------------------
 
-    /// @brief Gets a pointer to a task using the given id.
-    /// @param id ID of the task.
-    /// @return Pointer to the task.
+    /// @brief Finds a task by its function. This scans the tasks, which is fine for the open-time
+    /// calls that use it, but run-time paths should go by ID.
+    /// @param func task_func of the task to find.
+    /// @return ID of the task, or NumIDs if there isn't one.
     ///
-    Task *get_task_by_id(task::ID id)
+    task::ID find_by_func(task::Func func)
     {
-        Task *ret_val = nullptr;
-
         for (uint32_t i = 0; i < task::num(); i++)
         {
-            if (tasks[i].id == id)
+            if (task_infos[i].func == func)
             {
-                ret_val = &tasks[i];
+                return (task::ID)i;
             }
         }
 
-        return ret_val;
+        return task::ID::NumIDs;
     }
 
-    /// @brief Gets a pointer to a task using the given function.
-    /// @param func task_func of the task to get.
-    /// @return Pointer to the task.
+    // End of Anonymous Namespace
+}
+
+namespace task
+{
+    //----------------------------------------------------------------------------------------------
+    //  Public Functions
+    //----------------------------------------------------------------------------------------------
+
+    /// @brief Writes the maximum stack usage statistics of a task.
+    /// @param out Where to write the statistics.
+    /// @param id ID of the task.
     ///
-    Task *get_task_by_func(task::Func func)
+    void write_stack_usage(utility::Writer *out, ID id)
     {
-        Task *ret_val = nullptr;
+        REQUIRE(out != nullptr, error::InvalidPointer);
+        REQUIRE(id < ID::NumIDs, error::InvalidID);
 
-        for (uint32_t i = 0; i < task::num(); i++)
-        {
-            if (tasks[i].func == func)
-            {
-                ret_val = &tasks[i];
-            }
-        }
+        task_osal::StackInfo info = task_osal::get_stack_info(id);
 
-        return ret_val;
+        out->print("Task %" PRIu32 " Stack Usage:\r\n", (uint32_t)id);
+        out->print("Stack %" PRIu32 " Base           (addr): %p\r\n", (uint32_t)id, info.base);
+        out->print("Stack %" PRIu32 " End            (addr): %p\r\n",
+                   (uint32_t)id,
+                   &info.base[info.size]);
+        out->print("Stack %" PRIu32 " Size          (bytes): %" PRIu32 "\r\n",
+                   (uint32_t)id,
+                   info.size);
+        out->print("Stack %" PRIu32 " Maximum Usage (bytes): %" PRIu32 "\r\n",
+                   (uint32_t)id,
+                   info.high_water);
+        out->write("\r\n");
     }
 
-    /// @brief Shortcut to get the open task.
-    /// @return Pointer to the open task.
+    /// @brief Writes (part of) the contents of a task's stack. Large stacks can be dumped a slice
+    /// at a time by calling this repeatedly with the same offset until it returns true.
+    /// @param out Where to write the stack contents.
+    /// @param id ID of the task.
+    /// @param offset Offset into the stack to start from. Advanced past what was written.
+    /// @param max_len Maximum number of bytes to write.
+    /// @return True once the whole stack has been written.
     ///
-    const Task *get_open_task()
+    bool write_stack_dump(utility::Writer *out, ID id, uint32_t *offset, uint32_t max_len)
     {
-        Task *ret_val = get_task_by_id(task::ID::open);
+        REQUIRE(out != nullptr, error::InvalidPointer);
+        REQUIRE(offset != nullptr, error::InvalidPointer);
+        REQUIRE(id < ID::NumIDs, error::InvalidID);
 
-        ENSURE(ret_val != nullptr, error::IDNotFound);
+        task_osal::StackInfo info = task_osal::get_stack_info(id);
+        REQUIRE(*offset <= info.size, error::InvalidLength);
 
-        return ret_val;
-    }
+        if (*offset == 0)
+        {
+            out->write("Stack Dump:\r\n");
+        }
 
-    /// @brief Dumps the stack.
-    /// @param stack_start Start of the stack.
-    /// @param stack_size Size of the stack.
-    ///
-    void dump_stack(uint8_t *stack_start, uint32_t stack_size)
-    {
-        printf("Stack Dump:\r\n");
+        uint32_t end = ((info.size - *offset) > max_len) ? (*offset + max_len) : info.size;
 
-        for (uint32_t i = 0; i < stack_size; i++)
+        for (uint32_t i = *offset; i < end; i++)
         {
-            printf("%02X ", stack_start[i]);
+            out->print("%02X ", info.base[i]);
 
             if ((i + 1) % 16 == 0)
             {
-                printf("\r\n");
+                out->write("\r\n");
             }
         }
 
-        printf("\r\n");
-    }
-
-    // End of Anonymous Namespace
-}
-
-namespace task
-{
-    //----------------------------------------------------------------------------------------------
-    //  Public Functions
-    //----------------------------------------------------------------------------------------------
+        *offset = end;
 
-    /// @brief Prints the maximum stack usage statistics.
-    /// @param dump True to also print out the stack contents.
-    ///
-    void print_maximum_stack_usage(bool dump)
-    {
-        for (uint32_t i = 0; i < num(); i++)
+        bool done = (end == info.size);
+        if (done)
         {
-            task_osal::StackInfo info = task_osal::get_stack_info(tasks[i].id);
-
-            printf("Task %" PRIu32 " Stack Usage:\r\n", (uint32_t)tasks[i].id);
-            printf("Stack %" PRIu32 " Base           (addr): %p\r\n",
-                   (uint32_t)tasks[i].id,
-                   info.base);
-            printf("Stack %" PRIu32 " End            (addr): %p\r\n",
-                   (uint32_t)tasks[i].id,
-                   &info.base[info.size]);
-            printf("Stack %" PRIu32 " Size          (bytes): %" PRIu32 "\r\n",
-                   (uint32_t)tasks[i].id,
-                   info.size);
-            printf("Stack %" PRIu32 " Maximum Usage (bytes): %" PRIu32 "\r\n",
-                   (uint32_t)tasks[i].id,
-                   info.high_water);
-            printf("\r\n");
-
-            if (dump)
-            {
-                dump_stack(info.base, info.size);
-            }
+            out->write("\r\n");
         }
+
+        return done;
     }
 
     /// @brief Get the number of tasks.
@@ -212,15 +198,7 @@ namespace task
     {
         REQUIRE(func != nullptr, error::InvalidPointer);
 
-        ID ret_val = ID::NumIDs;
-
-        Task *task = get_task_by_func(func);
-        if (task != nullptr)
-        {
-            ret_val = task->id;
-        }
-
-        return ret_val;
+        return find_by_func(func);
     }
 
     /// @brief Sends the open signal for the associated task.
@@ -230,15 +208,15 @@ namespace task
     {
         REQUIRE(calling_func != nullptr, error::InvalidPointer);
 
-        Task *task = get_task_by_func(calling_func);
-        if (task != nullptr)
+        ID id = find_by_func(calling_func);
+        if (id != ID::NumIDs)
         {
-            const Task *open_task = get_open_task();
-            task_osal::send_signal(open_task->handle, task->open_signal);
+            task_osal::send_signal(handles[(uint32_t)ID::open], open_signals[(uint32_t)id]);
         }
     }
 
-    /// @brief Sends a signal to another task.
+    /// @brief Sends a signal to another task. This is on the path of every event posted, so it's
+    /// a single lookup by ID.
     /// @param task_id ID of the task to signal.
     /// @param signal Signal to send.
     ///
@@ -247,11 +225,7 @@ namespace task
         REQUIRE(task_id < ID::NumIDs, error::InvalidID);
         REQUIRE(signal < Signal::NumSigs, error::InvalidSignal);
 
-        Task *task = get_task_by_id(task_id);
-        if (task != nullptr)
-        {
-            task_osal::send_signal(task->handle, static_cast<uint32_t>(signal));
-        }
+        task_osal::send_signal(handles[(uint32_t)task_id], static_cast<uint32_t>(signal));
     }
 
     /// @brief Broadcast a signal to all tasks.
@@ -266,9 +240,9 @@ namespace task
 
         for (uint32_t i = 0; i < num(); i++)
         {
-            if (tasks[i].id != thisTask)
+            if ((ID)i != thisTask)
             {
-                task_osal::send_signal(tasks[i].handle, static_cast<uint32_t>(signal));
+                task_osal::send_signal(handles[i], static_cast<uint32_t>(signal));
             }
         }
     }
@@ -306,14 +280,14 @@ namespace task
 
         for (uint32_t i = 0; i < num(); i++)
         {
-            tasks[i].open_signal = 1 << i;
-            tasks[i].handle      = nullptr;
+            open_signals[i] = 1 << i;
+            handles[i]      = nullptr;
 
-            error::Error err = task_osal::create_task(tasks[i].func,
-                                                      static_cast<uint32_t>(tasks[i].id),
-                                                      static_cast<uint16_t>(tasks[i].stack_depth),
-                                                      static_cast<uint32_t>(tasks[i].priority),
-                                                      &tasks[i].handle);
+            error::Error err = task_osal::create_task(task_infos[i].func,
+                                                      i,
+                                                      task_infos[i].stack_depth,
+                                                      static_cast<uint32_t>(task_infos[i].priority),
+                                                      &handles[i]);
 
             ENSURE(err == error::NoError, err);
         }
@@ -353,20 +327,17 @@ namespace task_test
 
     void *get_handle_from_id(task::ID id)
     {
-        Task *task = get_task_by_id(id);
-        return task->handle;
+        return handles[(uint32_t)id];
     }
 
     void set_handle_by_id(task::ID id, void *handle)
     {
-        Task *task   = get_task_by_id(id);
-        task->handle = handle;
+        handles[(uint32_t)id] = handle;
     }
 
     void set_open_sig_by_id(task::ID id, uint32_t sig)
     {
-        Task *task        = get_task_by_id(id);
-        task->open_signal = sig;
+        open_signals[(uint32_t)id] = sig;
     }
 
 }
@@ -6,7 +6,9 @@
 #include "event.hpp"
 #include "error.hpp"
 #include "input.hpp"
+#include "output.hpp"
 #include "control.hpp"
+#include "periodic.hpp"
 #include "adc_hal.hpp"
 #include "macros.hpp"
 
@@ -50,10 +52,19 @@ namespace task_control
             event::Event event = event::handle(task_id);
             while (event.id != event::ID::NullEvent)
             {
-                control::disperse_event(event);
+                if (event.id == event::ID::control_RunPeriodic)
+                {
+                    periodic::run((periodic::ID)(uintptr_t)event.arg);
+                }
+                else
+                {
+                    control::disperse_event(event);
+                }
 
                 event = event::handle(task_id);
             }
+
+            output::commit();
         }
 
         /// @brief Opens any task specific modules or sets task specific
@@ -0,0 +1,102 @@
+/// @file task_log.cpp
+/// Definitions for the deferred log task.
+
+#include "task_log.hpp"
+#include "task.hpp"
+#include "logging.hpp"
+#include "macros.hpp"
+
+//------------------------------------------------------------------------------
+//  Macros and Error Checking
+//------------------------------------------------------------------------------
+
+
+namespace task_log
+{
+    namespace
+    {
+        //---------------------------------------------------------------------
+        //  Private Data Types
+        //---------------------------------------------------------------------
+
+
+        //---------------------------------------------------------------------
+        //  Private Function Prototypes
+        //---------------------------------------------------------------------
+
+
+        //---------------------------------------------------------------------
+        //  File Variables
+        //---------------------------------------------------------------------
+
+
+        //---------------------------------------------------------------------
+        //  Private Functions
+        //---------------------------------------------------------------------
+
+        /// @brief Opens any task specific modules or sets task specific
+        /// open-time variables.
+        ///
+        void open_modules()
+        {
+            logging::init();
+        }
+
+        // End of Anonymous Namespace
+    }
+
+    //-------------------------------------------------------------------------
+    //  Public Functions
+    //-------------------------------------------------------------------------
+
+    /// @brief Sends logged messages whenever it's woken. This runs at the
+    /// lowest priority, so formatting and transmitting logs only uses time
+    /// the rest of the system doesn't need.
+    ///
+    void task_func(void *argument)
+    {
+        UNUSED(argument);
+        task::wait_strict(task::Signal::GlobalOpen);
+
+        // Open Time
+        open_modules();
+        task::send_open_signal(task_func);
+        task::wait_strict(task::Signal::GlobalRun);
+
+        // Run Time
+        while (1)
+        {
+            uint32_t rcvd_signals = task::wait_any();
+
+            uint32_t event_sig = static_cast<uint32_t>(task::Signal::GlobalEvent);
+            if (rcvd_signals & event_sig)
+            {
+                logging::flush();
+            }
+
+            if (rcvd_signals & (uint32_t)task::Signal::GlobalTerminate)
+            {
+                break;
+            }
+        }
+    }
+
+
+    //-------------------------------------------------------------------------
+    //  Class Definitions
+    //-------------------------------------------------------------------------
+
+
+    // End of Namespace
+}
+
+//------------------------------------------------------------------------------
+// Global Namespace Functions
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Unit Test Accessors
+//------------------------------------------------------------------------------
+
+// End of File
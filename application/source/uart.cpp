@@ -11,7 +11,10 @@
 
 #include "uart.hpp"
 #include "uart_hal.hpp"
+#include "isr_hal.hpp"
 #include "event.hpp"
+#include "mutex.hpp"
+#include "timer_osal.hpp"
 #include "macros.hpp"
 
 #include <cstring>
@@ -29,32 +32,136 @@ namespace
     //  Private Constants
     //----------------------------------------------------------------------------------------------
 
-    constexpr uint32_t RCVD_QUEUE_SIZE = 64;
+    constexpr uint32_t RCVD_QUEUE_SIZE = 512; // Room for a couple of full protocol frames
+    constexpr uint32_t TX_QUEUE_SIZE   = 512; // Room for a whole encoded frame
+
+    constexpr uint32_t TX_WAIT_MS = 1; // Time for the TX interrupt to make room, ~11 chars at 115200
+
+    constexpr uart::VirtualPort STDOUT_PORT = uart::VirtualPort::UART_CLI;
+
+    static_assert((uint32_t)uart::VirtualPort::NumPorts <= mutex::MAX_UART_PORTS);
 
     //----------------------------------------------------------------------------------------------
     //  Private Data Types
     //----------------------------------------------------------------------------------------------
 
+    /// @brief Receive and transmit queues of a single port.
+    ///
+    struct PortQueues
+    {
+        bool                      isr_enabled;
+        mutex::ID                 tx_mutex; // Held while adding to the TX queue, or draining it
+        uint16_t                  rcvd_queue_front;
+        std::atomic_uint_fast16_t rcvd_queue_rear;
+        char                      rcvd_queue[RCVD_QUEUE_SIZE];
+        std::atomic_uint32_t      rcvd_dropped; // Characters received while the queue was full
+        std::atomic_uint_fast16_t tx_queue_front;
+        std::atomic_uint_fast16_t tx_queue_rear;
+        char                      tx_queue[TX_QUEUE_SIZE];
+    };
 
     //----------------------------------------------------------------------------------------------
     //  Private Function Prototypes
     //----------------------------------------------------------------------------------------------
 
+    PortQueues *get_queues(uart::VirtualPort port);
+
+    uint32_t tx_space(PortQueues *queues);
+
+    void wait_for_tx(uart::VirtualPort port);
+
+    void queue_tx(uart::VirtualPort port, const char *data, uint32_t len);
 
     //----------------------------------------------------------------------------------------------
     //  File Variables
     //----------------------------------------------------------------------------------------------
 
-    bool                      isr_enabled      = false;
-    bool                      processing_read  = false;
-    uint16_t                  rcvd_queue_front = 0;
-    std::atomic_uint_fast16_t rcvd_queue_rear;
-    char                      rcvd_queue[RCVD_QUEUE_SIZE];
+    PortQueues port_queues[(uint32_t)uart::VirtualPort::NumPorts];
 
     //----------------------------------------------------------------------------------------------
     //  Private Functions
     //----------------------------------------------------------------------------------------------
 
+    /// @brief Gets the queues of a port.
+    /// @param port Port.
+    /// @return Queues of the port.
+    ///
+    PortQueues *get_queues(uart::VirtualPort port)
+    {
+        REQUIRE(port < uart::VirtualPort::NumPorts, error::InvalidID);
+
+        return &port_queues[(uint32_t)port];
+    }
+
+    /// @brief Gets the free space in the TX queue of a port.
+    /// @param queues Queues of the port.
+    /// @return Number of characters that can be added.
+    ///
+    uint32_t tx_space(PortQueues *queues)
+    {
+        uint32_t front = queues->tx_queue_front.load();
+        uint32_t rear  = queues->tx_queue_rear.load();
+
+        return (front + TX_QUEUE_SIZE - rear - 1) % TX_QUEUE_SIZE;
+    }
+
+    /// @brief Waits for the TX interrupt to make room in the TX queue of a port. The TX mutex of
+    /// the port is given back while blocked, so other tasks can queue in the meantime, and is
+    /// held again once this returns.
+    /// @param port Port to transmit on.
+    ///
+    void wait_for_tx(uart::VirtualPort port)
+    {
+        PortQueues *queues = get_queues(port);
+
+        mutex::give(queues->tx_mutex);
+        timer_osal::delay_ms(TX_WAIT_MS);
+        mutex::take(queues->tx_mutex);
+    }
+
+    /// @brief Copies data into the TX queue of a port, and has the HAL start draining it. Only
+    /// blocks if the TX queue is full. Each piece that fits in the TX queue goes in as a whole, so
+    /// writes from other tasks can't land in the middle of it (e.g. in the middle of a frame).
+    /// @param port Port to transmit on.
+    /// @param data Data to write.
+    /// @param len Length of the data.
+    ///
+    void queue_tx(uart::VirtualPort port, const char *data, uint32_t len)
+    {
+        PortQueues *queues = get_queues(port);
+
+        mutex::take(queues->tx_mutex);
+
+        while (len > 0)
+        {
+            uint32_t piece = (len < TX_QUEUE_SIZE - 1) ? len : (TX_QUEUE_SIZE - 1);
+
+            // The HAL pulls from the queue here as well as from the interrupt, which is only
+            // allowed while holding the TX mutex
+            uart_hal::transmit(port);
+            while (tx_space(queues) < piece)
+            {
+                wait_for_tx(port);
+                uart_hal::transmit(port);
+            }
+
+            uint16_t rear = queues->tx_queue_rear.load();
+            for (uint32_t i = 0; i < piece; i++)
+            {
+                queues->tx_queue[(rear + i) % TX_QUEUE_SIZE] = data[i];
+            }
+
+            queues->tx_queue_rear = (rear + piece) % TX_QUEUE_SIZE; // Publish once it's all in
+
+            data += piece;
+            len -= piece;
+        }
+
+        uart_hal::transmit(port);
+
+        mutex::give(queues->tx_mutex);
+    }
+
 
     // End of Anonymous Namespace
 }
@@ -65,24 +172,125 @@ namespace uart
     //  Public Functions
     //----------------------------------------------------------------------------------------------
 
-    /// @brief UART handling ISR.
-    /// @param c Character received from the UART.
+    /// @brief UART handling ISR. Queues a batch of received characters and posts a single input
+    /// event for the whole batch, with the port as the event argument. Characters that don't fit
+    /// in the receive queue are dropped and counted, see UART::dropped().
+    /// @param port Port the characters were received on.
+    /// @param data Characters received from the UART.
+    /// @param len Number of characters received.
     ///
-    void isr_read(char c)
+    void isr_read(VirtualPort port, const char *data, uint32_t len)
     {
-        volatile uint16_t pos      = rcvd_queue_rear.fetch_add(1) % RCVD_QUEUE_SIZE;
-        volatile uint16_t next_pos = (pos + 1) % RCVD_QUEUE_SIZE;
+        REQUIRE(data != nullptr, error::InvalidPointer);
+
+        PortQueues *queues = get_queues(port);
 
-        INVAR(next_pos != (rcvd_queue_front % RCVD_QUEUE_SIZE), error::QueueOverflow);
+        if (len == 0)
+        {
+            return;
+        }
 
-        rcvd_queue[pos] = c;
+        for (uint32_t i = 0; i < len; i++)
+        {
+            uint_fast16_t rear     = queues->rcvd_queue_rear.load();
+            uint16_t      pos      = rear % RCVD_QUEUE_SIZE;
+            uint16_t      next_pos = (pos + 1) % RCVD_QUEUE_SIZE;
+
+            if (next_pos == queues->rcvd_queue_front)
+            {
+                // Only the ISR writes the count, so it doesn't need an atomic increment
+                queues->rcvd_dropped.store(queues->rcvd_dropped.load() + 1);
+                continue;
+            }
+
+            queues->rcvd_queue[pos] = data[i];
+            queues->rcvd_queue_rear.store(rear + 1); // Publish the character once it's in
+        }
 
-        if (!isr_enabled)
+        if (!queues->isr_enabled)
         {
             return;
         }
 
-        event::post(event::ID::control_UARTInput, (void *)0);
+        event::post(event::ID::control_UARTInput, (void *)(uintptr_t)port);
+    }
+
+    /// @brief Pulls the next character to transmit out of the TX queue. Called by the UART HAL,
+    /// either from the TX interrupt or with the TX interrupt masked by a task holding the TX
+    /// mutex of the port, so there's only ever one consumer.
+    /// @param port Port to transmit on.
+    /// @param c Filled with the next character to transmit.
+    /// @return True if a character was pulled, false if the TX queue is empty.
+    ///
+    bool isr_transmit(VirtualPort port, char *c)
+    {
+        PortQueues *queues = get_queues(port);
+
+        uint16_t front = queues->tx_queue_front.load();
+
+        if (front == queues->tx_queue_rear.load())
+        {
+            return false;
+        }
+
+        *c                     = queues->tx_queue[front];
+        queues->tx_queue_front = (front + 1) % TX_QUEUE_SIZE;
+
+        return true;
+    }
+
+    /// @brief Writes stdout data to the console port's TX queue.
+    /// @param data Data to write.
+    /// @param len Length of the data.
+    /// @return False if the queue can't be used, in which case nothing is written and the caller
+    /// polls it out instead. That's until the console port is open, from an interrupt (which can't
+    /// take the TX mutex), and while an error is being handled.
+    ///
+    bool write_stdout(const char *data, uint32_t len)
+    {
+        if (error::handling() || isr_hal::is_in_interrupt())
+        {
+            return false;
+        }
+
+        REQUIRE(data != nullptr, error::InvalidPointer);
+
+        if (!get_queues(STDOUT_PORT)->isr_enabled)
+        {
+            return false;
+        }
+
+        queue_tx(STDOUT_PORT, data, len);
+
+        return true;
+    }
+
+    /// @brief Waits until everything in the TX queue of a port has been handed to the hardware.
+    /// Blocks, so it can only be called from a task.
+    /// @param port Port to drain.
+    ///
+    void drain(VirtualPort port)
+    {
+        PortQueues *queues = get_queues(port);
+
+        if (!queues->isr_enabled)
+        {
+            return;
+        }
+
+        mutex::take(queues->tx_mutex);
+
+        while (queues->tx_queue_front.load() != queues->tx_queue_rear.load())
+        {
+            uart_hal::transmit(port);
+
+            if (queues->tx_queue_front.load() != queues->tx_queue_rear.load())
+            {
+                wait_for_tx(port);
+            }
+        }
+
+        mutex::give(queues->tx_mutex);
     }
 
     //----------------------------------------------------------------------------------------------
@@ -97,41 +305,105 @@ namespace uart
         io::print("UART", this->name, this->id, (char *)data, dir);
     }
 
-    /// @brief Gets the input data.
+    /// @brief Gets the input data. This copies (and consumes) everything that has been received,
+    /// use peek() and consume() to read the receive queue in-place instead.
     /// @return Input data.
     ///
     void *UART::get_by_id()
     {
         static char ret_buf[RCVD_QUEUE_SIZE + 1];
 
-        uint16_t rear = rcvd_queue_rear.load() % RCVD_QUEUE_SIZE;
+        Span     spans[2];
+        uint32_t cnt = this->peek(spans);
+
+        INVAR(cnt <= RCVD_QUEUE_SIZE, error::InvalidLength);
+
+        memcpy(ret_buf, spans[0].data, spans[0].len);
+        memcpy(&ret_buf[spans[0].len], spans[1].data, spans[1].len);
+        ret_buf[cnt] = '\0';
+
+        this->consume(cnt);
+
+        return ret_buf;
+    }
+
+    /// @brief Gets the received data without copying it out of the receive queue. The data is
+    /// returned as up to two spans, the second one being used when the data wraps around the end
+    /// of the queue. The data stays in the queue until consume() is called.
+    /// @param spans Filled with the received data, unused spans have a length of zero.
+    /// @return Total number of received characters.
+    ///
+    uint32_t UART::peek(Span (&spans)[2])
+    {
+        PortQueues *queues = get_queues(this->uart_port);
+
+        uint16_t rear = queues->rcvd_queue_rear.load() % RCVD_QUEUE_SIZE;
 
         std::atomic<uint32_t> memory_barrier; // Prevent re-ordering
         memory_barrier.load();
 
-        memset(ret_buf, '\0', RCVD_QUEUE_SIZE + 1);
+        uint16_t front = queues->rcvd_queue_front;
 
-        uint32_t cnt = 0;
-        while (rcvd_queue_front != rear)
-        {
-            INVAR(cnt <= RCVD_QUEUE_SIZE, error::InvalidLength);
+        spans[0].data = &queues->rcvd_queue[front];
+        spans[1].data = &queues->rcvd_queue[0];
 
-            ret_buf[cnt]     = rcvd_queue[rcvd_queue_front];
-            rcvd_queue_front = (rcvd_queue_front + 1) % RCVD_QUEUE_SIZE;
-            cnt++;
+        if (rear >= front)
+        {
+            spans[0].len = rear - front;
+            spans[1].len = 0;
+        }
+        else
+        {
+            spans[0].len = RCVD_QUEUE_SIZE - front;
+            spans[1].len = rear;
         }
 
-        return ret_buf;
+        return spans[0].len + spans[1].len;
+    }
+
+    /// @brief Releases received data returned by peek() back to the receive queue.
+    /// @param len Number of characters to release.
+    ///
+    void UART::consume(uint32_t len)
+    {
+        Span spans[2];
+        REQUIRE(len <= this->peek(spans), error::InvalidLength);
+
+        PortQueues *queues = get_queues(this->uart_port);
+
+        queues->rcvd_queue_front = (queues->rcvd_queue_front + len) % RCVD_QUEUE_SIZE;
     }
 
-    /// @brief Sets the output data.
+    /// @brief Gets the number of characters dropped because the receive queue was full.
+    /// @return Number of dropped characters since init().
+    ///
+    uint32_t UART::dropped()
+    {
+        return get_queues(this->uart_port)->rcvd_dropped.load();
+    }
+
+    /// @brief Writes raw data (which may contain '\0') to the port. The data is copied into the TX
+    /// queue and drained by the UART HAL, so this only blocks if the TX queue is full.
+    /// @param data Data to write.
+    /// @param len Length of the data.
+    ///
+    void UART::write(const char *data, uint32_t len)
+    {
+        REQUIRE(data != nullptr, error::InvalidPointer);
+
+        queue_tx(this->uart_port, data, len);
+    }
+
+    /// @brief Sets the output data. The string is copied into the TX queue, see write().
     /// @param data Data to set.
     ///
     void UART::set_output(void *data)
     {
+        REQUIRE(data != nullptr, error::InvalidPointer);
+
         const char *write_str = (const char *)data;
 
-        uart_hal::send(this->uart_port, write_str);
+        this->write(write_str, strlen(write_str));
     }
 
     /// @brief Initializes the IO.
@@ -140,16 +412,25 @@ namespace uart
     {
         REENTRY_GUARD_CLASS();
 
-        REQUIRE(std::atomic_is_lock_free(&rcvd_queue_rear), error::DeviceInitFailed);
+        PortQueues *queues = get_queues(this->uart_port);
+
+        REQUIRE(std::atomic_is_lock_free(&queues->rcvd_queue_rear), error::DeviceInitFailed);
+        REQUIRE(std::atomic_is_lock_free(&queues->tx_queue_rear), error::DeviceInitFailed);
 
-        rcvd_queue_rear = 0;
+        queues->rcvd_queue_front = 0;
+        queues->rcvd_queue_rear  = 0;
+        queues->rcvd_dropped     = 0;
+        queues->tx_queue_front   = 0;
+        queues->tx_queue_rear    = 0;
+        queues->tx_mutex
+            = (mutex::ID)((uint32_t)mutex::ID::UARTTransmit + (uint32_t)this->uart_port);
 
         this->init_input_info(&typeid(const char *), io::IOType::UART);
         this->init_output_info(&typeid(const char *), io::IOType::UART);
 
         error::Error err = uart_hal::open(this->uart_port);
 
-        isr_enabled = true;
+        queues->isr_enabled = true;
 
         ENSURE(err == error::NoError, error::DeviceInitFailed);
     }
@@ -171,6 +452,15 @@ namespace uart
 // Global Namespace Functions
 //--------------------------------------------------------------------------------------------------
 
+/// @brief Output hook for the _write syscall, so that buffered stdout goes through the console's TX
+/// queue instead of being polled out a character at a time.
+/// @return Number of characters written, or -1 if the console isn't open yet.
+///
+extern "C" int __io_write(const char *ptr, int len)
+{
+    return uart::write_stdout(ptr, (uint32_t)len) ? len : -1;
+}
+
 
 //--------------------------------------------------------------------------------------------------
 // Unit Test Accessors
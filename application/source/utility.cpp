@@ -13,6 +13,9 @@
 #include "error.hpp"
 
 #include <cstdint>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
 
 //--------------------------------------------------------------------------------------------------
 //  Macros and Error Checking
@@ -90,6 +93,85 @@ namespace utility
     //  Class Function Definitions
     //----------------------------------------------------------------------------------------------
 
+    /// @brief Writes a string, passing full chunks on to the sink as they fill up.
+    /// @param str String to write.
+    ///
+    void Writer::write(const char *str)
+    {
+        REQUIRE(str != nullptr, error::InvalidPointer);
+
+        while (*str != '\0')
+        {
+            if (this->len == WRITER_CHUNK_SIZE)
+            {
+                this->flush();
+            }
+
+            this->chunk[this->len] = *str;
+            this->len++;
+            str++;
+        }
+    }
+
+    /// @brief Writes formatted text. A single call can produce at most WRITER_CHUNK_SIZE
+    /// characters, anything past that is truncated.
+    /// @param format printf style format string.
+    ///
+    void Writer::print(const char *format, ...)
+    {
+        REQUIRE(format != nullptr, error::InvalidPointer);
+
+        va_list args;
+
+        va_start(args, format);
+        int32_t needed = vsnprintf(&this->chunk[this->len], (WRITER_CHUNK_SIZE - this->len) + 1,
+                                   format, args);
+        va_end(args);
+
+        if ((needed >= 0) && ((uint32_t)needed > (WRITER_CHUNK_SIZE - this->len)))
+        {
+            this->chunk[this->len] = '\0'; // Doesn't fit, start a fresh chunk and retry
+
+            this->flush();
+
+            va_start(args, format);
+            needed = vsnprintf(this->chunk, WRITER_CHUNK_SIZE + 1, format, args);
+            va_end(args);
+        }
+
+        if (needed > 0)
+        {
+            this->len = strlen(this->chunk);
+        }
+    }
+
+    /// @brief Passes whatever has been written so far on to the sink.
+    ///
+    void Writer::flush()
+    {
+        if (this->len == 0)
+        {
+            return;
+        }
+
+        this->chunk[this->len] = '\0';
+        this->sink(this->context, this->chunk);
+        this->len = 0;
+    }
+
+    /// @brief Initializes the writer.
+    /// @param sink Function the chunks are passed to.
+    /// @param context Passed to the sink along with each chunk.
+    ///
+    void Writer::init(WriterSink sink, void *context)
+    {
+        REQUIRE(sink != nullptr, error::InvalidPointer);
+
+        this->sink     = sink;
+        this->context  = context;
+        this->len      = 0;
+        this->chunk[0] = '\0';
+    }
 
     //----------------------------------------------------------------------------------------------
     //  Class Operator Definitions
@@ -0,0 +1,269 @@
+/// @file watch.cpp
+/// @author Denver Hoggatt
+/// @brief Input watch definitions
+///
+/// Copyright (c) 2025 Denver Hoggatt. All rights reserved.
+///
+/// This software is licensed under terms that can be found in the LICENSE file
+/// in the root directory of this software component.
+/// If no LICENSE file comes with this software, it is provided AS-IS.
+///
+
+#include "watch.hpp"
+#include "error.hpp"
+#include "macros.hpp"
+#include "event.hpp"
+#include "input.hpp"
+#include "periodic.hpp"
+#include "protocol.hpp"
+
+#include <atomic>
+#include <cinttypes>
+#include <cstdint>
+
+//--------------------------------------------------------------------------------------------------
+//  Macros and Error Checking
+//--------------------------------------------------------------------------------------------------
+
+namespace
+{
+    //----------------------------------------------------------------------------------------------
+    //  Private Constants
+    //----------------------------------------------------------------------------------------------
+
+    constexpr uint32_t MS_PER_S = 1000;
+
+    //----------------------------------------------------------------------------------------------
+    //  Private Data Types
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Private Function Prototypes
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  File Variables
+    //----------------------------------------------------------------------------------------------
+
+    input::Input *watched[watch::MAX_INPUTS];
+    uint32_t      num_watched = 0;
+    bool          watching    = false;
+
+    std::atomic<bool> sample_pending; // A sample event is posted, but not yet handled
+    uint32_t          missed = 0;     // Samples dropped because the last one wasn't handled yet
+
+    //----------------------------------------------------------------------------------------------
+    //  Private Functions
+    //----------------------------------------------------------------------------------------------
+
+    /// @brief Periodic callback. Sampling is done by whoever handles the event, so that reading
+    /// the inputs and writing them out happens in the control task rather than the timer's. If the
+    /// last sample still hasn't been handled, this one is dropped instead of piling up events.
+    /// Only this sets sample_pending, and only the handler clears it, so a plain load and store is
+    /// enough.
+    /// @param curr_time_ms Current system time.
+    ///
+    void post_sample(uint32_t curr_time_ms)
+    {
+        if (sample_pending.load())
+        {
+            missed++;
+            return;
+        }
+
+        sample_pending.store(true);
+        event::post(event::ID::control_IOWatch, (void *)(uintptr_t)curr_time_ms);
+    }
+
+    /// @brief Writes the value of an input as part of a text record.
+    ///
+    void write_value(utility::Writer *out, input::Input *in)
+    {
+        const std::type_info &type = *(in->input_type);
+
+        if (type == typeid(float *))
+        {
+            float *ptr = in->get<float *>();
+            out->print(" %f", (double)(*ptr));
+        }
+        else if (type == typeid(bool))
+        {
+            out->print(" %1d", in->get<bool>());
+        }
+        else if (type == typeid(uint32_t))
+        {
+            out->print(" %" PRIu32, in->get<uint32_t>());
+        }
+        else if (type == typeid(int32_t))
+        {
+            out->print(" %" PRId32, in->get<int32_t>());
+        }
+        else
+        {
+            out->write(" ?");
+        }
+    }
+
+    /// @brief Sends the watched inputs as a telemetry frame. Inputs that can't be represented as a
+    /// 32-bit value are left out.
+    ///
+    void send_samples()
+    {
+        protocol::Sample samples[watch::MAX_INPUTS];
+        uint32_t         count = 0;
+
+        for (uint32_t i = 0; i < num_watched; i++)
+        {
+            uint32_t value = 0;
+            if (protocol::read_input(watched[i], &value) == protocol::Status::Ok)
+            {
+                samples[count].id    = watched[i]->id;
+                samples[count].value = value;
+                count++;
+            }
+        }
+
+        protocol::send_telemetry(samples, count);
+    }
+
+    // End of Anonymous Namespace
+}
+
+namespace watch
+{
+    //----------------------------------------------------------------------------------------------
+    //  Public Functions
+    //----------------------------------------------------------------------------------------------
+
+    /// @brief Samples the watched inputs and writes them out. While the binary protocol is active
+    /// this is a telemetry frame, otherwise it's a text record of the sample time followed by the
+    /// value of each input, in the order they were given to start().
+    /// @param out Where text records are written.
+    /// @param time_ms Time the sample was taken at (the arg of the IOWatch event).
+    ///
+    void sample(utility::Writer *out, uint32_t time_ms)
+    {
+        REQUIRE(out != nullptr, error::InvalidPointer);
+
+        sample_pending = false;
+
+        if (!watching)
+        {
+            return; // Stopped after the event was posted
+        }
+
+        if (protocol::active())
+        {
+            send_samples();
+            return;
+        }
+
+        out->print("%" PRIu32, time_ms);
+        for (uint32_t i = 0; i < num_watched; i++)
+        {
+            write_value(out, watched[i]);
+        }
+        out->write("\r\n");
+    }
+
+    /// @brief Gets the number of samples dropped since the watch started, because the previous
+    /// sample hadn't been written out in time.
+    /// @return Number of dropped samples.
+    ///
+    uint32_t overruns()
+    {
+        return missed;
+    }
+
+    /// @brief Checks if inputs are being watched.
+    /// @return True if watching.
+    ///
+    bool active()
+    {
+        return watching;
+    }
+
+    /// @brief Stops watching the inputs.
+    ///
+    void stop()
+    {
+        periodic::stop(periodic::ID::IOWatch);
+        watching = false;
+    }
+
+    /// @brief Starts sampling the given inputs at the given rate, replacing any current watch.
+    /// @param ids Inputs to watch.
+    /// @param count Number of inputs.
+    /// @param rate_hz Samples per second. The period is a whole number of milliseconds, so the rate
+    /// has to divide 1000 evenly.
+    /// @return False if the inputs or the rate are invalid, in which case nothing is started.
+    ///
+    bool start(const io::IOID *ids, uint32_t count, uint32_t rate_hz)
+    {
+        REQUIRE(ids != nullptr, error::InvalidPointer);
+
+        if ((count == 0) || (count > MAX_INPUTS) || (rate_hz == 0) || (rate_hz > MAX_RATE_HZ)
+            || ((MS_PER_S % rate_hz) != 0))
+        {
+            return false;
+        }
+
+        input::Input *inputs[MAX_INPUTS];
+        for (uint32_t i = 0; i < count; i++)
+        {
+            inputs[i] = input::get_by_id(ids[i]);
+            if (inputs[i] == nullptr)
+            {
+                return false;
+            }
+        }
+
+        stop();
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            watched[i] = inputs[i];
+        }
+
+        num_watched    = count;
+        missed         = 0;
+        sample_pending = false;
+        watching       = true;
+
+        periodic::create(periodic::ID::IOWatch, post_sample);
+        periodic::set_period(periodic::ID::IOWatch, MS_PER_S / rate_hz);
+        periodic::start(periodic::ID::IOWatch);
+
+        return true;
+    }
+
+    //----------------------------------------------------------------------------------------------
+    //  Class Function Definitions
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Class Operator Definitions
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Class Constructor Definitions
+    //----------------------------------------------------------------------------------------------
+
+
+    // End of Namespace
+}
+
+//--------------------------------------------------------------------------------------------------
+// Global Namespace Functions
+//--------------------------------------------------------------------------------------------------
+
+
+//--------------------------------------------------------------------------------------------------
+// Unit Test Accessors
+//--------------------------------------------------------------------------------------------------
+
+// End of File
@@ -51,8 +51,12 @@ void timer_disableInterrupt(uint8_t timerNr, uint8_t counterNr);
 
 void timer_clearInterrupt(uint8_t timerNr, uint8_t counterNr);
 
+int8_t timer_isInterruptPending(uint8_t timerNr, uint8_t counterNr);
+
 void timer_setLoad(uint8_t timerNr, uint8_t counterNr, uint32_t value);
 
+void timer_setBgLoad(uint8_t timerNr, uint8_t counterNr, uint32_t value);
+
 uint32_t timer_getValue(uint8_t timerNr, uint8_t counterNr);
 
 const volatile uint32_t* timer_getValueAddr(uint8_t timerNr, uint8_t counterNr);
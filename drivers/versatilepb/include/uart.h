@@ -60,6 +60,26 @@ void uart_disableRxInterrupt(uint8_t nr);
 
 void uart_clearRxInterrupt(uint8_t nr);
 
+void uart_enableTxInterrupt(uint8_t nr);
+
+void uart_disableTxInterrupt(uint8_t nr);
+
+int8_t uart_isTxFull(uint8_t nr);
+
+void uart_writeChar(uint8_t nr, char ch);
+
+void uart_enableFifos(uint8_t nr);
+
+void uart_setRxFifoLevel(uint8_t nr, uint8_t level);
+
+void uart_enableRxTimeoutInterrupt(uint8_t nr);
+
+void uart_disableRxTimeoutInterrupt(uint8_t nr);
+
+int8_t uart_isRxEmpty(uint8_t nr);
+
+int8_t uart_isTxInterruptPending(uint8_t nr);
+
 char uart_readChar(uint8_t nr);
 
 
@@ -35,6 +35,7 @@
 /* Variables */
 extern int __io_putchar(int ch) __attribute__((weak));
 extern int __io_getchar(void) __attribute__((weak));
+extern int __io_write(const char *ptr, int len) __attribute__((weak));
 
 
 char *__env[1] = { 0 };
@@ -77,9 +78,18 @@ int _read(int file, char *ptr, int len)
 int _write(int file, char *ptr, int len)
 {
   (void)file;
-  (void)ptr;
-  
-  uart_print(0, ptr);
+
+  /* Hand the buffer to the interrupt driven TX path once it's available */
+  if ((__io_write != NULL) && (__io_write(ptr, len) >= 0))
+  {
+    return len;
+  }
+
+  /* Otherwise poll it out. The buffer isn't '\0' terminated, so go by len */
+  for (int i = 0; i < len; i++)
+  {
+    uart_printChar(0, ptr[i]);
+  }
 
   return len;
 }
@@ -320,6 +320,32 @@ void timer_clearInterrupt(uint8_t timerNr, uint8_t counterNr)
 }
 
 
+/**
+ * Checks whether the specified counter has reached 0 and raised its interrupt
+ * since it was last cleared. The raw status is read, so the result does not
+ * depend on whether the counter's interrupt is enabled.
+ *
+ * If either 'timerNr' or 'counterNr' is invalid, a zero is returned.
+ *
+ * @param timerNr - timer number (between 0 and 1)
+ * @param counterNr - counter number of the selected timer (between 0 and 1)
+ *
+ * @return a nonzero value if the interrupt is pending, a zero otherwise
+ */
+int8_t timer_isInterruptPending(uint8_t timerNr, uint8_t counterNr)
+{
+
+    /* sanity check: */
+    if ( timerNr >= BSP_NR_TIMERS || counterNr >= NR_COUNTERS )
+    {
+        return 0;
+    }
+
+    /* Only bit 0 of the Raw Interrupt Status Register is used, see page 3-6 of DDI0271 */
+    return ( 0!=HWREG_READ_BITS( pReg[timerNr]->CNTR[counterNr].RIS, 0x00000001 ) );
+}
+
+
 /**
  * Sets the value of the specified counter's Load Register.
  *
@@ -347,6 +373,34 @@ void timer_setLoad(uint8_t timerNr, uint8_t counterNr, uint32_t value)
 }
 
 
+/**
+ * Sets the value of the specified counter's Background Load Register.
+ *
+ * Unlike timer_setLoad(), this does not reload the counter immediately. The
+ * counter keeps counting down from its current value and is only reloaded
+ * to this value the next time it reaches 0 in periodic mode.
+ *
+ * For more details, see page 3-7 of DDI0271.
+ *
+ * Nothing is done if either 'timerNr' or 'counterNr' is invalid.
+ *
+ * @param timerNr - timer number (between 0 and 1)
+ * @param counterNr - counter number of the selected timer (between 0 and 1)
+ * @param value - value to be loaded into the Background Load Register
+ */
+void timer_setBgLoad(uint8_t timerNr, uint8_t counterNr, uint32_t value)
+{
+
+    /* sanity check: */
+    if ( timerNr >= BSP_NR_TIMERS || counterNr >= NR_COUNTERS )
+    {
+        return;
+    }
+
+    pReg[timerNr]->CNTR[counterNr].BGLOAD = value;
+}
+
+
 /**
  * Returns the value of the specified counter's Value Register,
  * i.e. the value of the counter at the moment of reading.
@@ -134,6 +134,36 @@
 #define FR_RI          ( 0x00000100 )
 
 
+/*
+ * Bitmasks for the Line Control Register (UARTLCR_H).
+ *
+ * For a detailed description of each line control register's bit, see page 3-12 of the DDI0183.
+ *   0: BRK (send break)
+ *   1: PEN (parity enable)
+ *   2: EPS (even parity select)
+ *   3: STP2 (two stop bits select)
+ *   4: FEN (enable FIFOs): 0 FIFOs become 1-byte holding registers; 1 FIFOs enabled
+ * 5-6: WLEN (word length): 00 5 bits; 01 6 bits; 10 7 bits; 11 8 bits
+ *   7: SPS (stick parity select)
+ * 8-31: reserved, do not modify
+ */
+#define LCRH_FEN       ( 0x00000010 )
+
+
+/*
+ * Bitmasks and shift of the receive part of the Interrupt FIFO Level Select Register (UARTIFLS).
+ *
+ * For a detailed description of the register, see page 3-17 of the DDI0183.
+ * 0-2: TXIFLSEL (transmit interrupt FIFO level select)
+ * 3-5: RXIFLSEL (receive interrupt FIFO level select): 000 1/8 full; 001 1/4 full;
+ *      010 1/2 full; 011 3/4 full; 100 7/8 full
+ * 6-31: reserved, do not modify
+ */
+#define IFLS_RXIFLSEL  ( 0x00000038 )
+#define IFLS_RX_SHIFT  ( 3 )
+#define IFLS_MAX_LEVEL ( 4 )
+
+
 /*
  * 32-bit Registers of individual UART controllers,
  * relative to the controller's base address:
@@ -557,6 +587,219 @@ void uart_clearRxInterrupt(uint8_t nr)
 }
 
 
+/**
+ * Enables the interrupt triggering by the specified UART when its transmit
+ * FIFO (or holding register when FIFOs are disabled) has room for more characters.
+ *
+ * Nothing is done if 'nr' is invalid (equal or greater than 3).
+ *
+ * @param nr - number of the UART (between 0 and 2)
+ */
+void uart_enableTxInterrupt(uint8_t nr)
+{
+    /* Sanity check */
+    if ( nr >= BSP_NR_UARTS )
+    {
+        return;
+    }
+
+    /* Set bit 5 of the IMSC register: */
+    HWREG_SET_BITS( pReg[nr]->UARTIMSC, INT_TXIM );
+}
+
+
+/**
+ * Disables the interrupt triggering by the specified UART when its transmit
+ * FIFO has room for more characters.
+ *
+ * Nothing is done if 'nr' is invalid (equal or greater than 3).
+ *
+ * @param nr - number of the UART (between 0 and 2)
+ */
+void uart_disableTxInterrupt(uint8_t nr)
+{
+    /* Sanity check */
+    if ( nr >= BSP_NR_UARTS )
+    {
+        return;
+    }
+
+    /* Clear bit 5 of the IMSC register: */
+    HWREG_CLEAR_BITS( pReg[nr]->UARTIMSC, INT_TXIM );
+}
+
+
+/**
+ * Checks whether the specified UART's transmit FIFO is full.
+ *
+ * A non-zero value (i.e. "full") is returned if 'nr' is invalid (equal or greater than 3),
+ * so callers never attempt to write to a nonexistent controller.
+ *
+ * @param nr - number of the UART (between 0 and 2)
+ *
+ * @return 0 if another character can be written, non-zero otherwise
+ */
+int8_t uart_isTxFull(uint8_t nr)
+{
+    /* Sanity check */
+    if ( nr >= BSP_NR_UARTS )
+    {
+        return 1;
+    }
+
+    return ( 0 != HWREG_READ_BITS( pReg[nr]->UARTFR, FR_TXFF ) ? 1 : 0 );
+}
+
+
+/**
+ * Writes a character to the specified UART's transmit FIFO without polling
+ * the Flag Register. The caller must check uart_isTxFull() first, otherwise
+ * the character may be lost.
+ *
+ * Nothing is done if 'nr' is invalid (equal or greater than 3).
+ *
+ * @param nr - number of the UART (between 0 and 2)
+ * @param ch - character to be sent to the UART
+ */
+void uart_writeChar(uint8_t nr, char ch)
+{
+    /* Sanity check */
+    if ( nr >= BSP_NR_UARTS )
+    {
+        return;
+    }
+
+    /* See __printCh() for an explanation of the cast: */
+    *( (char*) &(pReg[nr]->UARTDR) ) = ch;
+}
+
+
+/**
+ * Enables the specified UART's transmit and receive FIFOs.
+ * Other line control settings remain unmodified.
+ *
+ * Nothing is done if 'nr' is invalid (equal or greater than 3).
+ *
+ * @param nr - number of the UART (between 0 and 2)
+ */
+void uart_enableFifos(uint8_t nr)
+{
+    /* Sanity check */
+    if ( nr >= BSP_NR_UARTS )
+    {
+        return;
+    }
+
+    HWREG_SET_BITS( pReg[nr]->UARTLC_H, LCRH_FEN );
+}
+
+
+/**
+ * Sets the receive FIFO fill level that triggers the receive interrupt.
+ * Characters below that level are reported by the receive timeout interrupt instead.
+ *
+ * Nothing is done if 'nr' is invalid (equal or greater than 3) or
+ * 'level' is invalid (greater than 4).
+ *
+ * @param nr - number of the UART (between 0 and 2)
+ * @param level - 0: 1/8 full; 1: 1/4 full; 2: 1/2 full; 3: 3/4 full; 4: 7/8 full
+ */
+void uart_setRxFifoLevel(uint8_t nr, uint8_t level)
+{
+    /* Sanity check */
+    if ( nr >= BSP_NR_UARTS || level > IFLS_MAX_LEVEL )
+    {
+        return;
+    }
+
+    HWREG_CLEAR_BITS( pReg[nr]->UARTIFLS, IFLS_RXIFLSEL );
+    HWREG_SET_BITS( pReg[nr]->UARTIFLS, ( (uint32_t) level << IFLS_RX_SHIFT ) & IFLS_RXIFLSEL );
+}
+
+
+/**
+ * Enables the interrupt triggering by the specified UART when the receive FIFO
+ * is not empty and no more characters have been received for 32 bit periods.
+ *
+ * Nothing is done if 'nr' is invalid (equal or greater than 3).
+ *
+ * @param nr - number of the UART (between 0 and 2)
+ */
+void uart_enableRxTimeoutInterrupt(uint8_t nr)
+{
+    /* Sanity check */
+    if ( nr >= BSP_NR_UARTS )
+    {
+        return;
+    }
+
+    /* Set bit 6 of the IMSC register: */
+    HWREG_SET_BITS( pReg[nr]->UARTIMSC, INT_RTIM );
+}
+
+
+/**
+ * Disables the receive timeout interrupt of the specified UART.
+ *
+ * Nothing is done if 'nr' is invalid (equal or greater than 3).
+ *
+ * @param nr - number of the UART (between 0 and 2)
+ */
+void uart_disableRxTimeoutInterrupt(uint8_t nr)
+{
+    /* Sanity check */
+    if ( nr >= BSP_NR_UARTS )
+    {
+        return;
+    }
+
+    /* Clear bit 6 of the IMSC register: */
+    HWREG_CLEAR_BITS( pReg[nr]->UARTIMSC, INT_RTIM );
+}
+
+
+/**
+ * Checks whether the specified UART's receive FIFO is empty.
+ *
+ * A non-zero value (i.e. "empty") is returned if 'nr' is invalid (equal or greater than 3).
+ *
+ * @param nr - number of the UART (between 0 and 2)
+ *
+ * @return 0 if at least one character can be read, non-zero otherwise
+ */
+int8_t uart_isRxEmpty(uint8_t nr)
+{
+    /* Sanity check */
+    if ( nr >= BSP_NR_UARTS )
+    {
+        return 1;
+    }
+
+    return ( 0 != HWREG_READ_BITS( pReg[nr]->UARTFR, FR_RXFE ) ? 1 : 0 );
+}
+
+
+/**
+ * Checks whether the specified UART's transmit interrupt is both enabled and asserted.
+ *
+ * A zero is returned if 'nr' is invalid (equal or greater than 3).
+ *
+ * @param nr - number of the UART (between 0 and 2)
+ *
+ * @return non-zero if the masked transmit interrupt is pending, 0 otherwise
+ */
+int8_t uart_isTxInterruptPending(uint8_t nr)
+{
+    /* Sanity check */
+    if ( nr >= BSP_NR_UARTS )
+    {
+        return 0;
+    }
+
+    return ( 0 != HWREG_READ_BITS( pReg[nr]->UARTMIS, INT_TXIM ) ? 1 : 0 );
+}
+
+
 /**
  * Reads a character that was received by the specified UART.
  * The function may block until a character appears in the UART's receive buffer.
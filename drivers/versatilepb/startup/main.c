@@ -11,12 +11,78 @@ _Bool __atomic_is_lock_free(unsigned int size, const volatile void *ptr)
     return true;
 }
 
+// The arm926ej-s has no exclusive load/store, so gcc calls out to these for atomic
+// read-modify-writes. Each one masks IRQs around the access, restoring whatever mask was in place
+// before, so they're safe from tasks and ISRs alike.
+static inline unsigned int atomic_lock(void)
+{
+    unsigned int cpsr;
+    unsigned int masked;
+    __asm__ volatile ("MRS %0, cpsr\n\t"
+                      "ORR %1, %0, #0x80\n\t" // Disable IRQ
+                      "MSR cpsr_c, %1"
+                      : "=&r"(cpsr), "=&r"(masked)
+                      :
+                      : "memory");
+    return cpsr;
+}
+
+static inline void atomic_unlock(unsigned int cpsr)
+{
+    __asm__ volatile ("MSR cpsr_c, %0" :: "r"(cpsr) : "memory");
+}
+
+// gcc declares the builtin with a weak flag, but drops it when it makes the library call
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wbuiltin-declaration-mismatch"
+_Bool __atomic_compare_exchange_4(volatile void *ptr,
+                                  void          *expected,
+                                  unsigned int   desired,
+                                  int            success_memorder,
+                                  int            failure_memorder)
+{
+    (void)success_memorder;
+    (void)failure_memorder;
+
+    unsigned int cpsr    = atomic_lock();
+    unsigned int current = *((volatile unsigned int *)ptr);
+    _Bool        swapped = (current == *((unsigned int *)expected));
+
+    if (swapped)
+    {
+        *((volatile unsigned int *)ptr) = desired;
+    }
+    else
+    {
+        *((unsigned int *)expected) = current;
+    }
+
+    atomic_unlock(cpsr);
+    return swapped;
+}
+#pragma GCC diagnostic pop
+
+unsigned int __atomic_exchange_4(volatile void *ptr, unsigned int val, int memorder)
+{
+    (void)memorder;
+
+    unsigned int cpsr     = atomic_lock();
+    unsigned int previous = *((volatile unsigned int *)ptr);
+    *((volatile unsigned int *)ptr) = val;
+
+    atomic_unlock(cpsr);
+    return previous;
+}
+
 unsigned int __atomic_fetch_add_4(volatile void *ptr, unsigned int val, int memorder)
 {
     (void)(memorder);
 
-    int tmp = *((volatile int *)ptr);
+    unsigned int cpsr = atomic_lock();
+    int          tmp  = *((volatile int *)ptr);
     *((volatile int *)ptr) += val;
+
+    atomic_unlock(cpsr);
     return tmp;
 }
 
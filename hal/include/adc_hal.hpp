@@ -80,6 +80,8 @@ namespace adc_hal
 
     void start_conversions();
 
+    bool has_conversions();
+
     error::Error read(adc::VirtualPort pin, uint16_t *val);
 
     uint32_t get_bit_width(adc::VirtualPort pin);
@@ -0,0 +1,93 @@
+/// @file alarm_hal.hpp
+/// @author Denver Hoggatt
+/// @brief Alarm HAL declarations
+///
+/// Copyright (c) 2025 Denver Hoggatt. All rights reserved.
+///
+/// This software is licensed under terms that can be found in the LICENSE file
+/// in the root directory of this software component.
+/// If no LICENSE file comes with this software, it is provided AS-IS.
+///
+
+#pragma once
+
+#include "hal.hpp"
+#include "error.hpp"
+
+#include <cstdint>
+
+//--------------------------------------------------------------------------------------------------
+//  Macros and Error Checking
+//--------------------------------------------------------------------------------------------------
+
+
+namespace alarm_hal
+{
+    //----------------------------------------------------------------------------------------------
+    //  Public Constants
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Public Data Types
+    //----------------------------------------------------------------------------------------------
+
+    typedef void (*AlarmFunc)();
+
+    //----------------------------------------------------------------------------------------------
+    //  Classes
+    //----------------------------------------------------------------------------------------------
+
+    /// @brief One-shot hardware timer that calls a function from its interrupt. It runs apart
+    /// from the RTOS tick and timer task, so the call isn't held up by either.
+    ///
+    class AlarmHAL : public hal::HAL
+    {
+        private:
+            // -----------------------------------------------------------------
+            //  Class Private Variables
+            // -----------------------------------------------------------------
+
+
+            // -----------------------------------------------------------------
+            //  Class Private Functions
+            // -----------------------------------------------------------------
+
+
+        public:
+            // -----------------------------------------------------------------
+            //  Class Public Variables
+            // -----------------------------------------------------------------
+
+
+            // -----------------------------------------------------------------
+            //  Class Public Functions
+            // -----------------------------------------------------------------
+
+            error::Error arm(uint32_t delay_us, AlarmFunc func);
+
+            void disarm();
+
+            void start();
+
+            // End of Class
+    };
+
+    //----------------------------------------------------------------------------------------------
+    //  Public Functions
+    //----------------------------------------------------------------------------------------------
+
+    error::Error arm(uint32_t delay_us, AlarmFunc func);
+
+    void disarm();
+
+    void init();
+
+#define DEF_PLAT(plat_name) AlarmHAL *plat_name##_get_funcs();
+#include "platforms.def"
+#undef DEF_PLAT
+
+    // End of Namespace
+}
+
+// End of File
@@ -0,0 +1,91 @@
+/// @file clock_hal.hpp
+/// @author Denver Hoggatt
+/// @brief Clock HAL declarations
+///
+/// Copyright (c) 2025 Denver Hoggatt. All rights reserved.
+///
+/// This software is licensed under terms that can be found in the LICENSE file
+/// in the root directory of this software component.
+/// If no LICENSE file comes with this software, it is provided AS-IS.
+///
+
+#pragma once
+
+#include "hal.hpp"
+
+#include <cstdint>
+
+//--------------------------------------------------------------------------------------------------
+//  Macros and Error Checking
+//--------------------------------------------------------------------------------------------------
+
+
+namespace clock_hal
+{
+    //----------------------------------------------------------------------------------------------
+    //  Public Constants
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Public Data Types
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Classes
+    //----------------------------------------------------------------------------------------------
+
+    /// @brief Free-running 32-bit counter, counting up at rate_hz() and wrapping at 2^32. It's
+    /// started by init() and never stopped, so it can be used as a monotonic time base.
+    ///
+    class ClockHAL : public hal::HAL
+    {
+        private:
+            // -----------------------------------------------------------------
+            //  Class Private Variables
+            // -----------------------------------------------------------------
+
+
+            // -----------------------------------------------------------------
+            //  Class Private Functions
+            // -----------------------------------------------------------------
+
+
+        public:
+            // -----------------------------------------------------------------
+            //  Class Public Variables
+            // -----------------------------------------------------------------
+
+
+            // -----------------------------------------------------------------
+            //  Class Public Functions
+            // -----------------------------------------------------------------
+
+            uint32_t ticks();
+
+            uint32_t rate_hz();
+
+            void start();
+
+            // End of Class
+    };
+
+    //----------------------------------------------------------------------------------------------
+    //  Public Functions
+    //----------------------------------------------------------------------------------------------
+
+    uint32_t ticks();
+
+    uint32_t rate_hz();
+
+    void init();
+
+#define DEF_PLAT(plat_name) ClockHAL *plat_name##_get_funcs();
+#include "platforms.def"
+#undef DEF_PLAT
+
+    // End of Namespace
+}
+
+// End of File
\ No newline at end of file
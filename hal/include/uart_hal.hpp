@@ -58,6 +58,8 @@ namespace uart_hal
 
             error::Error send(void *handle, const char *send_str);
 
+            error::Error transmit(void *handle);
+
             error::Error open(void *handle);
 
             // End of Class
@@ -69,8 +71,12 @@ namespace uart_hal
 
     error::Error send(uart::VirtualPort id, const char *send_str);
 
+    error::Error transmit(uart::VirtualPort id);
+
     error::Error open(uart::VirtualPort id);
 
+    uart::VirtualPort get_port(void *handle);
+
     void init();
 
 #define DEF_PLAT(plat_name) UARTHAL *plat_name##_get_funcs();
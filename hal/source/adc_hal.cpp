@@ -76,6 +76,30 @@ namespace adc_hal
         adc_funcs[hal::platform()]->start_conversion();
     }
 
+    /// @brief Checks if the platform has any ADC conversions to start, i.e. it has an ADC HAL and
+    /// at least one ADC pin. If not, there's no need to wake up to start them.
+    /// @return True if start_conversions() does anything.
+    ///
+    bool has_conversions()
+    {
+        uint32_t plat = hal::platform();
+
+        if (adc_funcs[plat] == nullptr)
+        {
+            return false;
+        }
+
+        for (uint32_t i = 0; i < (uint32_t)adc::VirtualPort::NumPorts; i++)
+        {
+            if (adc_pins[plat][i] != UINT_MAX)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
     /// @brief Gets the ADC reference voltage
     /// @return Reference voltage
     ///
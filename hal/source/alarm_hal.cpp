@@ -0,0 +1,135 @@
+/// @file alarm_hal.cpp
+/// @author Denver Hoggatt
+/// @brief Alarm HAL definitions
+///
+/// Copyright (c) 2025 Denver Hoggatt. All rights reserved.
+///
+/// This software is licensed under terms that can be found in the LICENSE file
+/// in the root directory of this software component.
+/// If no LICENSE file comes with this software, it is provided AS-IS.
+///
+
+#include "hal.hpp"
+#include "alarm_hal.hpp"
+
+#include <cstdint>
+
+//--------------------------------------------------------------------------------------------------
+//  Macros and Error Checking
+//--------------------------------------------------------------------------------------------------
+
+namespace
+{
+    //----------------------------------------------------------------------------------------------
+    //  Private Constants
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Private Data Types
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Private Function Prototypes
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  File Variables
+    //----------------------------------------------------------------------------------------------
+
+    alarm_hal::AlarmHAL *alarm_hals[(uint32_t)hal::Platform::NumPlatforms];
+
+    //----------------------------------------------------------------------------------------------
+    //  Private Functions
+    //----------------------------------------------------------------------------------------------
+
+
+    // End of Anonymous Namespace
+}
+
+namespace alarm_hal
+{
+    //----------------------------------------------------------------------------------------------
+    //  Public Functions
+    //----------------------------------------------------------------------------------------------
+
+    /// @brief Arms the alarm, replacing any alarm already set. Safe to call from the alarm's own
+    /// function, to set the next one.
+    /// @param delay_us Time from now until the function is called.
+    /// @param func Function to call, from an interrupt.
+    /// @return Error if the platform has no alarm.
+    ///
+    error::Error arm(uint32_t delay_us, AlarmFunc func)
+    {
+        if (alarm_hals[hal::platform()] == nullptr)
+        {
+            return error::DeviceNotFound;
+        }
+
+        return alarm_hals[hal::platform()]->arm(delay_us, func);
+    }
+
+    /// @brief Cancels the alarm, if one is set.
+    ///
+    void disarm()
+    {
+        if (alarm_hals[hal::platform()] == nullptr)
+        {
+            return;
+        }
+
+        alarm_hals[hal::platform()]->disarm();
+    }
+
+    /// @brief Initializes the alarm HAL. This has to run before interrupts are enabled, as the
+    /// alarm's interrupt is registered here.
+    ///
+    void init()
+    {
+#define DEF_PLAT(plat_name) \
+    alarm_hals[(uint32_t)hal::Platform::plat_name] = plat_name##_get_funcs();
+#include "platforms.def"
+#undef DEF_PLAT
+
+        if (alarm_hals[hal::platform()] != nullptr)
+        {
+            alarm_hals[hal::platform()]->start();
+        }
+    }
+
+    //----------------------------------------------------------------------------------------------
+    //  Class Function Definitions
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Class Operator Definitions
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Class Constructor Definitions
+    //----------------------------------------------------------------------------------------------
+
+
+    // End of Namespace
+}
+
+//--------------------------------------------------------------------------------------------------
+// Global Namespace Functions
+//--------------------------------------------------------------------------------------------------
+
+
+//--------------------------------------------------------------------------------------------------
+// Unit Test Accessors
+//--------------------------------------------------------------------------------------------------
+
+namespace alarm_hal_test
+{
+
+
+}
+
+// End of File
@@ -0,0 +1,153 @@
+/// @file clock_hal.cpp
+/// @author Denver Hoggatt
+/// @brief Clock HAL definitions
+///
+/// Copyright (c) 2025 Denver Hoggatt. All rights reserved.
+///
+/// This software is licensed under terms that can be found in the LICENSE file
+/// in the root directory of this software component.
+/// If no LICENSE file comes with this software, it is provided AS-IS.
+///
+
+#include "hal.hpp"
+#include "clock_hal.hpp"
+
+#include <cstdint>
+
+#if defined(TESTING)
+    #include <ctime>
+#endif
+
+//--------------------------------------------------------------------------------------------------
+//  Macros and Error Checking
+//--------------------------------------------------------------------------------------------------
+
+namespace
+{
+    //----------------------------------------------------------------------------------------------
+    //  Private Constants
+    //----------------------------------------------------------------------------------------------
+
+    constexpr uint32_t HOST_RATE_HZ = 1000000; // Host builds count microseconds
+    constexpr uint32_t NS_PER_US    = 1000;
+    constexpr uint32_t US_PER_S     = 1000000;
+
+    //----------------------------------------------------------------------------------------------
+    //  Private Data Types
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Private Function Prototypes
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  File Variables
+    //----------------------------------------------------------------------------------------------
+
+    clock_hal::ClockHAL *clock_hals[(uint32_t)hal::Platform::NumPlatforms];
+
+    //----------------------------------------------------------------------------------------------
+    //  Private Functions
+    //----------------------------------------------------------------------------------------------
+
+    /// @brief Counter for builds without a platform clock. On the host this is the monotonic
+    /// clock of the OS, elsewhere time stands still.
+    ///
+    uint32_t host_ticks()
+    {
+#if defined(TESTING)
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+
+        return (uint32_t)(((uint64_t)now.tv_sec * US_PER_S) + ((uint64_t)now.tv_nsec / NS_PER_US));
+#else
+        return 0;
+#endif
+    }
+
+    // End of Anonymous Namespace
+}
+
+namespace clock_hal
+{
+    //----------------------------------------------------------------------------------------------
+    //  Public Functions
+    //----------------------------------------------------------------------------------------------
+
+    /// @brief Reads the free-running counter.
+    /// @return Current count.
+    ///
+    uint32_t ticks()
+    {
+        if (clock_hals[hal::platform()] == nullptr)
+        {
+            return host_ticks();
+        }
+
+        return clock_hals[hal::platform()]->ticks();
+    }
+
+    /// @brief Gets the rate the counter counts at.
+    /// @return Counts per second.
+    ///
+    uint32_t rate_hz()
+    {
+        if (clock_hals[hal::platform()] == nullptr)
+        {
+            return HOST_RATE_HZ;
+        }
+
+        return clock_hals[hal::platform()]->rate_hz();
+    }
+
+    /// @brief Initializes the clock HAL, starting the counter.
+    ///
+    void init()
+    {
+#define DEF_PLAT(plat_name) \
+    clock_hals[(uint32_t)hal::Platform::plat_name] = plat_name##_get_funcs();
+#include "platforms.def"
+#undef DEF_PLAT
+
+        if (clock_hals[hal::platform()] != nullptr)
+        {
+            clock_hals[hal::platform()]->start();
+        }
+    }
+
+    //----------------------------------------------------------------------------------------------
+    //  Class Function Definitions
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Class Operator Definitions
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Class Constructor Definitions
+    //----------------------------------------------------------------------------------------------
+
+
+    // End of Namespace
+}
+
+//--------------------------------------------------------------------------------------------------
+// Global Namespace Functions
+//--------------------------------------------------------------------------------------------------
+
+
+//--------------------------------------------------------------------------------------------------
+// Unit Test Accessors
+//--------------------------------------------------------------------------------------------------
+
+namespace clock_hal_test
+{
+
+
+}
+
+// End of File
@@ -11,6 +11,7 @@
 
 #include "hal.hpp"
 #include "gpio_hal.hpp"
+#include "profile.hpp"
 #include "io.hpp"
 #include "macros.hpp"
 
@@ -70,6 +71,8 @@ namespace gpio_hal
 
     error::Error set(gpio::VirtualPort pin)
     {
+        PROFILE_ZONE(GPIOWrite);
+
         UNUSED(pin);
 
         uint32_t plat = hal::platform();
@@ -96,6 +99,8 @@ namespace gpio_hal
 
     error::Error reset(gpio::VirtualPort pin)
     {
+        PROFILE_ZONE(GPIOWrite);
+
         UNUSED(pin);
 
         uint32_t plat = hal::platform();
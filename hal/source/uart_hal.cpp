@@ -10,6 +10,7 @@
 ///
 
 #include "uart_hal.hpp"
+#include "profile.hpp"
 #include "macros.hpp"
 
 #include <cstring>
@@ -64,6 +65,8 @@ namespace uart_hal
 
     error::Error send(uart::VirtualPort id, const char *send_str)
     {
+        PROFILE_ZONE(UARTSend);
+
         uint32_t plat = hal::platform();
         if (uart_hals[plat] == nullptr)
         {
@@ -84,6 +87,33 @@ namespace uart_hal
         return ret_val;
     }
 
+    error::Error transmit(uart::VirtualPort id)
+    {
+        uint32_t plat = hal::platform();
+        if (uart_hals[plat] == nullptr)
+        {
+            char discard; // Nothing to drain into, don't let the queue fill
+            while ((id < uart::VirtualPort::NumPorts) && uart::isr_transmit(id, &discard))
+            {
+            }
+
+            return error::NoError;
+        }
+
+        error::Error ret_val = error::InvalidPointer;
+
+        if (id >= uart::VirtualPort::NumPorts)
+        {
+            ret_val = error::InvalidID;
+        }
+        else
+        {
+            ret_val = uart_hals[plat]->transmit(uart_handles[plat][(uint32_t)id]);
+        }
+
+        return ret_val;
+    }
+
     error::Error open(uart::VirtualPort id)
     {
         uint32_t plat = hal::platform();
@@ -106,6 +136,25 @@ namespace uart_hal
         return ret_val;
     }
 
+    /// @brief Finds the port a platform handle was assigned to.
+    /// @param handle Handle from the platform definition.
+    /// @return Port using the handle, UART_NONE if no port does.
+    ///
+    uart::VirtualPort get_port(void *handle)
+    {
+        uint32_t plat = hal::platform();
+
+        for (uint32_t i = 0; i < (uint32_t)uart::VirtualPort::NumPorts; i++)
+        {
+            if ((handle != nullptr) && (uart_handles[plat][i] == handle))
+            {
+                return (uart::VirtualPort)i;
+            }
+        }
+
+        return uart::VirtualPort::UART_NONE;
+    }
+
     void init()
     {
         memset(uart_handles, 0, sizeof(uart_handles));
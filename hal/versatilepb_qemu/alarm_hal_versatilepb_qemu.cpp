@@ -0,0 +1,158 @@
+/// @file alarm_hal_versatilepb_qemu.cpp
+/// @author Denver Hoggatt
+/// @brief Alarm HAL for the versatilepb_qemu board
+///
+/// Copyright (c) 2025 Denver Hoggatt. All rights reserved.
+///
+/// This software is licensed under terms that can be found in the LICENSE file
+/// in the root directory of this software component.
+/// If no LICENSE file comes with this software, it is provided AS-IS.
+///
+
+#include "alarm_hal.hpp"
+
+extern "C"
+{
+#include "timer.h"
+#include "interrupt.h"
+#include "bsp.h"
+}
+
+#include <cstdint>
+
+//--------------------------------------------------------------------------------------------------
+//  Macros and Error Checking
+//--------------------------------------------------------------------------------------------------
+
+namespace
+{
+    //----------------------------------------------------------------------------------------------
+    //  Private Constants
+    //----------------------------------------------------------------------------------------------
+
+    // The first counter of timer 1 is the clock (see clock_hal_versatilepb_qemu.cpp), which never
+    // raises its interrupt, so the shared IRQ only ever comes from the alarm.
+    constexpr uint8_t ALARM_TIMER   = 1;
+    constexpr uint8_t ALARM_COUNTER = 1;
+
+    constexpr uint32_t MIN_LOAD = 1; // Counts at 1MHz, so the load is the delay in microseconds
+
+    //----------------------------------------------------------------------------------------------
+    //  Private Data Types
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Private Function Prototypes
+    //----------------------------------------------------------------------------------------------
+
+    void alarm_isr();
+
+    //----------------------------------------------------------------------------------------------
+    //  File Variables
+    //----------------------------------------------------------------------------------------------
+
+    alarm_hal::AlarmHAL hal_instance;
+
+    volatile alarm_hal::AlarmFunc alarm_func = nullptr;
+
+    //----------------------------------------------------------------------------------------------
+    //  Private Functions
+    //----------------------------------------------------------------------------------------------
+
+    /// @brief Alarm interrupt handler. The counter is periodic, so it's stopped before the alarm's
+    /// function runs, which then arms it again if it wants another call.
+    ///
+    void alarm_isr()
+    {
+        timer_stop(ALARM_TIMER, ALARM_COUNTER);
+        timer_clearInterrupt(ALARM_TIMER, ALARM_COUNTER);
+
+        alarm_hal::AlarmFunc func = alarm_func;
+        if (func != nullptr)
+        {
+            func();
+        }
+    }
+
+    // End of Anonymous Namespace
+}
+
+namespace alarm_hal
+{
+    //----------------------------------------------------------------------------------------------
+    //  Public Functions
+    //----------------------------------------------------------------------------------------------
+
+    AlarmHAL *versatilepb_qemu_get_funcs()
+    {
+        return &hal_instance;
+    }
+
+    //----------------------------------------------------------------------------------------------
+    //  Class Function Definitions
+    //----------------------------------------------------------------------------------------------
+
+    /// @brief Loads the counter with the delay and starts it. Writing the load register restarts
+    /// the count, so this also moves an alarm that's already set.
+    ///
+    error::Error AlarmHAL::arm(uint32_t delay_us, AlarmFunc func)
+    {
+        timer_stop(ALARM_TIMER, ALARM_COUNTER);
+
+        alarm_func = func;
+
+        timer_setLoad(ALARM_TIMER, ALARM_COUNTER, (delay_us < MIN_LOAD) ? MIN_LOAD : delay_us);
+        timer_start(ALARM_TIMER, ALARM_COUNTER);
+
+        return error::NoError;
+    }
+
+    void AlarmHAL::disarm()
+    {
+        timer_stop(ALARM_TIMER, ALARM_COUNTER);
+        timer_clearInterrupt(ALARM_TIMER, ALARM_COUNTER);
+    }
+
+    /// @brief Sets up the counter and registers its interrupt, leaving it stopped until armed.
+    ///
+    void AlarmHAL::start()
+    {
+        const uint8_t irqs[BSP_NR_TIMERS] = BSP_TIMER_IRQS;
+
+        timer_init(ALARM_TIMER, ALARM_COUNTER);
+        timer_enableInterrupt(ALARM_TIMER, ALARM_COUNTER);
+
+        pic_registerIrq(irqs[ALARM_TIMER], alarm_isr, PIC_MAX_PRIORITY - 1);
+        pic_enableInterrupt(irqs[ALARM_TIMER]);
+    }
+
+    //----------------------------------------------------------------------------------------------
+    //  Class Operator Definitions
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Class Constructor Definitions
+    //----------------------------------------------------------------------------------------------
+
+
+    // End of Namespace
+}
+
+//--------------------------------------------------------------------------------------------------
+// Global Namespace Functions
+//--------------------------------------------------------------------------------------------------
+
+
+//--------------------------------------------------------------------------------------------------
+// Unit Test Accessors
+//--------------------------------------------------------------------------------------------------
+
+namespace alarm_hal_test
+{
+
+
+}
+
+// End of File
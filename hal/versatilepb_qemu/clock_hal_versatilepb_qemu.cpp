@@ -0,0 +1,144 @@
+/// @file clock_hal_versatilepb.cpp
+/// @author Denver Hoggatt
+/// @brief Clock HAL for the versatilepb_qemu board
+///
+/// Copyright (c) 2025 Denver Hoggatt. All rights reserved.
+///
+/// This software is licensed under terms that can be found in the LICENSE file
+/// in the root directory of this software component.
+/// If no LICENSE file comes with this software, it is provided AS-IS.
+///
+
+#include "clock_hal.hpp"
+
+extern "C"
+{
+#include "timer.h"
+}
+
+#include <cstdint>
+
+//--------------------------------------------------------------------------------------------------
+//  Macros and Error Checking
+//--------------------------------------------------------------------------------------------------
+
+namespace
+{
+    //----------------------------------------------------------------------------------------------
+    //  Private Constants
+    //----------------------------------------------------------------------------------------------
+
+    // Timer 0 is used for the RTOS tick (see tick_timer_settings.h), so the clock gets the first
+    // counter of timer 1. Its interrupt is never enabled.
+    constexpr uint8_t CLOCK_TIMER   = 1;
+    constexpr uint8_t CLOCK_COUNTER = 0;
+
+    constexpr uint32_t TIMCLK_HZ = 1000000; // SP804 reference clock on the versatilepb
+
+    constexpr uint32_t MAX_COUNT = 0xFFFFFFFF;
+
+    //----------------------------------------------------------------------------------------------
+    //  Private Data Types
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Private Function Prototypes
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  File Variables
+    //----------------------------------------------------------------------------------------------
+
+    clock_hal::ClockHAL hal_instance;
+
+    const volatile uint32_t *counter = nullptr; // Value register of the counter
+
+    //----------------------------------------------------------------------------------------------
+    //  Private Functions
+    //----------------------------------------------------------------------------------------------
+
+
+    // End of Anonymous Namespace
+}
+
+namespace clock_hal
+{
+    //----------------------------------------------------------------------------------------------
+    //  Public Functions
+    //----------------------------------------------------------------------------------------------
+
+    ClockHAL *versatilepb_qemu_get_funcs()
+    {
+        return &hal_instance;
+    }
+
+    //----------------------------------------------------------------------------------------------
+    //  Class Function Definitions
+    //----------------------------------------------------------------------------------------------
+
+    /// @brief Reads the counter. The SP804 counts down, so the count is inverted to count up.
+    ///
+    uint32_t ClockHAL::ticks()
+    {
+        if (counter == nullptr)
+        {
+            return 0;
+        }
+
+        return MAX_COUNT - *counter;
+    }
+
+    uint32_t ClockHAL::rate_hz()
+    {
+        return TIMCLK_HZ;
+    }
+
+    /// @brief Starts the counter, running from MAX_COUNT down and reloading it at zero, which
+    /// makes it a free-running 32-bit counter.
+    ///
+    void ClockHAL::start()
+    {
+        timer_init(CLOCK_TIMER, CLOCK_COUNTER);
+        timer_setLoad(CLOCK_TIMER, CLOCK_COUNTER, MAX_COUNT);
+        timer_start(CLOCK_TIMER, CLOCK_COUNTER);
+
+        counter = timer_getValueAddr(CLOCK_TIMER, CLOCK_COUNTER);
+    }
+
+    //----------------------------------------------------------------------------------------------
+    //  Class Operator Definitions
+    //----------------------------------------------------------------------------------------------
+
+
+    //----------------------------------------------------------------------------------------------
+    //  Class Constructor Definitions
+    //----------------------------------------------------------------------------------------------
+
+
+    // End of Namespace
+}
+
+//--------------------------------------------------------------------------------------------------
+// Global Namespace Functions
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Run time stats counter for FreeRTOS (see FreeRTOSConfig.h).
+///
+extern "C" uint32_t ulGetRunTimeCounterValue(void)
+{
+    return hal_instance.ticks();
+}
+
+//--------------------------------------------------------------------------------------------------
+// Unit Test Accessors
+//--------------------------------------------------------------------------------------------------
+
+namespace clock_hal_test
+{
+
+
+}
+
+// End of File
@@ -21,6 +21,9 @@ namespace
     //  Private Constants
     //----------------------------------------------------------------------------------------------
 
+    constexpr uint32_t CPSR_MODE_MASK = 0x1F;
+    constexpr uint32_t CPSR_MODE_IRQ  = 0x12;
+
 
     //----------------------------------------------------------------------------------------------
     //  Private Data Types
@@ -63,7 +66,10 @@ namespace isr_hal
 
     bool ISRHAL::is_in_interrupt()
     {
-        return false;
+        uint32_t cpsr;
+        __asm volatile("MRS %0, cpsr" : "=r"(cpsr)); // IRQs are serviced in IRQ mode
+
+        return (cpsr & CPSR_MODE_MASK) == CPSR_MODE_IRQ;
     }
 
     //----------------------------------------------------------------------------------------------
@@ -15,6 +15,8 @@
 extern "C"
 {
 #include "uart.h"
+#include "interrupt.h"
+#include "bsp.h"
 }
 
 #include <cstdio>
@@ -29,6 +31,12 @@ namespace
     //  Private Constants
     //----------------------------------------------------------------------------------------------
 
+    constexpr uint32_t RX_FIFO_DEPTH = 16;
+    constexpr uint8_t  RX_FIFO_LEVEL = 2; // Interrupt at 1/2 full, the rest is caught by RTIM
+
+#define UART_BASE(ADDR) (uintptr_t)(ADDR),
+    constexpr uintptr_t UART_BASES[BSP_NR_UARTS] = { BSP_UART_BASE_ADDRESSES(UART_BASE) };
+#undef UART_BASE
 
     //----------------------------------------------------------------------------------------------
     //  Private Data Types
@@ -39,6 +47,19 @@ namespace
     //  Private Function Prototypes
     //----------------------------------------------------------------------------------------------
 
+    int32_t get_uart_nr(void *handle);
+
+    void fill_tx_fifo(uint8_t nr);
+
+    void drain_rx_fifo(uint8_t nr);
+
+    void service_uart(uint8_t nr);
+
+    void uart0_isr();
+
+    void uart1_isr();
+
+    void uart2_isr();
 
     //----------------------------------------------------------------------------------------------
     //  File Variables
@@ -46,10 +67,109 @@ namespace
 
     uart_hal::UARTHAL hal_instance;
 
+    uart::VirtualPort uart_ports[BSP_NR_UARTS];
+
+    const pVectoredIsrPrototype uart_isrs[BSP_NR_UARTS] = { &uart0_isr, &uart1_isr, &uart2_isr };
+
     //----------------------------------------------------------------------------------------------
     //  Private Functions
     //----------------------------------------------------------------------------------------------
 
+    /// @brief Gets the UART number from a platform handle (the UART's base address).
+    /// @param handle Handle from the platform definition.
+    /// @return UART number, or -1 if the handle isn't a UART.
+    ///
+    int32_t get_uart_nr(void *handle)
+    {
+        for (uint32_t i = 0; i < BSP_NR_UARTS; i++)
+        {
+            if ((uintptr_t)handle == UART_BASES[i])
+            {
+                return (int32_t)i;
+            }
+        }
+
+        return -1;
+    }
+
+    /// @brief Moves characters from the TX queue into the TX FIFO until one of them is full/empty.
+    /// The TX interrupt is left enabled only while there is still queued data. Must not be
+    /// preempted by the UART ISR (i.e. called from the ISR, or with the TX interrupt masked), and
+    /// tasks have to take turns (uart.cpp only calls transmit() with the port's TX mutex held).
+    /// @param nr UART number.
+    ///
+    void fill_tx_fifo(uint8_t nr)
+    {
+        char c;
+        while (!uart_isTxFull(nr))
+        {
+            if (!uart::isr_transmit(uart_ports[nr], &c))
+            {
+                uart_disableTxInterrupt(nr);
+                return;
+            }
+
+            uart_writeChar(nr, c);
+        }
+
+        uart_enableTxInterrupt(nr);
+    }
+
+    /// @brief Moves the contents of the RX FIFO into the receive queue in one batch. Reading the
+    /// FIFO below its trigger level clears the RX/RT interrupts, anything that arrives past one
+    /// FIFO's worth re-asserts them and is picked up by the next interrupt.
+    /// @param nr UART number.
+    ///
+    void drain_rx_fifo(uint8_t nr)
+    {
+        char     rx_buf[RX_FIFO_DEPTH];
+        uint32_t len = 0;
+
+        while ((len < RX_FIFO_DEPTH) && !uart_isRxEmpty(nr))
+        {
+            rx_buf[len++] = uart_readChar(nr);
+        }
+
+        if (len > 0)
+        {
+            uart::isr_read(uart_ports[nr], rx_buf, len);
+        }
+    }
+
+    /// @brief Services both directions of a UART. The TX FIFO is only refilled if the TX interrupt
+    /// is what fired (otherwise a task may be priming it).
+    /// @param nr UART number.
+    ///
+    void service_uart(uint8_t nr)
+    {
+        drain_rx_fifo(nr);
+
+        if (uart_isTxInterruptPending(nr))
+        {
+            fill_tx_fifo(nr);
+        }
+    }
+
+    /// @brief UART0 interrupt handler.
+    ///
+    void uart0_isr()
+    {
+        service_uart(0);
+    }
+
+    /// @brief UART1 interrupt handler.
+    ///
+    void uart1_isr()
+    {
+        service_uart(1);
+    }
+
+    /// @brief UART2 interrupt handler.
+    ///
+    void uart2_isr()
+    {
+        service_uart(2);
+    }
 
     // End of Anonymous Namespace
 }
@@ -71,19 +191,60 @@ namespace uart_hal
 
     error::Error UARTHAL::send(void *handle, const char *send_str)
     {
-        UNUSED(handle);
-        UNUSED(send_str);
+        int32_t nr = get_uart_nr(handle);
+        if (nr < 0)
+        {
+            return error::InvalidID;
+        }
+
+        uart_print((uint8_t)nr, send_str);
+
+        return error::NoError;
+    }
+
+    error::Error UARTHAL::transmit(void *handle)
+    {
+        int32_t nr = get_uart_nr(handle);
+        if (nr < 0)
+        {
+            return error::InvalidID;
+        }
 
-        uart_print(0, send_str);
+        uart_disableTxInterrupt((uint8_t)nr); // Keep the ISR out while priming the FIFO
+        fill_tx_fifo((uint8_t)nr);
 
         return error::NoError;
     }
 
     error::Error UARTHAL::open(void *handle)
     {
-        UNUSED(handle);
+        int32_t nr = get_uart_nr(handle);
+        if (nr < 0)
+        {
+            return error::InvalidID;
+        }
+
+        const uint8_t irqs[BSP_NR_UARTS] = BSP_UART_IRQS;
+
+        uart_ports[nr] = get_port(handle);
+
+        uart_init((uint8_t)nr);
+        uart_enableFifos((uint8_t)nr);
+        uart_setRxFifoLevel((uint8_t)nr, RX_FIFO_LEVEL);
+        uart_enableRx((uint8_t)nr);
+        uart_enableRxInterrupt((uint8_t)nr);
+        uart_enableRxTimeoutInterrupt((uint8_t)nr);
+
+        irq_disableIrqMode(); // The VIC must not be serviced while its vectors are re-sorted
+        int8_t pos = pic_registerIrq(irqs[nr], uart_isrs[nr], PIC_MAX_PRIORITY - 1);
+        irq_enableIrqMode();
+
+        if (pos < 0)
+        {
+            return error::DeviceInitFailed;
+        }
 
-        uart_init(0);
+        pic_enableInterrupt(irqs[nr]);
 
         return error::NoError;
     }
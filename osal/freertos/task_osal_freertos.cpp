@@ -30,6 +30,9 @@ namespace
 
     constexpr uint8_t WATERMARK = 0xAA;
 
+    // Tasks from tasks.def, plus the idle and timer tasks of the RTOS
+    constexpr uint32_t MAX_RTOS_TASKS = (uint32_t)task::ID::NumIDs + 2;
+
     //----------------------------------------------------------------------------------------------
     //  Private Data Types
     //----------------------------------------------------------------------------------------------
@@ -61,6 +64,9 @@ namespace
 
     task_osal::TaskOSAL osal_instance;
 
+    // Times each task has been switched in, by TCB number (these start at 1)
+    volatile uint32_t switch_counts[MAX_RTOS_TASKS + 1];
+
     //----------------------------------------------------------------------------------------------
     //  Private Functions
     //----------------------------------------------------------------------------------------------
@@ -105,6 +111,38 @@ namespace task_osal
         return ret_val;
     }
 
+    uint32_t TaskOSAL::get_run_stats(RunStats *stats, uint32_t max_stats, uint32_t *total_time)
+    {
+        TaskStatus_t status[MAX_RTOS_TASKS];
+
+        uint32_t total = 0;
+        uint32_t num   = uxTaskGetSystemState(status, MAX_RTOS_TASKS, &total);
+
+        num = (num < max_stats) ? num : max_stats;
+        for (uint32_t i = 0; i < num; i++)
+        {
+            uint32_t number = status[i].xTaskNumber;
+
+            stats[i].number   = number;
+            stats[i].name     = status[i].pcTaskName;
+            stats[i].run_time = status[i].ulRunTimeCounter;
+            stats[i].switches = (number <= MAX_RTOS_TASKS) ? switch_counts[number] : 0;
+        }
+
+        *total_time = total;
+
+        return num;
+    }
+
+    uint32_t TaskOSAL::get_idle_wakes()
+    {
+#if (configUSE_TICKLESS_IDLE == 1)
+        return ulPortGetIdleWakeCount();
+#else
+        return 0;
+#endif
+    }
+
     void TaskOSAL::send_signal(void *handle, uint32_t signal)
     {
         if (isr_hal::is_in_interrupt())
@@ -170,6 +208,16 @@ namespace task_osal
 // Global Namespace Functions
 //--------------------------------------------------------------------------------------------------
 
+/// @brief Counts a task being switched in. Called by the scheduler on every context switch (see
+/// traceTASK_SWITCHED_IN in FreeRTOSConfig.h), so it has to stay short.
+///
+extern "C" void vTaskSwitchedIn(uint32_t ulTaskNumber)
+{
+    if (ulTaskNumber <= MAX_RTOS_TASKS)
+    {
+        switch_counts[ulTaskNumber] = switch_counts[ulTaskNumber] + 1;
+    }
+}
 
 //--------------------------------------------------------------------------------------------------
 // Unit Test Accessors
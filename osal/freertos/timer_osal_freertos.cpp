@@ -28,6 +28,8 @@ namespace
     //  Private Constants
     //----------------------------------------------------------------------------------------------
 
+    constexpr uint64_t MS_PER_S = 1000;
+    constexpr uint64_t US_PER_S = 1000000;
 
     //----------------------------------------------------------------------------------------------
     //  Private Data Types
@@ -84,7 +86,26 @@ namespace timer_osal
 
     uint32_t TimerOSAL::curr_time_ms()
     {
-        return (xTaskGetTickCount() / configTICK_RATE_HZ) * 1000;
+        return (uint32_t)(((uint64_t)xTaskGetTickCount() * MS_PER_S) / configTICK_RATE_HZ);
+    }
+
+    uint32_t TimerOSAL::tick_us()
+    {
+        return (uint32_t)(US_PER_S / configTICK_RATE_HZ);
+    }
+
+    /// @brief Blocks the calling task. vTaskDelay() counts tick interrupts, so the first tick may
+    /// come straight away, and one more is added to make sure the whole delay passes.
+    ///
+    void TimerOSAL::delay_ms(uint32_t delay_ms)
+    {
+        if (delay_ms == 0)
+        {
+            return;
+        }
+
+        uint64_t ticks = (((uint64_t)delay_ms * configTICK_RATE_HZ) + (MS_PER_S - 1)) / MS_PER_S;
+        vTaskDelay((TickType_t)ticks + 1);
     }
 
     error::Error TimerOSAL::stop(TimerID id)
@@ -125,6 +146,27 @@ namespace timer_osal
         return ret_val;
     }
 
+    /// @brief Changes the period of the timer. This also starts the timer, and for a one-shot timer
+    /// the period is the time until it expires.
+    ///
+    error::Error TimerOSAL::set_period(TimerID id, uint32_t period_ms)
+    {
+        error::Error ret_val = error::NoError;
+
+        if (id >= TimerID::NumIDs)
+        {
+            ret_val = error::InvalidID;
+        }
+        else
+        {
+            xTimerHandle timer  = (xTimerHandle)handle_list[(uint32_t)id];
+            bool         no_err = xTimerChangePeriod(timer, pdMS_TO_TICKS(period_ms), 0) == pdPASS;
+            ret_val             = no_err ? error::NoError : error::StartFailed;
+        }
+
+        return ret_val;
+    }
+
     error::Error TimerOSAL::create(TimerID           id,
                                    TimerCallbackFunc callback,
                                    uint32_t          period_ms,
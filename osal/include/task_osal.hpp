@@ -40,6 +40,17 @@ namespace task_osal
             uint32_t high_water;
     };
 
+    /// @brief Time a task has spent running since the scheduler started. This covers every task
+    /// the RTOS has (e.g. idle), not just the ones in tasks.def.
+    ///
+    struct RunStats
+    {
+            uint32_t    number;   // Unique to the task, for matching up samples
+            const char *name;     // Name the RTOS has for the task
+            uint32_t    run_time; // Run time in clock ticks, wraps
+            uint32_t    switches; // Number of times the task has been switched in, wraps
+    };
+
     //----------------------------------------------------------------------------------------------
     //  Classes
     //----------------------------------------------------------------------------------------------
@@ -69,6 +80,10 @@ namespace task_osal
 
             StackInfo get_stack_info(task::ID id);
 
+            uint32_t get_run_stats(RunStats *stats, uint32_t max_stats, uint32_t *total_time);
+
+            uint32_t get_idle_wakes();
+
             void send_signal(void *handle, uint32_t signal);
 
             uint32_t wait_signal();
@@ -88,6 +103,10 @@ namespace task_osal
 
     StackInfo get_stack_info(task::ID id);
 
+    uint32_t get_run_stats(RunStats *stats, uint32_t max_stats, uint32_t *total_time);
+
+    uint32_t get_idle_wakes();
+
     void send_signal(void *handle, uint32_t signal);
 
     uint32_t wait_signal();
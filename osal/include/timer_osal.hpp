@@ -27,6 +27,7 @@ namespace timer_osal
     //  Public Constants
     //----------------------------------------------------------------------------------------------
 
+    constexpr uint32_t MAX_SPIN_US = 1000; // Longest busy-wait allowed, one tick at 1kHz
 
     //----------------------------------------------------------------------------------------------
     //  Public Data Types
@@ -70,10 +71,16 @@ namespace timer_osal
 
             uint32_t curr_time_ms();
 
+            uint32_t tick_us();
+
+            void delay_ms(uint32_t delay_ms);
+
             error::Error stop(TimerID id);
 
             error::Error start(TimerID id);
 
+            error::Error set_period(TimerID id, uint32_t period_ms);
+
             error::Error create(TimerID           id,
                                 TimerCallbackFunc callback,
                                 uint32_t          period_ms,
@@ -90,12 +97,18 @@ namespace timer_osal
 
     void delay_ms(uint32_t delay_ms);
 
+    void delay_us(uint32_t delay_us);
+
+    void spin_us(uint32_t delay_us);
+
     uint32_t curr_time_ms();
 
     error::Error stop(TimerID id);
 
     error::Error start(TimerID id);
 
+    error::Error set_period(TimerID id, uint32_t period_ms);
+
     error::Error create(TimerID           id,
                         TimerCallbackFunc callback,
                         uint32_t          period_ms,
@@ -85,6 +85,41 @@ namespace task_osal
         return ret_val;
     }
 
+    /// @brief Gets the run time of every task.
+    /// @param stats Where to put the stats.
+    /// @param max_stats Maximum number of tasks to get.
+    /// @param total_time Total run time, in clock ticks, of all tasks.
+    /// @return Number of tasks got.
+    ///
+    uint32_t get_run_stats(RunStats *stats, uint32_t max_stats, uint32_t *total_time)
+    {
+        init();
+
+        *total_time = 0;
+        if (task_osals[(uint32_t)osal::rtos()] == nullptr)
+        {
+            return 0;
+        }
+
+        return task_osals[(uint32_t)osal::rtos()]->get_run_stats(stats, max_stats, total_time);
+    }
+
+    /// @brief Gets the number of times the core has been woken up while idle (i.e. from a
+    /// tickless sleep), wraps. Always zero if the RTOS doesn't sleep while idle.
+    /// @return Number of idle wake ups.
+    ///
+    uint32_t get_idle_wakes()
+    {
+        init();
+
+        if (task_osals[(uint32_t)osal::rtos()] == nullptr)
+        {
+            return 0;
+        }
+
+        return task_osals[(uint32_t)osal::rtos()]->get_idle_wakes();
+    }
+
     void send_signal(void *handle, uint32_t signal)
     {
         init();
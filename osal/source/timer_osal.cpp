@@ -10,6 +10,7 @@
 ///
 
 #include "timer_osal.hpp"
+#include "clock_hal.hpp"
 #include "macros.hpp"
 
 #include <cstdint>
@@ -24,6 +25,8 @@ namespace
     //  Private Constants
     //----------------------------------------------------------------------------------------------
 
+    constexpr uint64_t US_PER_S  = 1000000;
+    constexpr uint32_t US_PER_MS = 1000;
 
     //----------------------------------------------------------------------------------------------
     //  Private Data Types
@@ -71,10 +74,66 @@ namespace timer_osal
     //  Public Functions
     //----------------------------------------------------------------------------------------------
 
+    /// @brief Blocks the calling task for at least the delay, letting other tasks run meanwhile.
+    /// Without an RTOS there's nothing else to run, so this spins instead.
+    /// @param delay_ms Delay in milliseconds.
+    ///
     void delay_ms(uint32_t delay_ms)
     {
-        uint32_t start_time = curr_time_ms();
-        while ((curr_time_ms() - start_time) < delay_ms)
+        init();
+
+        if (timer_osals[(uint32_t)osal::rtos()] == nullptr)
+        {
+            for (uint32_t i = 0; i < delay_ms; i++)
+            {
+                spin_us(US_PER_MS);
+            }
+            return;
+        }
+
+        timer_osals[(uint32_t)osal::rtos()]->delay_ms(delay_ms);
+    }
+
+    /// @brief Delays for at least the given time. Delays of a tick or more block like delay_ms(),
+    /// rounded up to the next millisecond, and shorter ones spin, as blocking can't be shorter than
+    /// a tick.
+    /// @param delay_us Delay in microseconds.
+    ///
+    void delay_us(uint32_t delay_us)
+    {
+        init();
+
+        uint32_t tick_us = MAX_SPIN_US;
+        if (timer_osals[(uint32_t)osal::rtos()] != nullptr)
+        {
+            tick_us = timer_osals[(uint32_t)osal::rtos()]->tick_us();
+        }
+
+        if ((delay_us < tick_us) && (delay_us <= MAX_SPIN_US))
+        {
+            spin_us(delay_us);
+        }
+        else
+        {
+            delay_ms((delay_us + (US_PER_MS - 1)) / US_PER_MS);
+        }
+    }
+
+    /// @brief Busy-waits on the free-running clock, for hardware that needs a delay shorter than
+    /// a tick. Nothing else runs on this core meanwhile (apart from interrupts, which only make
+    /// the delay longer), so anything longer has to use delay_ms() or delay_us().
+    /// @param delay_us Delay in microseconds, up to MAX_SPIN_US.
+    ///
+    void spin_us(uint32_t delay_us)
+    {
+        REQUIRE(delay_us <= MAX_SPIN_US, error::InvalidTime);
+
+        // Rounded up, as the first count may be almost over when the start is read
+        uint32_t counts = (uint32_t)((((uint64_t)delay_us * clock_hal::rate_hz()) + (US_PER_S - 1))
+                                     / US_PER_S) + 1;
+
+        uint32_t start = clock_hal::ticks();
+        while ((clock_hal::ticks() - start) < counts)
         {
             // Do nothing
         }
@@ -129,7 +188,26 @@ namespace timer_osal
 
         if (ret_val == error::NoError)
         {
-            running_list[(uint32_t)id] = false;
+            running_list[(uint32_t)id] = true;
+        }
+
+        return ret_val;
+    }
+
+    error::Error set_period(TimerID id, uint32_t period_ms)
+    {
+        init();
+
+        if (timer_osals[(uint32_t)osal::rtos()] == nullptr)
+        {
+            return error::NoError;
+        }
+
+        error::Error ret_val = timer_osals[(uint32_t)osal::rtos()]->set_period(id, period_ms);
+
+        if (ret_val == error::NoError)
+        {
+            running_list[(uint32_t)id] = true;
         }
 
         return ret_val;
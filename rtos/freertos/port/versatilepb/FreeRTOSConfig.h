@@ -95,12 +95,24 @@ PRIORITY THAN THIS! (higher priorities are lower numeric values. */
 #define configCHECK_FOR_STACK_OVERFLOW     0
 #define configUSE_DAEMON_TASK_STARTUP_HOOK 0
 
-/* Run time and task stats gathering related definitions. */
-#define configGENERATE_RUN_TIME_STATS 0
+/* Run time and task stats gathering related definitions. Run time is counted on the free
+ * running clock (see clock_hal), which hal::init() starts before the scheduler does. Switching a
+ * task in is counted by its TCB number. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+uint32_t ulGetRunTimeCounterValue(void);
+void vTaskSwitchedIn(uint32_t ulTaskNumber);
+#ifdef __cplusplus
+}
+#endif
+
+#define configGENERATE_RUN_TIME_STATS 1
 #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
-#define portGET_RUN_TIME_COUNTER_VALUE()     xTaskGetTickCount()
-#define configUSE_TRACE_FACILITY             0
+#define portGET_RUN_TIME_COUNTER_VALUE()     ulGetRunTimeCounterValue()
+#define configUSE_TRACE_FACILITY             1
 #define configUSE_STATS_FORMATTING_FUNCTIONS 0
+#define traceTASK_SWITCHED_IN()              vTaskSwitchedIn(pxCurrentTCB->uxTCBNumber)
 
 /* Co-routine related definitions. */
 #define configUSE_CO_ROUTINES           0
@@ -117,8 +129,17 @@ PRIORITY THAN THIS! (higher priorities are lower numeric values. */
 #define configTIMER_QUEUE_LENGTH     10
 #define configTIMER_TASK_STACK_DEPTH 180
 
-/* Tickless Idle Mode */
-#define configUSE_TICKLESS_IDLE 0
+/* Tickless Idle Mode. The port's implementation stops the tick until the next task or timer is due
+ * (see vPortSuppressTicksAndSleep() in port.c), and counts how often the core wakes back up. */
+#define configUSE_TICKLESS_IDLE 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+uint32_t ulPortGetIdleWakeCount(void);
+#ifdef __cplusplus
+}
+#endif
 
 /* QUEUE */
 #define configQUEUE_REGISTRY_SIZE 2
@@ -76,6 +76,19 @@
 /* Setup the timer to generate the tick interrupts. */
 static void prvSetupTimerInterrupt( void );
 
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+    /* Timer counts in one tick period, and the most ticks the 32-bit counter
+    can be loaded for.  Both are set when the tick timer is set up. */
+    static uint32_t ulTimerCountsForOneTick = 0;
+    static uint32_t xMaximumPossibleSuppressedTicks = 0;
+
+    /* Times the core has woken from a tickless sleep, for seeing how often
+    idle periods get interrupted. */
+    static volatile uint32_t ulIdleWakeCount = 0;
+
+#endif /* configUSE_TICKLESS_IDLE */
+
 /*
  * The scheduler can only be started from ARM mode, so
  * vPortISRStartFirstSTask() is defined in portISR.c.
@@ -219,6 +232,11 @@ static void prvSetupTimerInterrupt( void )
         ulCompareMatch = 1;
     }
 
+#if ( configUSE_TICKLESS_IDLE == 1 )
+    ulTimerCountsForOneTick = ulCompareMatch;
+    xMaximumPossibleSuppressedTicks = 0xFFFFFFFFUL / ulCompareMatch;
+#endif
+
     /* Configure the timer 0, counter 0 */
     timer_init(portTICK_TIMER, portTICK_TIMER_COUNTER);
     timer_setLoad(portTICK_TIMER, portTICK_TIMER_COUNTER, ulCompareMatch);
@@ -238,3 +256,106 @@ static void prvSetupTimerInterrupt( void )
 
 }
 /*-----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+/*
+ * Called by the idle task, with the scheduler suspended, when no task is
+ * expected to be ready for at least xExpectedIdleTime ticks.  That already
+ * covers every FreeRTOS timer, including the one the periodic scheduler arms
+ * for its next deadline.  Interrupt-run periodics have their own alarm, whose
+ * interrupt wakes the core like any other.
+ *
+ * The tick counter is loaded for the whole idle period, with the normal tick
+ * period in its background load so it goes back to ticking on its own when
+ * that runs out.  If anything else wakes the core first, the ticks that fully
+ * passed since the last tick are stepped and the counter is reloaded for what is left of the
+ * current tick, so the tick count doesn't drift.
+ */
+void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+{
+uint32_t ulReloadValue, ulCompletedCounts, ulCompleteTickPeriods;
+
+    if( xExpectedIdleTime > xMaximumPossibleSuppressedTicks )
+    {
+        xExpectedIdleTime = xMaximumPossibleSuppressedTicks;
+    }
+
+    /* Interrupts stay masked until the tick count has been corrected.  An
+    interrupt that comes in while asleep still wakes the core, and is serviced
+    once they are enabled again. */
+    portDISABLE_INTERRUPTS();
+
+    /* Stop the tick counter, keeping its value, while it is reprogrammed.  The
+    counts lost while it is stopped are a few instructions' worth. */
+    timer_stop(portTICK_TIMER, portTICK_TIMER_COUNTER);
+
+    /* A task may have been readied by an interrupt since the idle task decided
+    to sleep, or a tick may already be due and not yet counted.  Either way,
+    carry on ticking as normal. */
+    if( ( eTaskConfirmSleepModeStatus() == eAbortSleep ) ||
+        ( timer_isInterruptPending(portTICK_TIMER, portTICK_TIMER_COUNTER) != 0 ) )
+    {
+        timer_start(portTICK_TIMER, portTICK_TIMER_COUNTER);
+        portENABLE_INTERRUPTS();
+        return;
+    }
+
+    /* The rest of the current tick period plus the whole idle ticks after it */
+    ulReloadValue = timer_getValue(portTICK_TIMER, portTICK_TIMER_COUNTER) +
+                    ( ulTimerCountsForOneTick * ( xExpectedIdleTime - 1UL ) );
+
+    /* Writing the Load Register also sets the reload value, so the background
+    load has to be written after it. */
+    timer_setLoad(portTICK_TIMER, portTICK_TIMER_COUNTER, ulReloadValue);
+    timer_setBgLoad(portTICK_TIMER, portTICK_TIMER_COUNTER, ulTimerCountsForOneTick);
+    timer_start(portTICK_TIMER, portTICK_TIMER_COUNTER);
+
+    /* Wait for interrupt (ARM926EJ-S CP15 c7 operation) */
+    __asm volatile ( "MCR    p15, 0, %0, c7, c0, 4" : : "r" ( 0 ) : "memory" );
+
+    ulIdleWakeCount++;
+
+    timer_stop(portTICK_TIMER, portTICK_TIMER_COUNTER);
+
+    if( timer_isInterruptPending(portTICK_TIMER, portTICK_TIMER_COUNTER) != 0 )
+    {
+        /* The whole idle period passed.  The counter has already been reloaded
+        with one tick period and kept counting, and the tick interrupt will
+        count the last tick when interrupts are enabled. */
+        ulCompleteTickPeriods = xExpectedIdleTime - 1UL;
+    }
+    else
+    {
+        /* Something else woke the core.  Count the ticks that fully passed
+        since the last tick, not since sleep started, so the part of the
+        current tick that had already gone is included.  Then load the counter
+        with the time left until the next tick. */
+        ulCompletedCounts = ( xExpectedIdleTime * ulTimerCountsForOneTick ) -
+                            timer_getValue(portTICK_TIMER, portTICK_TIMER_COUNTER);
+        ulCompleteTickPeriods = ulCompletedCounts / ulTimerCountsForOneTick;
+
+        timer_setLoad(portTICK_TIMER, portTICK_TIMER_COUNTER,
+                      ( ( ulCompleteTickPeriods + 1UL ) * ulTimerCountsForOneTick ) -
+                      ulCompletedCounts);
+        timer_setBgLoad(portTICK_TIMER, portTICK_TIMER_COUNTER, ulTimerCountsForOneTick);
+    }
+
+    timer_start(portTICK_TIMER, portTICK_TIMER_COUNTER);
+
+    vTaskStepTick( ulCompleteTickPeriods );
+
+    portENABLE_INTERRUPTS();
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Number of times the core has woken from a tickless sleep, wraps.
+ */
+uint32_t ulPortGetIdleWakeCount( void )
+{
+    return ulIdleWakeCount;
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_TICKLESS_IDLE */
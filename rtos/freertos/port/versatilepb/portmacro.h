@@ -231,6 +231,13 @@ extern void vPortExitCritical( void );
 #define portEXIT_CRITICAL()         vPortExitCritical();
 /*-----------------------------------------------------------*/
 
+/* Tickless idle, see vPortSuppressTicksAndSleep() in port.c */
+#if ( configUSE_TICKLESS_IDLE == 1 )
+    extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+    #define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )  vPortSuppressTicksAndSleep( xExpectedIdleTime )
+#endif
+/*-----------------------------------------------------------*/
+
 /* Task function macros as described on the FreeRTOS.org WEB site. */
 #define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
 #define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
@@ -0,0 +1,290 @@
+"""
+Author: Denver Hoggatt
+Description: Decodes deferred log frames in console output.
+
+Copyright (c) 2025 Denver Hoggatt. All rights reserved.
+
+This software is licensed under the terms stated in the LICENSE file
+located at the root of this repository. If no LICENSE file accompanies
+this software, it is provided "AS IS" WITHOUT WARRANTY OF ANY KIND.
+"""
+
+# --------------------------------------------------------------------------------------------------
+#  Imports
+# --------------------------------------------------------------------------------------------------
+
+from argparse import ArgumentParser
+from pathlib import Path
+from re import compile as re_compile
+from struct import error as StructError, unpack
+import sys
+
+# --------------------------------------------------------------------------------------------------
+# Global Constants
+# --------------------------------------------------------------------------------------------------
+
+FRAME_DELIMITER = 0x00
+FRAME_TYPE_LOG = 4  # protocol::FrameType::Log
+HEADER_LEN = 2  # Type, sequence
+CRC_LEN = 2
+CRC_INIT = 0xFFFF
+CRC_POLY = 0x1021
+
+DEF_PATTERN = re_compile(r'^\s*DEF\(\s*(\w+)\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)')
+IF_PATTERN = re_compile(r"^\s*#\s*if")
+TESTING_PATTERN = re_compile(r"^\s*#\s*if\s+defined\(\s*TESTING\s*\)")
+ENDIF_PATTERN = re_compile(r"^\s*#\s*endif")
+CONVERSION_PATTERN = re_compile(
+    r"%([-+ #0]*)(\d*)(?:\.(\d+))?(?:hh|h|ll|l|j|z|t|L)?([diouxXcsfFeEgGp%])"
+)
+
+FLOAT_CONVERSIONS = "fFeEgG"
+SIGNED_CONVERSIONS = "di"
+
+# --------------------------------------------------------------------------------------------------
+# Global Variables
+# --------------------------------------------------------------------------------------------------
+
+
+# --------------------------------------------------------------------------------------------------
+# Classes
+# --------------------------------------------------------------------------------------------------
+
+
+class Reader:
+    """
+    Read position in a decoded frame.
+    """
+
+    def __init__(self, data: bytes):
+        self.data = data
+        self.pos = 0
+
+    def done(self) -> bool:
+        return self.pos >= len(self.data)
+
+    def u8(self) -> int:
+        value = self.data[self.pos]
+        self.pos += 1
+        return value
+
+    def u32(self) -> int:
+        (value,) = unpack("<I", self.data[self.pos : self.pos + 4])
+        self.pos += 4
+        return value
+
+    def varint(self) -> int:
+        value = 0
+        shift = 0
+        while True:
+            byte = self.u8()
+            value |= (byte & 0x7F) << shift
+            shift += 7
+            if not byte & 0x80:
+                return value
+
+    def string(self) -> str:
+        length = self.u8()
+        value = self.data[self.pos : self.pos + length].decode("ascii", errors="replace")
+        self.pos += length
+        return value
+
+
+# --------------------------------------------------------------------------------------------------
+# Functions
+# --------------------------------------------------------------------------------------------------
+
+
+def load_formats(def_path: str) -> list:
+    """
+    Reads the message formats out of logs.def, in ID order. Messages inside an
+    "#if defined(TESTING)" block are skipped, since they're only in the unit test build.
+    """
+
+    formats = []
+    skip_depth = 0
+    with open(Path(def_path), "r") as def_file:
+        for line in def_file:
+            if skip_depth > 0:
+                if IF_PATTERN.match(line):
+                    skip_depth += 1
+                elif ENDIF_PATTERN.match(line):
+                    skip_depth -= 1
+                continue
+
+            if TESTING_PATTERN.match(line):
+                skip_depth = 1
+                continue
+
+            match = DEF_PATTERN.match(line)
+            if match:
+                formats.append(match.group(2).encode().decode("unicode_escape"))
+
+    return formats
+
+
+def crc16(data: bytes) -> int:
+    """
+    CRC-16/CCITT, matching protocol::crc16()
+    """
+
+    crc = CRC_INIT
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ CRC_POLY) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+
+    return crc
+
+
+def cobs_decode(encoded: bytes):
+    """
+    Returns the decoded data, or None if it isn't valid COBS
+    """
+
+    data = bytearray()
+    pos = 0
+    while pos < len(encoded):
+        code = encoded[pos]
+        if (code == 0) or (pos + code > len(encoded)):
+            return None
+
+        data += encoded[pos + 1 : pos + code]
+        pos += code
+        if (code < 0xFF) and (pos < len(encoded)):
+            data.append(0)
+
+    return bytes(data)
+
+
+def format_message(fmt: str, reader: Reader) -> str:
+    """
+    Reads the arguments of a message, and formats them the way printf would have
+    """
+
+    def convert(match) -> str:
+        flags, width, precision, conversion = match.groups()
+        if conversion == "%":
+            return "%"
+
+        spec = "%" + flags + width + (("." + precision) if precision else "")
+
+        if conversion == "s":
+            return (spec + "s") % reader.string()
+
+        if conversion in FLOAT_CONVERSIONS:
+            (value,) = unpack("<f", reader.u32().to_bytes(4, "little"))
+            return (spec + conversion) % value
+
+        value = reader.varint()
+        if conversion == "p":
+            return "0x%08x" % value
+        if conversion == "c":
+            return chr(value & 0xFF)
+        if conversion in SIGNED_CONVERSIONS:
+            value = value - (1 << 32) if value & 0x80000000 else value
+            return (spec + "d") % value
+        if conversion == "u":
+            return (spec + "d") % value
+
+        return (spec + conversion) % value
+
+    return CONVERSION_PATTERN.sub(convert, fmt)
+
+
+def decode_frame(chunk: bytes, formats: list):
+    """
+    Returns the messages in a log frame, or None if the chunk isn't one
+    """
+
+    data = cobs_decode(chunk)
+    if (data is None) or (len(data) < HEADER_LEN + CRC_LEN) or (data[0] != FRAME_TYPE_LOG):
+        return None
+
+    (crc,) = unpack("<H", data[-CRC_LEN:])
+    if crc != crc16(data[:-CRC_LEN]):
+        return None
+
+    messages = []
+    reader = Reader(data[HEADER_LEN:-CRC_LEN])
+    try:
+        while not reader.done():
+            msg_id = reader.varint()
+            if msg_id >= len(formats):
+                messages.append(f"<unknown log message {msg_id}>")
+                break
+
+            messages.append(format_message(formats[msg_id], reader))
+    except (IndexError, ValueError, StructError):
+        messages.append("<truncated log message>")
+
+    return messages
+
+
+def main(def_path: str, input_path: str):
+    """
+    Passes console text through as-is, replacing log frames with their messages
+    """
+
+    formats = load_formats(def_path)
+
+    source = sys.stdin.buffer if input_path == "-" else open(input_path, "rb")
+    out = sys.stdout
+
+    # Log frames are always sent with an opening and a closing delimiter, so only the bytes
+    # between the two need holding back. Anything outside a frame is console text, and is passed
+    # through as soon as it arrives so prompts and echo aren't held up.
+    in_frame = False
+    frame = bytearray()
+    while True:
+        data = source.read1(4096) if hasattr(source, "read1") else source.read(4096)
+        if not data:
+            break
+
+        pos = 0
+        while pos < len(data):
+            end = data.find(FRAME_DELIMITER, pos)
+            if end < 0:
+                end = len(data)
+
+            if in_frame:
+                frame += data[pos:end]
+            else:
+                out.write(data[pos:end].decode("ascii", errors="replace"))
+
+            if end < len(data):
+                if in_frame and frame:
+                    messages = decode_frame(bytes(frame), formats)
+                    if messages is None:
+                        out.write(frame.decode("ascii", errors="replace"))
+                    else:
+                        for message in messages:
+                            out.write(f"[log] {message}\n")
+
+                    frame.clear()
+                    in_frame = False
+                else:
+                    # Opens a frame. If the frame is still empty, this opens the next one instead
+                    in_frame = True
+
+            pos = end + 1
+
+        out.flush()
+
+    out.write(frame.decode("ascii", errors="replace"))
+
+
+# --------------------------------------------------------------------------------------------------
+# Script
+# --------------------------------------------------------------------------------------------------
+
+if __name__ == "__main__":
+    parser = ArgumentParser()
+    parser.add_argument("--defs", type=str, default="application/include/logs.def")
+    parser.add_argument("--input", type=str, default="-")
+    args = parser.parse_args()
+
+    main(args.defs, args.input)
+
+# End of File
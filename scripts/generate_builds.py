@@ -56,13 +56,15 @@ def _make_build_func() -> str:
         build_func_str += f"\n@task(\n{TAB}help={{\n"
         build_func_str += f'{TAB}{TAB}"verbose": "Print verbose output",\n'
         build_func_str += f'{TAB}{TAB}"temps": "Preprocessor and disassembly output",\n'
+        build_func_str += f'{TAB}{TAB}"profiling": "Compile in profiling zones",\n'
         build_func_str += f"{TAB}}}\n)\n"
-        build_func_str += f"def {build_name}(c, verbose=False, temps=False):\n"
+        build_func_str += f"def {build_name}(c, verbose=False, temps=False, profiling=False):\n"
         build_func_str += f'{TAB}"""\n{TAB}Build for {build_name}\n{TAB}"""\n'
         build_func_str += f"{TAB}vars = _get_vars(c)\n"
         build_func_str += "\n"
         build_func_str += f'{TAB}vars["build_name"] = "{build_name}"\n'
         build_func_str += f'{TAB}vars["temps"] = temps\n'
+        build_func_str += f'{TAB}vars["profiling"] = profiling\n'
         for item in builds[build_name].keys():
             build_func_str += f'{TAB}vars["{item}"] = "{builds[build_name][item]}"\n'
         build_func_str += "\n"
@@ -92,6 +94,7 @@ def _make_test_func() -> str:
         build_func_str += "\n"
         build_func_str += f'{TAB}vars["build_name"] = "{build_name}"\n'
         build_func_str += f'{TAB}vars["temps"] = False\n'
+        build_func_str += f'{TAB}vars["profiling"] = False\n'
         for item in builds[build_name].keys():
             build_func_str += f'{TAB}vars["{item}"] = "{builds[build_name][item]}"\n'
         build_func_str += "\n"
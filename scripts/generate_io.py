@@ -124,6 +124,8 @@ def _assign_param(io_name, param_name, param_value):
         ret_val = (
             f"{TAB}{io_name}.{param_name} = {port_type}::VirtualPort::{param_value};\n"
         )
+    elif isinstance(param_value, bool):
+        ret_val = f"{TAB}{io_name}.{param_name} = {str(param_value).lower()};\n"
     else:
         ret_val = f"{TAB}{io_name}.{param_name} = {param_value};\n"
 
@@ -167,6 +167,7 @@ def _build(c, vars, verbose, cross_compile=True, additional_options=[]):
         f"-Drtos={vars['os']}",
         f"-Ddriver={vars['driver']}",
         "-Dsave-temps=true" if vars["temps"] else "",
+        "-Dprofiling=true" if vars["profiling"] else "",
     ]
 
     options += additional_options
@@ -415,9 +416,10 @@ def regen(c, verbose=False):
     help={
         "verbose": "Print verbose output",
         "temps": "Preprocessor and disassembly output",
+        "profiling": "Compile in profiling zones",
     }
 )
-def versatilepb(c, verbose=False, temps=False):
+def versatilepb(c, verbose=False, temps=False, profiling=False):
     """
     Build for versatilepb
     """
@@ -425,6 +427,7 @@ def versatilepb(c, verbose=False, temps=False):
 
     vars["build_name"] = "versatilepb"
     vars["temps"] = temps
+    vars["profiling"] = profiling
     vars["os"] = "FreeRTOS"
     vars["driver"] = "versatilepb"
     vars["platform"] = "versatilepb_qemu"
@@ -447,6 +450,7 @@ def unitest(c, verbose=False, coverage=False):
 
     vars["build_name"] = "unitest"
     vars["temps"] = False
+    vars["profiling"] = False
     vars["os"] = "FreeRTOS"
     vars["driver"] = "versatilepb"
     vars["platform"] = "unit_test"
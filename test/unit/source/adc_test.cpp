@@ -12,6 +12,7 @@
 #include "adc.hpp"
 #include "adc_test.hpp"
 #include "error.hpp"
+#include "logging.hpp"
 #include "event.hpp"
 #include "periodic.hpp"
 #include "macros.hpp"
@@ -20,6 +21,8 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <cstring>
+
 //--------------------------------------------------------------------------------------------------
 //  Private Constants
 //--------------------------------------------------------------------------------------------------
@@ -36,19 +39,17 @@ constexpr float    TEST_VAL_CONV_2 = 2.2;
 
 uint16_t read_val;
 
+uintptr_t logged_args[logging::MAX_ARGS];
+
 //--------------------------------------------------------------------------------------------------
 //  Fakes/Mocks
 //--------------------------------------------------------------------------------------------------
 
 DEFINE_FFF_GLOBALS;
 
-namespace io
+namespace logging
 {
-    FAKE_VOID_FUNC(print_override, const char *, const char *, IOID, char *, IODirection);
-    void print(const char *io, const char *name, IOID id, char *data, IODirection dir)
-    {
-        print_override(io, name, id, data, dir);
-    }
+    FAKE_VOID_FUNC(record, ID, uint8_t, uint32_t, const uintptr_t *);
 }
 
 namespace input
@@ -75,6 +76,7 @@ namespace adc_hal
     FAKE_VALUE_FUNC(uint32_t, get_bit_width, adc::VirtualPort);
     FAKE_VALUE_FUNC(float, get_ref_voltage);
     FAKE_VOID_FUNC(start_conversions);
+    FAKE_VALUE_FUNC(bool, has_conversions);
 
     error::Error read(adc::VirtualPort pin, uint16_t *val)
     {
@@ -94,13 +96,20 @@ namespace event
 namespace periodic
 {
     FAKE_VOID_FUNC(start, ID);
-    FAKE_VOID_FUNC(create, ID, uint32_t, CallbackFunc);
+    FAKE_VOID_FUNC(create, ID, CallbackFunc);
 }
 
 //--------------------------------------------------------------------------------------------------
 //  Private Functions
 //--------------------------------------------------------------------------------------------------
 
+void capture_log(logging::ID id, uint8_t types, uint32_t num_args, const uintptr_t *args)
+{
+    UNUSED(id);
+    UNUSED(types);
+
+    memcpy(logged_args, args, num_args * sizeof(args[0]));
+}
 
 //--------------------------------------------------------------------------------------------------
 //  Tests
@@ -149,9 +158,20 @@ TEST(ADCTest, GetData)
 
     read_val = TEST_VAL;
 
+    RESET_FAKE(logging::record);
+    logging::record_fake.custom_fake = capture_log;
+
     test_adc_3.input_type = &typeid(float *);
     ASSERT_EQ(*test_adc_3.get<float *>(), TEST_VAL_CONV);
 
+    ASSERT_EQ(logging::record_fake.call_count, 1u);
+    ASSERT_EQ(logging::record_fake.arg0_val, logging::ID::ADCReceived);
+    ASSERT_EQ(logging::record_fake.arg1_val, (logging::arg_types<const char *, io::IOID, float>()));
+
+    float logged = 0;
+    memcpy(&logged, &logged_args[2], sizeof(logged));
+    ASSERT_EQ(logged, TEST_VAL_CONV);
+
     // Repeat to test that index is properly incrementing
     adc::ADC test_adc_4 = adc::ADC();
     test_adc_4.id       = io::IOID::INPUT_2;
@@ -166,15 +186,34 @@ TEST(ADCTest, GetData)
 
 TEST(ADCTest, StartConversion)
 {
+    adc_hal::has_conversions_fake.return_val = true;
+
     adc::ADC test_adc_1 = adc::ADC();
     test_adc_1.id       = io::IOID::INPUT_1;
     test_adc_1.init();
 
-    periodic::CallbackFunc func  = periodic::create_fake.arg2_history[0];
+    periodic::CallbackFunc func  = periodic::create_fake.arg1_history[0];
     event::count_fake.return_val = 1;
     func(0);
 
     ASSERT_TRUE(adc_hal::start_conversions_fake.call_count);
+
+    adc_hal::has_conversions_fake.return_val = false;
+}
+
+TEST(ADCTest, NoConversions)
+{
+    RESET_FAKE(periodic::create);
+    RESET_FAKE(periodic::start);
+    adc_hal::has_conversions_fake.return_val = false;
+
+    adc::ADC test_adc_1 = adc::ADC();
+    test_adc_1.id       = io::IOID::INPUT_1;
+    test_adc_1.init();
+
+    // Nothing to start, so the periodic isn't run at all
+    ASSERT_EQ(periodic::create_fake.call_count, 0u);
+    ASSERT_EQ(periodic::start_fake.call_count, 0u);
 }
 
 // End of File
\ No newline at end of file
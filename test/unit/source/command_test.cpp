@@ -18,6 +18,11 @@
 #include "settings.hpp"
 #include "flash_hal.hpp"
 #include "power_hal.hpp"
+#include "task.hpp"
+#include "watch.hpp"
+#include "profile.hpp"
+#include "cpu_usage.hpp"
+#include "periodic.hpp"
 #include "fff.h"
 
 #include <gtest/gtest.h>
@@ -35,6 +40,9 @@
 uintptr_t input_ret_val = 0;
 void     *out_data;
 
+char     captured[2048];
+uint32_t captured_len = 0;
+
 //--------------------------------------------------------------------------------------------------
 //  Fakes/Mocks
 //--------------------------------------------------------------------------------------------------
@@ -43,7 +51,7 @@ DEFINE_FFF_GLOBALS;
 
 namespace control
 {
-    FAKE_VALUE_FUNC(char *, get_list_of_controls);
+    FAKE_VOID_FUNC(write_list_of_controls, utility::Writer *);
     FAKE_VALUE_FUNC(Control *, get_control_by_name, const char *);
 
     HandleStatus TestControl1::handle_event(event::Event evt)
@@ -180,7 +188,16 @@ namespace mem_hal
 
 namespace task
 {
-    FAKE_VOID_FUNC(print_maximum_stack_usage, bool);
+    FAKE_VOID_FUNC(write_stack_usage, utility::Writer *, ID);
+    FAKE_VALUE_FUNC(bool, write_stack_dump, utility::Writer *, ID, uint32_t *, uint32_t);
+    FAKE_VALUE_FUNC(uint32_t, num);
+}
+
+namespace watch
+{
+    FAKE_VALUE_FUNC(bool, start, const io::IOID *, uint32_t, uint32_t);
+    FAKE_VOID_FUNC(stop);
+    FAKE_VALUE_FUNC(uint32_t, overruns);
 }
 
 namespace settings
@@ -201,10 +218,81 @@ namespace power_hal
     FAKE_VOID_FUNC(reset);
 }
 
+namespace periodic
+{
+    FAKE_VALUE_FUNC(Stats, get_stats, ID);
+    FAKE_VOID_FUNC(reset_stats);
+    FAKE_VALUE_FUNC(uint32_t, budget_us, ID);
+    FAKE_VALUE_FUNC(const char *, name, ID);
+}
+
+namespace cpu_usage
+{
+    FAKE_VOID_FUNC(write, utility::Writer *);
+}
+
+namespace profile
+{
+    FAKE_VALUE_FUNC(Stats, get, Zone);
+    FAKE_VALUE_FUNC(const char *, name, Zone);
+    FAKE_VOID_FUNC(reset);
+}
+
 //--------------------------------------------------------------------------------------------------
 //  Private Functions
 //--------------------------------------------------------------------------------------------------
 
+void capture_chunk(void *context, const char *chunk)
+{
+    UNUSED(context);
+
+    uint32_t len = strlen(chunk);
+    ASSERT_LT(captured_len + len, sizeof(captured));
+
+    memcpy(&captured[captured_len], chunk, len + 1);
+    captured_len += len;
+}
+
+/// @brief Runs a command, returning everything it wrote.
+///
+const char *run(command::CommandFunc func, uint32_t argc, char **argv)
+{
+    captured[0]  = '\0';
+    captured_len = 0;
+
+    utility::Writer out;
+    out.init(capture_chunk, nullptr);
+    func(&out, argc, argv);
+    out.flush();
+
+    return captured;
+}
+
+/// @brief Resumes the pending command, returning everything it wrote.
+///
+const char *resume()
+{
+    captured[0]  = '\0';
+    captured_len = 0;
+
+    utility::Writer out;
+    out.init(capture_chunk, nullptr);
+    command::resume(&out);
+    out.flush();
+
+    return captured;
+}
+
+void write_test_controls(utility::Writer *out)
+{
+    out->write("test\r\n");
+}
+
+void write_test_usage(utility::Writer *out)
+{
+    out->write("usage\r\n");
+}
+
 command::CommandFunc get_func(const char *name)
 {
     uint32_t              list_size = 0;
@@ -244,13 +332,19 @@ TEST(CommandTest, TestFuncs)
     uint32_t              list_size = 0;
     command::CommandFunc *func_list = command::get_func_list(&list_size);
 
-    char test_str[]                               = "test\r\n";
-    control::get_list_of_controls_fake.return_val = (char *)test_str;
+    control::write_list_of_controls_fake.custom_fake = write_test_controls;
+    cpu_usage::write_fake.custom_fake                = write_test_usage;
+    task::write_stack_dump_fake.return_val           = true;
 
     for (uint32_t i = 0; i < list_size; i++)
     {
-        char *ret_str = func_list[i](0, nullptr);
-        ASSERT_NE(ret_str, nullptr);
+        const char *ret_str = run(func_list[i], 0, nullptr);
+        ASSERT_NE(strlen(ret_str), 0u);
+
+        while (command::pending())
+        {
+            resume();
+        }
     }
 
     control::get_control_by_name_fake.return_val = &ctrl;
@@ -259,13 +353,20 @@ TEST(CommandTest, TestFuncs)
     {
         const char *arg_list[]    = { "arg1", "arg2" };
         uint32_t    arg_list_size = sizeof(arg_list) / sizeof(arg_list[0]);
-        char       *ret_str       = func_list[i](arg_list_size, (char **)arg_list);
+        const char *ret_str       = run(func_list[i], arg_list_size, (char **)arg_list);
 
-        ASSERT_NE(ret_str, nullptr);
+        ASSERT_NE(strlen(ret_str), 0u);
+
+        while (command::pending())
+        {
+            resume();
+        }
     }
 
     RESET_FAKE(control::get_control_by_name);
-    RESET_FAKE(control::get_list_of_controls);
+    RESET_FAKE(control::write_list_of_controls);
+    RESET_FAKE(cpu_usage::write);
+    RESET_FAKE(task::write_stack_dump);
 }
 
 TEST(CommandTest, GetNameList)
@@ -294,6 +395,61 @@ TEST(CommandTest, TestNames)
     }
 }
 
+TEST(CommandTest, Find)
+{
+    uint32_t     list_size = 0;
+    const char **name_list = command::get_name_list(&list_size);
+
+    for (uint32_t i = 0; i < list_size; i++)
+    {
+        ASSERT_EQ(command::find(name_list[i], strlen(name_list[i])), (int32_t)i);
+    }
+
+    ASSERT_EQ(command::find("help arg", 4), command::find("help", 4));
+    ASSERT_EQ(command::find("hel", 3), -1);
+    ASSERT_EQ(command::find("helpp", 5), -1);
+    ASSERT_EQ(command::find("", 0), -1);
+}
+
+TEST(CommandTest, Match)
+{
+    uint32_t     list_size = 0;
+    const char **name_list = command::get_name_list(&list_size);
+
+    uint32_t io_cmds = 0;
+    for (uint32_t i = 0; i < list_size; i++)
+    {
+        io_cmds += (strncmp(name_list[i], "io-", 3) == 0) ? 1 : 0;
+    }
+
+    command::Matches matches = command::match("io-", 3);
+    ASSERT_EQ(matches.count, io_cmds);
+    ASSERT_EQ(matches.common_len, 3u);
+    for (uint32_t i = 0; i < matches.count; i++)
+    {
+        ASSERT_EQ(strncmp(name_list[matches.ids[i]], "io-", 3), 0);
+    }
+    for (uint32_t i = 1; i < matches.count; i++)
+    {
+        ASSERT_LT(strcmp(name_list[matches.ids[i - 1]], name_list[matches.ids[i]]), 0);
+    }
+
+    matches = command::match("fl", 2);
+    ASSERT_EQ(matches.count, 3u);
+    ASSERT_EQ(matches.common_len, strlen("flash-"));
+
+    matches = command::match("reb", 3);
+    ASSERT_EQ(matches.count, 1u);
+    ASSERT_STREQ(name_list[matches.ids[0]], "reboot");
+    ASSERT_EQ(matches.common_len, strlen("reboot"));
+
+    matches = command::match("zzz", 3);
+    ASSERT_EQ(matches.count, 0u);
+
+    matches = command::match("", 0);
+    ASSERT_EQ(matches.count, list_size);
+}
+
 TEST(CommandTest, TestInputs)
 {
     command::CommandFunc func = get_func("io-get");
@@ -303,47 +459,47 @@ TEST(CommandTest, TestInputs)
     uint32_t    arr_size = 1;
 
     input::get_by_id_fake.return_val = nullptr;
-    char *ret_val                    = func(arr_size, (char **)arr);
-    ASSERT_NE(ret_val, nullptr);
+    const char *ret_val              = run(func, arr_size, (char **)arr);
+    ASSERT_NE(strlen(ret_val), 0u);
 
     TestInput test_input             = TestInput();
     input::get_by_id_fake.return_val = (input::Input *)(&test_input);
-    ret_val                          = func(0, nullptr);
-    ASSERT_NE(ret_val, nullptr);
+    ret_val                          = run(func, 0, nullptr);
+    ASSERT_NE(strlen(ret_val), 0u);
 
     static float tmp_val = 1.1;
 
     input_ret_val = (uintptr_t)(&tmp_val);
     test_input.init();
     test_input.input_type = &typeid(float *);
-    ret_val               = func(arr_size, (char **)arr);
-    ASSERT_NE(ret_val, nullptr);
+    ret_val               = run(func, arr_size, (char **)arr);
+    ASSERT_NE(strlen(ret_val), 0u);
 
     input_ret_val         = 0;
     test_input.type       = io::IOType::GPIO;
     test_input.input_type = &typeid(bool);
-    ret_val               = func(arr_size, (char **)arr);
-    ASSERT_NE(ret_val, nullptr);
+    ret_val               = run(func, arr_size, (char **)arr);
+    ASSERT_NE(strlen(ret_val), 0u);
 
     test_input.type       = io::IOType::UART;
     test_input.input_type = &typeid(char *);
-    ret_val               = func(arr_size, (char **)arr);
-    ASSERT_NE(ret_val, nullptr);
+    ret_val               = run(func, arr_size, (char **)arr);
+    ASSERT_NE(strlen(ret_val), 0u);
 
     test_input.type       = io::IOType::GPIO;
     test_input.input_type = &typeid(uint32_t);
-    ret_val               = func(arr_size, (char **)arr);
-    ASSERT_NE(ret_val, nullptr);
+    ret_val               = run(func, arr_size, (char **)arr);
+    ASSERT_NE(strlen(ret_val), 0u);
 
     test_input.type       = io::IOType::GPIO;
     test_input.input_type = &typeid(int32_t);
-    ret_val               = func(arr_size, (char **)arr);
-    ASSERT_NE(ret_val, nullptr);
+    ret_val               = run(func, arr_size, (char **)arr);
+    ASSERT_NE(strlen(ret_val), 0u);
 
     test_input.type       = io::IOType::GPIO;
     test_input.input_type = &typeid(UniqueType);
-    ret_val               = func(arr_size, (char **)arr);
-    ASSERT_NE(ret_val, nullptr);
+    ret_val               = run(func, arr_size, (char **)arr);
+    ASSERT_NE(strlen(ret_val), 0u);
 }
 
 TEST(CommandTest, TestOutputs)
@@ -355,38 +511,38 @@ TEST(CommandTest, TestOutputs)
     uint32_t    arr_size = 2;
 
     output::get_by_id_fake.return_val = nullptr;
-    char *ret_val                     = func(arr_size, (char **)arr);
-    ASSERT_NE(ret_val, nullptr);
+    const char *ret_val               = run(func, arr_size, (char **)arr);
+    ASSERT_NE(strlen(ret_val), 0u);
 
     TestOutput test_output            = TestOutput();
     output::get_by_id_fake.return_val = (output::Output *)(&test_output);
-    ret_val                           = func(0, nullptr);
-    ASSERT_NE(ret_val, nullptr);
+    ret_val                           = run(func, 0, nullptr);
+    ASSERT_NE(strlen(ret_val), 0u);
 
     test_output.init();
     test_output.output_type = &typeid(bool);
-    ret_val                 = func(arr_size, (char **)arr);
-    ASSERT_NE(ret_val, nullptr);
+    ret_val                 = run(func, arr_size, (char **)arr);
+    ASSERT_NE(strlen(ret_val), 0u);
 
     test_output.type        = io::IOType::UART;
     test_output.output_type = &typeid(char *);
-    ret_val                 = func(arr_size, (char **)arr);
-    ASSERT_NE(ret_val, nullptr);
+    ret_val                 = run(func, arr_size, (char **)arr);
+    ASSERT_NE(strlen(ret_val), 0u);
 
     test_output.type        = io::IOType::GPIO;
     test_output.output_type = &typeid(uint32_t);
-    ret_val                 = func(arr_size, (char **)arr);
-    ASSERT_NE(ret_val, nullptr);
+    ret_val                 = run(func, arr_size, (char **)arr);
+    ASSERT_NE(strlen(ret_val), 0u);
 
     test_output.type        = io::IOType::GPIO;
     test_output.output_type = &typeid(int32_t);
-    ret_val                 = func(arr_size, (char **)arr);
-    ASSERT_NE(ret_val, nullptr);
+    ret_val                 = run(func, arr_size, (char **)arr);
+    ASSERT_NE(strlen(ret_val), 0u);
 
     test_output.type        = io::IOType::GPIO;
     test_output.output_type = &typeid(UniqueType);
-    ret_val                 = func(arr_size, (char **)arr);
-    ASSERT_NE(ret_val, nullptr);
+    ret_val                 = run(func, arr_size, (char **)arr);
+    ASSERT_NE(strlen(ret_val), 0u);
 }
 
 TEST(CommandTest, TestIOList)
@@ -397,25 +553,77 @@ TEST(CommandTest, TestIOList)
     input::get_by_id_fake.return_val  = nullptr;
     output::get_by_id_fake.return_val = nullptr;
 
-    char *ret_val = func(0, nullptr);
-    ASSERT_NE(ret_val, nullptr);
+    const char *ret_val = run(func, 0, nullptr);
+    ASSERT_NE(strlen(ret_val), 0u);
 
-    const char *test_name             = "input1"; // Must fit within TOTAL_IO_NAME_SIZE
+    const char *test_name             = "input1";
     TestOutput  test_output           = TestOutput();
     test_output.id                    = io::IOID::INPUT_1;
     test_output.name                  = test_name;
     output::get_by_id_fake.return_val = (output::Output *)(&test_output);
 
-    ret_val = func(0, nullptr);
-    ASSERT_NE(ret_val, nullptr);
+    ret_val = run(func, 0, nullptr);
+    ASSERT_NE(strstr(ret_val, test_name), nullptr);
 
     TestInput test_input             = TestInput();
     test_input.id                    = io::IOID::INPUT_1;
     test_input.name                  = test_name;
     input::get_by_id_fake.return_val = (input::Input *)(&test_input);
 
-    ret_val = func(0, nullptr);
-    ASSERT_NE(ret_val, nullptr);
+    ret_val = run(func, 0, nullptr);
+    ASSERT_NE(strlen(ret_val), 0u);
+}
+
+TEST(CommandTest, MemoryIncremental)
+{
+    command::CommandFunc func = get_func("memory");
+    ASSERT_NE(func, nullptr);
+
+    RESET_FAKE(task::write_stack_usage);
+    RESET_FAKE(task::write_stack_dump);
+    RESET_FAKE(task::num);
+    task::num_fake.return_val = 2;
+
+    bool dump_done[] = { false, true, true };
+    SET_RETURN_SEQ(task::write_stack_dump, dump_done, 3);
+
+    const char *arr[] = { "dump" };
+    run(func, 1, (char **)arr);
+
+    ASSERT_TRUE(command::pending());
+    ASSERT_EQ(task::write_stack_usage_fake.call_count, 0u); // Stacks are left for later slices
+
+    uint32_t slices = 0;
+    while (command::pending())
+    {
+        resume();
+        slices++;
+    }
+
+    // Task 0: usage, 2 dump slices. Task 1: usage, 1 dump slice.
+    ASSERT_EQ(slices, 5u);
+    ASSERT_EQ(task::write_stack_usage_fake.call_count, 2u);
+    ASSERT_EQ(task::write_stack_dump_fake.call_count, 3u);
+    ASSERT_EQ(task::write_stack_dump_fake.arg1_history[0], (task::ID)0);
+    ASSERT_EQ(task::write_stack_dump_fake.arg1_history[2], (task::ID)1);
+    ASSERT_NE(strstr(captured, "Current Stack Pointer"), nullptr);
+
+    RESET_FAKE(task::write_stack_usage);
+    RESET_FAKE(task::write_stack_dump);
+    task::num_fake.return_val = 1;
+    run(func, 0, nullptr);
+
+    slices = 0;
+    while (command::pending())
+    {
+        resume();
+        slices++;
+    }
+
+    ASSERT_EQ(slices, 1u);
+    ASSERT_EQ(task::write_stack_dump_fake.call_count, 0u);
+
+    RESET_FAKE(task::num);
 }
 
 TEST(CommandTest, IOPrint)
@@ -425,15 +633,126 @@ TEST(CommandTest, IOPrint)
 
     io::get_by_id_fake.return_val = &test_output;
 
-    char *ret_val = func(0, nullptr);
-    ASSERT_NE(ret_val, nullptr);
+    const char *ret_val = run(func, 0, nullptr);
+    ASSERT_NE(strlen(ret_val), 0u);
     ASSERT_EQ(test_output.print_io, true);
 
     func = get_func("io-quiet");
 
-    ret_val = func(0, nullptr);
-    ASSERT_NE(ret_val, nullptr);
+    ret_val = run(func, 0, nullptr);
+    ASSERT_NE(strlen(ret_val), 0u);
     ASSERT_EQ(test_output.print_io, false);
 }
 
-// End of File
\ No newline at end of file
+TEST(CommandTest, IOWatch)
+{
+    command::CommandFunc func       = get_func("io-watch");
+    TestInput            test_input = TestInput();
+    test_input.id                   = (io::IOID)2;
+
+    input::get_by_id_fake.return_val = (input::Input *)(&test_input);
+    watch::start_fake.return_val     = true;
+
+    const char *args[]  = { "2", "2", "100" };
+    const char *ret_val = run(func, 3, (char **)args);
+    ASSERT_STREQ(ret_val, "\r\n");
+    ASSERT_EQ(watch::start_fake.call_count, 1u);
+    ASSERT_EQ(watch::start_fake.arg0_val[0], (io::IOID)2);
+    ASSERT_EQ(watch::start_fake.arg1_val, 2u);
+    ASSERT_EQ(watch::start_fake.arg2_val, 100u);
+
+    watch::start_fake.return_val = false; // Rate out of range
+    ret_val                      = run(func, 3, (char **)args);
+    ASSERT_NE(strstr(ret_val, "Rate"), nullptr);
+
+    input::get_by_id_fake.return_val = nullptr;
+    ret_val                          = run(func, 3, (char **)args);
+    ASSERT_STREQ(ret_val, "Invalid Input\r\n");
+    ASSERT_EQ(watch::start_fake.call_count, 2u);
+
+    ret_val = run(func, 1, (char **)args); // Rate without any inputs
+    ASSERT_STREQ(ret_val, "Invalid Number of Arguments\r\n");
+
+    const char *stop[]              = { "stop" };
+    watch::overruns_fake.return_val = 3;
+    ret_val                         = run(func, 1, (char **)stop);
+    ASSERT_EQ(watch::stop_fake.call_count, 1u);
+    ASSERT_STREQ(ret_val, "Missed Samples: 3\r\n");
+
+    RESET_FAKE(input::get_by_id);
+    RESET_FAKE(watch::start);
+    RESET_FAKE(watch::stop);
+    RESET_FAKE(watch::overruns);
+}
+
+TEST(CommandTest, Top)
+{
+    command::CommandFunc func = get_func("top");
+
+    RESET_FAKE(cpu_usage::write);
+    cpu_usage::write_fake.custom_fake = write_test_usage;
+
+    const char *ret_val = run(func, 0, nullptr);
+    ASSERT_STREQ(ret_val, "usage\r\n");
+    ASSERT_EQ(cpu_usage::write_fake.call_count, 1u);
+
+    RESET_FAKE(cpu_usage::write);
+}
+
+TEST(CommandTest, Profile)
+{
+    command::CommandFunc func = get_func("profile");
+
+    RESET_FAKE(profile::get);
+    RESET_FAKE(profile::reset);
+
+    profile::Stats stats          = { 4, 10, 30, 20 };
+    profile::get_fake.return_val  = stats;
+    profile::name_fake.return_val = "zone";
+
+    const char *ret_val = run(func, 0, nullptr);
+    const char *row = "zone                              4         10         30         20";
+    ASSERT_NE(strstr(ret_val, row), nullptr);
+    ASSERT_EQ(profile::get_fake.call_count, (uint32_t)profile::Zone::NumZones);
+    ASSERT_EQ(profile::reset_fake.call_count, 0u);
+
+    const char *args[] = { "reset" };
+    run(func, 1, (char **)args);
+    ASSERT_EQ(profile::reset_fake.call_count, 1u);
+
+    RESET_FAKE(profile::get);
+    RESET_FAKE(profile::name);
+    RESET_FAKE(profile::reset);
+}
+
+TEST(CommandTest, PeriodicStats)
+{
+    command::CommandFunc func = get_func("periodic-stats");
+
+    RESET_FAKE(periodic::get_stats);
+    RESET_FAKE(periodic::reset_stats);
+
+    periodic::Stats stats               = { 4, 10, 30, { 3, 1 }, 20, 40, 1, 2 };
+    periodic::get_stats_fake.return_val = stats;
+    periodic::budget_us_fake.return_val = 50;
+    periodic::name_fake.return_val      = "periodic";
+
+    const char *ret_val = run(func, 0, nullptr);
+    const char *row     = "periodic                 4        10        30        20        40"
+                          "        50         1         2";
+    const char *bins    = "periodic                3        1        0";
+    ASSERT_NE(strstr(ret_val, row), nullptr);
+    ASSERT_NE(strstr(ret_val, bins), nullptr);
+    ASSERT_EQ(periodic::reset_stats_fake.call_count, 0u);
+
+    const char *args[] = { "reset" };
+    run(func, 1, (char **)args);
+    ASSERT_EQ(periodic::reset_stats_fake.call_count, 1u);
+
+    RESET_FAKE(periodic::get_stats);
+    RESET_FAKE(periodic::reset_stats);
+    RESET_FAKE(periodic::budget_us);
+    RESET_FAKE(periodic::name);
+}
+
+// End of File
@@ -16,11 +16,15 @@
 #include "uart.hpp"
 #include "event.hpp"
 #include "macros.hpp"
+#include "protocol.hpp"
+#include "watch.hpp"
 #include "fff.h"
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <cinttypes>
+
 //--------------------------------------------------------------------------------------------------
 //  Private Constants
 //--------------------------------------------------------------------------------------------------
@@ -34,9 +38,15 @@ constexpr char HEADER[]  = "Starting Hypercraft CLI:";
 //--------------------------------------------------------------------------------------------------
 
 static uart::UART  console;
-static char       *rcvd_data = nullptr;
-static const char *send_data = nullptr;
-int32_t            cli_err   = 0;
+static char       *rcvd_data     = nullptr;
+static const char *send_data     = nullptr;
+static uint32_t    send_pos      = 0;
+static uint32_t    send_len      = 0; // Length of send_data if it's binary, otherwise 0
+int32_t            cli_err       = 0;
+static const char *cmd_out       = "test\r\n";
+static bool        binary        = false;
+static bool        frame_pending = false; // A command from a frame is still running
+static uint32_t    num_sets      = 0; // Number of writes to the console
 
 //--------------------------------------------------------------------------------------------------
 //  Fakes/Mocks
@@ -91,9 +101,11 @@ namespace output
 
 namespace command
 {
-    FAKE_VALUE_FUNC(char *, help_func, uint32_t, char **);
-    FAKE_VALUE_FUNC(char *, tab_one, uint32_t, char **);
-    FAKE_VALUE_FUNC(char *, tab_two, uint32_t, char **);
+    FAKE_VOID_FUNC(help_func, utility::Writer *, uint32_t, char **);
+    FAKE_VOID_FUNC(tab_one, utility::Writer *, uint32_t, char **);
+    FAKE_VOID_FUNC(tab_two, utility::Writer *, uint32_t, char **);
+    FAKE_VALUE_FUNC(bool, pending);
+    FAKE_VOID_FUNC(resume, utility::Writer *);
 
     const char **get_name_list(uint32_t *size)
     {
@@ -113,6 +125,72 @@ namespace command
         return cmd_func_list;
     }
 
+    int32_t find(const char *name, uint32_t len)
+    {
+        uint32_t     size     = 0;
+        const char **cmd_list = get_name_list(&size);
+
+        for (uint32_t i = 0; i < size; i++)
+        {
+            if ((strlen(cmd_list[i]) == len) && (strncmp(cmd_list[i], name, len) == 0))
+            {
+                return (int32_t)i;
+            }
+        }
+
+        return -1;
+    }
+
+    Matches match(const char *prefix, uint32_t len)
+    {
+        static const uint32_t ids[] = { 0, 1, 2 }; // Name list is already sorted
+
+        uint32_t     size     = 0;
+        const char **cmd_list = get_name_list(&size);
+
+        Matches ret_val = { nullptr, 0, 0 };
+        for (uint32_t i = 0; i < size; i++)
+        {
+            if (strncmp(cmd_list[i], prefix, len) != 0)
+            {
+                continue;
+            }
+
+            if (ret_val.count == 0)
+            {
+                ret_val.ids        = &ids[i];
+                ret_val.common_len = strlen(cmd_list[i]);
+            }
+
+            const char *first  = cmd_list[*ret_val.ids];
+            uint32_t    common = 0;
+            while ((common < ret_val.common_len) && (cmd_list[i][common] == first[common]))
+            {
+                common++;
+            }
+
+            ret_val.common_len = common;
+            ret_val.count++;
+        }
+
+        return ret_val;
+    }
+
+}
+
+namespace protocol
+{
+    FAKE_VALUE_FUNC(uint32_t, receive, const char *, uint32_t);
+    FAKE_VALUE_FUNC(bool, active);
+    FAKE_VALUE_FUNC(bool, pending);
+    FAKE_VOID_FUNC(resume);
+    FAKE_VOID_FUNC(start);
+    FAKE_VOID_FUNC(init, FrameSink, void *);
+}
+
+namespace watch
+{
+    FAKE_VOID_FUNC(sample, utility::Writer *, uint32_t);
 }
 
 namespace event
@@ -127,6 +205,21 @@ namespace uart
         return (void *)send_data;
     }
 
+    uint32_t UART::peek(Span (&spans)[2])
+    {
+        spans[0].data = (send_data == nullptr) ? "" : &send_data[send_pos];
+        spans[0].len  = (send_len > 0) ? (send_len - send_pos) : strlen(spans[0].data);
+        spans[1].data = "";
+        spans[1].len  = 0;
+
+        return spans[0].len;
+    }
+
+    void UART::consume(uint32_t len)
+    {
+        send_pos += len;
+    }
+
     void UART::set_output(void *data)
     {
         REQUIRE(data != nullptr, error::InvalidPointer);
@@ -140,6 +233,14 @@ namespace uart
 
         rcvd_data = (char *)malloc(strlen(str_data) + 1); // +1 \0
         strcpy(rcvd_data, str_data);
+
+        num_sets++;
+    }
+
+    FAKE_VOID_FUNC(write_override, const char *, uint32_t);
+    void UART::write(const char *data, uint32_t len)
+    {
+        write_override(data, len);
     }
 
     void UART::init()
@@ -171,17 +272,85 @@ namespace control
 
         return (int32_t)error::UnknownType;
     }
+
+    FAKE_VOID_FUNC(recall_override);
+    void Control::recall()
+    {
+        recall_override();
+    }
 }
 
 //--------------------------------------------------------------------------------------------------
 //  Private Functions
 //--------------------------------------------------------------------------------------------------
 
+static void write_cmd_out(utility::Writer *out, uint32_t argc, char **argv)
+{
+    UNUSED(argc);
+    UNUSED(argv);
+
+    out->write(cmd_out);
+}
+
+static void write_sample(utility::Writer *out, uint32_t time_ms)
+{
+    out->print("%" PRIu32 " 1\r\n", time_ms);
+}
+
+static void binary_start()
+{
+    binary = true;
+}
+
+static bool binary_active()
+{
+    return binary;
+}
+
+static uint32_t binary_receive(const char *data, uint32_t len)
+{
+    uint32_t used = 0;
+    while ((used < len) && binary)
+    {
+        binary = (data[used] != 'x');
+        used++;
+    }
+
+    return used;
+}
+
+static bool binary_pending()
+{
+    return frame_pending;
+}
+
+static void binary_resume()
+{
+    frame_pending = false;
+}
+
+static uint32_t binary_receive_pending(const char *data, uint32_t len)
+{
+    uint32_t used = 0;
+    while ((used < len) && !frame_pending)
+    {
+        frame_pending = (data[used] == 'p');
+        used++;
+    }
+
+    return used;
+}
+
 static control::CLI *init_cli()
 {
     static control::CLI cli;
     static bool         inited = false;
 
+    command::help_func_fake.custom_fake = write_cmd_out;
+    command::tab_one_fake.custom_fake   = write_cmd_out;
+    command::tab_two_fake.custom_fake   = write_cmd_out;
+    cmd_out                             = "test\r\n";
+
     if (!inited)
     {
         console.uart_port   = uart::VirtualPort::UART_CLI;
@@ -199,30 +368,14 @@ static control::CLI *init_cli()
     return &cli;
 }
 
-static void exec_cmd(control::CLI *cli)
-{
-    event::Event evt;
-    evt.arg = nullptr; // Execute command
-    evt.id  = event::ID::control_UpdateCLIState;
-    cli->handle_event(evt);
-
-    evt.arg = nullptr; // Write prompt
-    evt.id  = event::ID::control_UpdateCLIState;
-    cli->handle_event(evt);
-}
-
 static void send_cmd(control::CLI *cli, const char *cmd_str)
 {
     event::Event evt;
     evt.id    = event::ID::control_UARTInput;
+    evt.arg   = (void *)uart::VirtualPort::UART_CLI;
     send_data = cmd_str;
+    send_pos  = 0;
     cli->handle_event(evt);
-
-    // Must not include \r, so we can properly test subsequent CR-LF
-    if (cmd_str[strlen(cmd_str) - 1] == '\n')
-    {
-        exec_cmd(cli);
-    }
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -235,7 +388,7 @@ TEST(ControlCLITest, Init)
     UNUSED(cli);
 
     ASSERT_TRUE(output::get_by_id_fake.call_count);
-    ASSERT_STREQ(rcvd_data, PROMPT);
+    ASSERT_THAT(rcvd_data, testing::EndsWith(PROMPT));
 
     free(rcvd_data);
     rcvd_data = nullptr;
@@ -260,26 +413,24 @@ TEST(ControlCLITest, ExecCmd)
     const char cmd_str[] = "help\r";
     const char ret_str[] = "test return\r\n";
 
+    RESET_FAKE(event::post);
+    command::help_func_fake.call_count = 0;
+    cmd_out                            = ret_str;
+    num_sets                           = 0;
+
     event::Event evt;
     evt.id    = event::ID::control_UARTInput;
+    evt.arg   = (void *)uart::VirtualPort::UART_CLI;
     send_data = cmd_str;
-    cli->handle_event(evt);
-
-    ASSERT_EQ(event::post_fake.arg0_val, event::ID::control_UpdateCLIState);
-
-    command::help_func_fake.return_val = (char *)ret_str;
-    evt.arg                            = nullptr;
-    evt.id                             = event::ID::control_UpdateCLIState;
-    cli->handle_event(evt);
+    send_pos  = 0;
+    cli->handle_event(evt); // Executes and writes the prompt without going through the queue
 
     ASSERT_TRUE(command::help_func_fake.call_count);
-    ASSERT_STREQ(ret_str, rcvd_data);
-
-    evt.arg = nullptr;
-    evt.id  = event::ID::control_UpdateCLIState;
-    cli->handle_event(evt);
+    ASSERT_EQ(event::post_fake.call_count, 0u);
 
-    ASSERT_STREQ(rcvd_data, PROMPT);
+    // Echo, command output and prompt all go out in one write
+    ASSERT_EQ(num_sets, 1u);
+    ASSERT_STREQ(rcvd_data, "help\r\r\ntest return\r\n\r\n>");
 }
 
 TEST(ControlCLITest, TrailingSpace)
@@ -287,13 +438,12 @@ TEST(ControlCLITest, TrailingSpace)
     control::CLI *cli = init_cli();
 
     command::help_func_fake.call_count = 0;
-    command::help_func_fake.return_val = (char *)"test\r\n";
     strcpy(rcvd_data, "");
 
     send_cmd(cli, "help ");
     send_cmd(cli, "\n");
 
-    ASSERT_STREQ(PROMPT, rcvd_data);
+    ASSERT_THAT(rcvd_data, testing::EndsWith(PROMPT));
     ASSERT_TRUE(command::help_func_fake.call_count);
 }
 
@@ -302,13 +452,12 @@ TEST(ControlCLITest, Arguments)
     control::CLI *cli = init_cli();
 
     command::help_func_fake.call_count = 0;
-    command::help_func_fake.return_val = (char *)"test\r\n";
     strcpy(rcvd_data, "");
 
     send_cmd(cli, "help arg");
     send_cmd(cli, "\n");
 
-    ASSERT_STREQ(PROMPT, rcvd_data);
+    ASSERT_THAT(rcvd_data, testing::EndsWith(PROMPT));
     ASSERT_TRUE(command::help_func_fake.call_count);
 }
 
@@ -317,13 +466,12 @@ TEST(ControlCLITest, ArgumentTrailingSpace)
     control::CLI *cli = init_cli();
 
     command::help_func_fake.call_count = 0;
-    command::help_func_fake.return_val = (char *)"test\r\n";
     strcpy(rcvd_data, "");
 
     send_cmd(cli, "help arg ");
     send_cmd(cli, "\n");
 
-    ASSERT_STREQ(PROMPT, rcvd_data);
+    ASSERT_THAT(rcvd_data, testing::EndsWith(PROMPT));
     ASSERT_TRUE(command::help_func_fake.call_count);
 }
 
@@ -332,7 +480,6 @@ TEST(ControlCLITest, Backspace)
     control::CLI *cli = init_cli();
 
     command::help_func_fake.call_count = 0;
-    command::help_func_fake.return_val = (char *)"test\r\n";
     strcpy(rcvd_data, "");
 
     send_cmd(cli, "help");
@@ -341,12 +488,14 @@ TEST(ControlCLITest, Backspace)
 
     event::Event evt;
     evt.id    = event::ID::control_UARTInput;
+    evt.arg   = (void *)uart::VirtualPort::UART_CLI;
     send_data = cmd_str;
+    send_pos  = 0;
     cli->handle_event(evt);
 
     send_cmd(cli, "\n");
 
-    ASSERT_STREQ(PROMPT, rcvd_data);
+    ASSERT_THAT(rcvd_data, testing::EndsWith(PROMPT));
     ASSERT_FALSE(command::help_func_fake.call_count);
 }
 
@@ -355,17 +504,18 @@ TEST(ControlCLITest, NullBackspace)
     control::CLI *cli = init_cli();
 
     command::help_func_fake.call_count = 0;
-    command::help_func_fake.return_val = (char *)"test\r\n";
     strcpy(rcvd_data, "");
 
     char cmd_str[] = "\x7F";
 
     event::Event evt;
     evt.id    = event::ID::control_UARTInput;
+    evt.arg   = (void *)uart::VirtualPort::UART_CLI;
     send_data = cmd_str;
+    send_pos  = 0;
     cli->handle_event(evt);
 
-    ASSERT_STREQ(PROMPT, rcvd_data);
+    ASSERT_THAT(rcvd_data, testing::EndsWith(PROMPT));
 }
 
 TEST(ControlCLITest, Up)
@@ -373,13 +523,11 @@ TEST(ControlCLITest, Up)
     control::CLI *cli = init_cli();
 
     command::help_func_fake.call_count = 0;
-    command::help_func_fake.return_val = (char *)"test\r\n";
     strcpy(rcvd_data, "");
 
     send_cmd(cli, "help\n");
 
     command::help_func_fake.call_count = 0;
-    command::help_func_fake.return_val = (char *)"test\r\n";
     strcpy(rcvd_data, "");
 
     const char up_arrow[] = { 0x1B, 0x5B, 0x41, 0x00 };
@@ -387,7 +535,7 @@ TEST(ControlCLITest, Up)
 
     send_cmd(cli, "\n");
 
-    ASSERT_STREQ(PROMPT, rcvd_data);
+    ASSERT_THAT(rcvd_data, testing::EndsWith(PROMPT));
     ASSERT_TRUE(command::help_func_fake.call_count);
 }
 
@@ -396,7 +544,6 @@ TEST(ControlCLITest, Down)
     control::CLI *cli = init_cli();
 
     command::help_func_fake.call_count = 0;
-    command::help_func_fake.return_val = (char *)"test\r\n";
     strcpy(rcvd_data, "");
 
     send_cmd(cli, "help");
@@ -404,11 +551,9 @@ TEST(ControlCLITest, Down)
     const char down_arrow[] = { 0x1B, 0x5B, 0x42, 0x00 };
     send_cmd(cli, down_arrow);
 
-    exec_cmd(cli);
-
     send_cmd(cli, "\n");
 
-    ASSERT_STREQ(PROMPT, rcvd_data);
+    ASSERT_THAT(rcvd_data, testing::EndsWith(PROMPT));
     ASSERT_FALSE(command::help_func_fake.call_count);
 }
 
@@ -419,15 +564,12 @@ TEST(ControlCLITest, TabList)
     command::tab_one_fake.call_count = 0;
     command::tab_two_fake.call_count = 0;
 
-    command::tab_one_fake.return_val = (char *)"test\r\n";
-    command::tab_two_fake.return_val = (char *)"test\r\n";
-
     strcpy(rcvd_data, "");
 
     send_cmd(cli, "tab\t");
     send_cmd(cli, "\n");
 
-    ASSERT_STREQ(PROMPT, rcvd_data);
+    ASSERT_THAT(rcvd_data, testing::EndsWith(PROMPT));
     ASSERT_FALSE(command::tab_one_fake.call_count);
     ASSERT_FALSE(command::tab_two_fake.call_count);
 }
@@ -437,23 +579,35 @@ TEST(ControlCLITest, TabComplete)
     control::CLI *cli = init_cli();
 
     command::tab_one_fake.call_count = 0;
-    command::tab_one_fake.return_val = (char *)"test\r\n";
     strcpy(rcvd_data, "");
 
     send_cmd(cli, "tab-o\t");
     send_cmd(cli, "\n");
 
-    ASSERT_STREQ(PROMPT, rcvd_data);
+    ASSERT_THAT(rcvd_data, testing::EndsWith(PROMPT));
     ASSERT_TRUE(command::tab_one_fake.call_count);
     ASSERT_FALSE(command::tab_two_fake.call_count);
 }
 
+TEST(ControlCLITest, TabCompleteCommonPrefix)
+{
+    control::CLI *cli = init_cli();
+
+    command::tab_two_fake.call_count = 0;
+    strcpy(rcvd_data, "");
+
+    send_cmd(cli, "ta\t");
+    send_cmd(cli, "two\n");
+
+    ASSERT_THAT(rcvd_data, testing::EndsWith(PROMPT));
+    ASSERT_TRUE(command::tab_two_fake.call_count);
+}
+
 TEST(ControlCLITest, TabCompleteEmpty)
 {
     control::CLI *cli = init_cli();
 
     command::tab_one_fake.call_count = 0;
-    command::tab_one_fake.return_val = (char *)"test\r\n";
     strcpy(rcvd_data, "");
 
     send_cmd(cli, "\n");
@@ -471,8 +625,8 @@ TEST(ControlCLITest, CRLF)
     send_cmd(cli, "\r");
     send_cmd(cli, "\n");
 
-    ASSERT_STREQ(PROMPT, rcvd_data);
-    ASSERT_TRUE(event::post_fake.call_count > 2);
+    ASSERT_THAT(rcvd_data, testing::EndsWith(PROMPT));
+    ASSERT_EQ(event::post_fake.call_count, 0u);
 }
 
 TEST(ControlCLITest, TooLong)
@@ -527,6 +681,174 @@ TEST(ControlCLITest, MaxArgs)
     send_cmd(cli, (const char *)str);
 }
 
+TEST(ControlCLITest, InputAfterCommand)
+{
+    control::CLI *cli = init_cli();
+
+    command::help_func_fake.call_count = 0;
+    command::tab_one_fake.call_count   = 0;
+
+    send_cmd(cli, "help\rtab-one\r");
+
+    ASSERT_TRUE(command::help_func_fake.call_count);
+    ASSERT_FALSE(command::tab_one_fake.call_count);
+    ASSERT_EQ(event::post_fake.arg0_val, event::ID::control_UARTInput);
+    ASSERT_EQ(event::post_fake.arg1_val, (void *)uart::VirtualPort::UART_CLI);
+
+    event::Event evt;
+    evt.id  = event::ID::control_UARTInput;
+    evt.arg = (void *)uart::VirtualPort::UART_CLI;
+    cli->handle_event(evt);
+
+    ASSERT_TRUE(command::tab_one_fake.call_count);
+}
+
+TEST(ControlCLITest, IgnoresOtherPorts)
+{
+    control::CLI *cli = init_cli();
+
+    command::help_func_fake.call_count = 0;
+
+    event::Event evt;
+    evt.id    = event::ID::control_UARTInput;
+    evt.arg   = (void *)uart::VirtualPort::UART_AUX;
+    send_data = "help\r";
+    send_pos  = 0;
+    cli->handle_event(evt);
+
+    ASSERT_FALSE(command::help_func_fake.call_count);
+
+    evt.arg = (void *)uart::VirtualPort::UART_CLI;
+    cli->handle_event(evt);
+
+    ASSERT_TRUE(command::help_func_fake.call_count);
+}
+
+TEST(ControlCLITest, ResumeCommand)
+{
+    control::CLI *cli = init_cli();
+
+    bool pending_seq[] = { true, true, false };
+    SET_RETURN_SEQ(command::pending, pending_seq, 3);
+    RESET_FAKE(command::resume);
+    RESET_FAKE(event::post);
+    command::help_func_fake.call_count = 0;
+
+    send_cmd(cli, "help\n"); // Executes, then yields before the first slice
+
+    ASSERT_TRUE(command::help_func_fake.call_count);
+    ASSERT_EQ(command::resume_fake.call_count, 0u);
+    ASSERT_EQ(event::post_fake.call_count, 1u);
+    ASSERT_EQ(event::post_fake.arg0_val, event::ID::control_UpdateCLIState);
+
+    event::Event evt;
+    evt.id  = event::ID::control_UARTInput; // Must wait until the command is done
+    evt.arg = (void *)uart::VirtualPort::UART_CLI;
+    RESET_FAKE(control::recall_override);
+    ASSERT_EQ(cli->handle_event(evt), control::HandleStatus::Deferred);
+    ASSERT_EQ(command::resume_fake.call_count, 0u);
+    ASSERT_EQ(event::post_fake.call_count, 1u);
+
+    evt.arg = nullptr;
+    evt.id  = event::ID::control_UpdateCLIState;
+    cli->handle_event(evt);
+    ASSERT_EQ(command::resume_fake.call_count, 1u);
+    ASSERT_EQ(event::post_fake.call_count, 2u); // Yields again
+    ASSERT_EQ(control::recall_override_fake.call_count, 0u);
+
+    strcpy(rcvd_data, "");
+    cli->handle_event(evt); // Last slice, then the prompt
+    ASSERT_EQ(command::resume_fake.call_count, 2u);
+    ASSERT_EQ(event::post_fake.call_count, 2u);
+    ASSERT_THAT(rcvd_data, testing::EndsWith(PROMPT));
+    ASSERT_TRUE(control::recall_override_fake.call_count); // Deferred input can be handled now
+
+    RESET_FAKE(command::pending);
+}
+
+TEST(ControlCLITest, BinaryMode)
+{
+    control::CLI *cli = init_cli();
+
+    ASSERT_TRUE(protocol::init_fake.call_count);
+
+    RESET_FAKE(protocol::start);
+    RESET_FAKE(protocol::receive);
+    protocol::start_fake.custom_fake   = binary_start;
+    protocol::active_fake.custom_fake  = binary_active;
+    protocol::receive_fake.custom_fake = binary_receive;
+    command::help_func_fake.call_count = 0;
+
+    // Delimiter enters binary mode, the host protocol gets everything up to 'x' (where the fake
+    // leaves binary mode), then the rest is a text command again.
+    const char data[] = { '\0', 'a', 'b', 'x', 'h', 'e', 'l', 'p', '\r' };
+
+    event::Event evt;
+    evt.id    = event::ID::control_UARTInput;
+    evt.arg   = (void *)uart::VirtualPort::UART_CLI;
+    send_data = data;
+    send_pos  = 0;
+    send_len  = sizeof(data);
+    cli->handle_event(evt);
+    send_len = 0;
+
+    ASSERT_EQ(protocol::start_fake.call_count, 1u);
+    ASSERT_EQ(protocol::receive_fake.call_count, 1u);
+    ASSERT_EQ(protocol::receive_fake.arg1_val, sizeof(data) - 1);
+    ASSERT_EQ(send_pos, sizeof(data));
+    ASSERT_TRUE(command::help_func_fake.call_count);
+
+    RESET_FAKE(protocol::start);
+    RESET_FAKE(protocol::active);
+    RESET_FAKE(protocol::receive);
+}
+
+TEST(ControlCLITest, BinaryResumeCommand)
+{
+    control::CLI *cli = init_cli();
+
+    RESET_FAKE(protocol::receive);
+    RESET_FAKE(protocol::resume);
+    RESET_FAKE(command::resume);
+    RESET_FAKE(event::post);
+    protocol::active_fake.custom_fake  = binary_active;
+    protocol::pending_fake.custom_fake = binary_pending;
+    protocol::resume_fake.custom_fake  = binary_resume;
+    protocol::receive_fake.custom_fake = binary_receive_pending;
+    binary                             = true;
+    strcpy(rcvd_data, "");
+
+    // The fake leaves a command running at 'p', the rest waits until it's done
+    event::Event evt;
+    evt.id    = event::ID::control_UARTInput;
+    evt.arg   = (void *)uart::VirtualPort::UART_CLI;
+    send_data = "apb";
+    send_pos  = 0;
+    cli->handle_event(evt);
+    ASSERT_EQ(protocol::receive_fake.call_count, 1u);
+    ASSERT_EQ(send_pos, 2u);
+    ASSERT_EQ(event::post_fake.call_count, 1u);
+    ASSERT_EQ(event::post_fake.arg0_val, event::ID::control_UpdateCLIState);
+
+    ASSERT_EQ(cli->handle_event(evt), control::HandleStatus::Deferred);
+    ASSERT_EQ(protocol::receive_fake.call_count, 1u);
+
+    evt.arg = nullptr;
+    evt.id  = event::ID::control_UpdateCLIState;
+    cli->handle_event(evt);
+    ASSERT_EQ(protocol::resume_fake.call_count, 1u);
+    ASSERT_EQ(command::resume_fake.call_count, 0u);
+    ASSERT_STREQ(rcvd_data, ""); // No prompt in binary mode
+    ASSERT_EQ(event::post_fake.call_count, 2u);
+    ASSERT_EQ(event::post_fake.arg0_val, event::ID::control_UARTInput); // Rest of the input
+
+    binary = false;
+    RESET_FAKE(protocol::active);
+    RESET_FAKE(protocol::pending);
+    RESET_FAKE(protocol::receive);
+    RESET_FAKE(command::resume);
+}
+
 TEST(ControlCLITest, CLIOutput)
 {
     control::CLI *cli = init_cli();
@@ -541,6 +863,23 @@ TEST(ControlCLITest, CLIOutput)
     ASSERT_STREQ(str, rcvd_data);
 }
 
+TEST(ControlCLITest, IOWatch)
+{
+    control::CLI *cli = init_cli();
+
+    watch::sample_fake.custom_fake = write_sample;
+
+    event::Event evt;
+    evt.id  = event::ID::control_IOWatch;
+    evt.arg = (void *)(uintptr_t)42;
+
+    ASSERT_EQ(cli->handle_event(evt), control::HandleStatus::Handled);
+    ASSERT_EQ(watch::sample_fake.arg1_val, 42u);
+    ASSERT_STREQ(rcvd_data, "42 1\r\n");
+
+    RESET_FAKE(watch::sample);
+}
+
 TEST(ControlCLITest, GetSetParam)
 {
     control::CLI *cli = init_cli();
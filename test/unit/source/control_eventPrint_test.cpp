@@ -12,7 +12,7 @@
 #include "control.hpp"
 #include "event.hpp"
 #include "output.hpp"
-#include "uart.hpp"
+#include "logging.hpp"
 #include "macros.hpp"
 #include "fff.h"
 
@@ -28,7 +28,6 @@
 //  File Variables
 //--------------------------------------------------------------------------------------------------
 
-static uart::UART console;
 
 //--------------------------------------------------------------------------------------------------
 //  Fakes/Mocks
@@ -36,13 +35,9 @@ static uart::UART console;
 
 DEFINE_FFF_GLOBALS;
 
-namespace io
+namespace logging
 {
-    FAKE_VOID_FUNC(print_override, const char *, const char *, IOID, char *, IODirection);
-    void print(const char *io, const char *name, IOID id, char *data, IODirection dir)
-    {
-        print_override(io, name, id, data, dir);
-    }
+    FAKE_VOID_FUNC(record, ID, uint8_t, uint32_t, const uintptr_t *);
 }
 
 namespace input
@@ -77,35 +72,6 @@ namespace output
     {
         cmd_output_override(argc, argv);
     }
-
-    FAKE_VALUE_FUNC(output::Output *, get_by_id, io::IOID);
-}
-
-namespace uart
-{
-    FAKE_VALUE_FUNC(void *, get_by_id_override);
-    void *UART::get_by_id()
-    {
-        return get_by_id_override();
-    }
-
-    FAKE_VOID_FUNC(set_output_override, void *);
-    void UART::set_output(void *data)
-    {
-        set_output_override(data);
-    }
-
-    FAKE_VOID_FUNC(init_override);
-    void UART::init()
-    {
-        init_override();
-    }
-
-    FAKE_VOID_FUNC(print_override, void *, io::IODirection);
-    void UART::print(void *data, io::IODirection dir)
-    {
-        print_override(data, dir);
-    }
 }
 
 namespace event
@@ -146,12 +112,6 @@ static control::EvtPrint *init_ctrl()
 
     if (!inited)
     {
-        console.uart_port   = uart::VirtualPort::UART_CLI;
-        console.id          = io::IOID::UART_CONSOLE;
-        console.output_type = &typeid(const char *);
-
-        output::get_by_id_fake.return_val = (output::Output *)(&console);
-
         ctrl.init_control();
 
         inited = true;
@@ -171,9 +131,15 @@ TEST(ControlEvtPrintTest, Init)
     event::Event evt;
     evt.id = event::ID::control_TestEvent;
 
+    event::QueueInfo info                 = { 2, 5 };
+    event::get_queue_info_fake.return_val = info;
+
     control::HandleStatus ret = ctrl->handle_event(evt);
 
     ASSERT_EQ(ret, control::HandleStatus::NotHandled);
+    ASSERT_EQ(logging::record_fake.call_count, 1u);
+    ASSERT_EQ(logging::record_fake.arg0_val, logging::ID::Event);
+    ASSERT_EQ(logging::record_fake.arg2_val, 4u);
 }
 
 TEST(ControlEvtPrintTest, SetGetParam)
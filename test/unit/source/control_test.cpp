@@ -12,6 +12,7 @@
 #include "control_test.hpp"
 #include "event.hpp"
 #include "macros.hpp"
+#include "state_machine.hpp"
 #include "fff.h"
 
 #include <gtest/gtest.h>
@@ -29,6 +30,31 @@
 event::Event          rcvd_event_1;
 event::Event          rcvd_event_2;
 control::HandleStatus ret_status;
+uint32_t              num_rcvd_1 = 0;
+
+char list[1024];
+
+// Top --+-- A --+-- A1
+//       |       +-- A2
+//       +-- B ----- B1
+//       +-- Loop1
+//       +-- Loop2
+enum class TestState
+{
+    Top,
+    A,
+    A1,
+    A2,
+    B,
+    B1,
+    Loop1,
+    Loop2,
+    NumStates
+};
+
+state_machine::Machine<TestState> machine;
+
+char trace[256]; // Actions run by the machine, in order
 
 //--------------------------------------------------------------------------------------------------
 //  Fakes/Mocks
@@ -57,6 +83,7 @@ namespace control
     HandleStatus TestControl1::handle_event(event::Event evt)
     {
         rcvd_event_1 = evt;
+        num_rcvd_1++;
 
         return ret_status;
     }
@@ -81,6 +108,129 @@ namespace control
 //  Private Functions
 //--------------------------------------------------------------------------------------------------
 
+void capture_list(void *context, const char *chunk)
+{
+    UNUSED(context);
+
+    strncat(list, chunk, sizeof(list) - strlen(list) - 1);
+}
+
+void add_trace(const char *action)
+{
+    strncat(trace, action, sizeof(trace) - strlen(trace) - 1);
+    strncat(trace, " ", sizeof(trace) - strlen(trace) - 1);
+}
+
+void enter_A()
+{
+    add_trace("eA");
+}
+
+void exit_A()
+{
+    add_trace("xA");
+}
+
+void enter_A1()
+{
+    add_trace("eA1");
+}
+
+void exit_A1()
+{
+    add_trace("xA1");
+}
+
+void enter_A2()
+{
+    add_trace("eA2");
+}
+
+void exit_A2()
+{
+    add_trace("xA2");
+}
+
+void enter_B()
+{
+    add_trace("eB");
+}
+
+void exit_B()
+{
+    add_trace("xB");
+}
+
+void enter_B1()
+{
+    add_trace("eB1");
+}
+
+void exit_B1()
+{
+    add_trace("xB1");
+}
+
+void enter_Loop1()
+{
+    machine.transition(TestState::Loop2);
+}
+
+void enter_Loop2()
+{
+    machine.transition(TestState::Loop1);
+}
+
+// Handles everything its children don't
+control::HandleStatus handle_Top(event::Event evt)
+{
+    UNUSED(evt);
+
+    add_trace("hTop");
+    return control::HandleStatus::Handled;
+}
+
+// Arg 1 moves to B1, arg 2 is handled in place, anything else goes to Top
+control::HandleStatus handle_A(event::Event evt)
+{
+    if (evt.arg == (void *)1)
+    {
+        machine.transition(TestState::B1);
+        add_trace("hA");
+        return control::HandleStatus::Handled;
+    }
+
+    if (evt.arg == (void *)2)
+    {
+        add_trace("hA");
+        return control::HandleStatus::Handled;
+    }
+
+    return control::HandleStatus::NotHandled;
+}
+
+// Leaves everything to A
+control::HandleStatus handle_A1(event::Event evt)
+{
+    UNUSED(evt);
+
+    add_trace("hA1");
+    return control::HandleStatus::NotHandled;
+}
+
+// Format: { PARENT, ENTRY, EXIT, HANDLE }. Must be in the same order as TestState.
+constexpr state_machine::State<TestState> test_states[] = {
+    { TestState::NumStates, nullptr, nullptr, handle_Top },
+    { TestState::Top, enter_A, exit_A, handle_A },
+    { TestState::A, enter_A1, exit_A1, handle_A1 },
+    { TestState::A, enter_A2, exit_A2, nullptr },
+    { TestState::Top, enter_B, exit_B, nullptr },
+    { TestState::B, enter_B1, exit_B1, nullptr },
+    { TestState::Top, enter_Loop1, nullptr, nullptr },
+    { TestState::Top, enter_Loop2, nullptr, nullptr },
+};
+
+static_assert(sizeof(test_states) / sizeof(test_states[0]) == (uint32_t)TestState::NumStates);
 
 //--------------------------------------------------------------------------------------------------
 //  Tests
@@ -120,7 +270,7 @@ TEST(ControlTest, HandleStatus)
 {
     control::open();
 
-    control::TestControl2 ctrl_override;
+    control::TestControl2 ctrl_override {};
     event::Event          evt;
 
     rcvd_event_1.id       = event::ID::NullEvent;
@@ -144,6 +294,49 @@ TEST(ControlTest, HandleStatus)
     ASSERT_EQ(rcvd_event_2.id, event::ID::control_TestEvent);
 }
 
+TEST(ControlTest, ParkEvent)
+{
+    control::open();
+
+    control::Control *ctrl = control_test::get_controls()[0];
+    event::Event      evt;
+
+    rcvd_event_2.id = event::ID::NullEvent;
+    evt.id          = event::ID::control_TestEvent;
+    evt.arg         = (void *)1;
+    num_rcvd_1      = 0;
+
+    ret_status = control::HandleStatus::Deferred;
+    control::disperse_event(evt);
+    control::disperse_event(evt); // Already parked
+    ASSERT_EQ(num_rcvd_1, 2u);
+    ASSERT_EQ(ctrl->num_parked, 1u);
+    ASSERT_EQ(rcvd_event_2.id, event::ID::NullEvent);
+
+    ret_status = control::HandleStatus::Handled;
+    ctrl->recall();
+    evt.arg = (void *)2;
+    control::disperse_event(evt); // Handled, then the parked event is redelivered
+    ASSERT_EQ(num_rcvd_1, 4u);
+    ASSERT_EQ(rcvd_event_1.arg, (void *)1);
+    ASSERT_EQ(ctrl->num_parked, 0u);
+
+    control::disperse_event(evt); // Nothing left to redeliver
+    ASSERT_EQ(num_rcvd_1, 5u);
+
+    ret_status = control::HandleStatus::Deferred;
+    for (uint32_t i = 0; i < control::MAX_PARKED; i++)
+    {
+        evt.arg = (void *)(uintptr_t)i;
+        control::disperse_event(evt);
+    }
+
+    evt.arg = (void *)(uintptr_t)control::MAX_PARKED;
+    TEST_ERROR(control::disperse_event(evt));
+
+    ctrl->num_parked = 0;
+}
+
 TEST(ControlTest, GetControlPreCond)
 {
     TEST_ERROR(control::get_control_by_name(nullptr));
@@ -164,9 +357,15 @@ TEST(ControlTest, GetList)
 {
     control::open();
 
-    char *list = control::get_list_of_controls();
+    list[0] = '\0';
+
+    utility::Writer out;
+    out.init(capture_list, nullptr);
+    control::write_list_of_controls(&out);
+    out.flush();
 
-    ASSERT_NE(list, nullptr);
+    control::Control *test_control = control_test::get_controls()[0];
+    ASSERT_NE(strstr(list, test_control->name), nullptr);
 }
 
 TEST(ControlTest, GetSetParam)
@@ -176,4 +375,83 @@ TEST(ControlTest, GetSetParam)
     control::set_param(settings::ID::TestInt, 0, false);
 }
 
+
+TEST(ControlTest, StateMachineInit)
+{
+    trace[0] = '\0';
+    machine.init(test_states, TestState::A1);
+
+    ASSERT_STREQ(trace, "eA eA1 ");
+    ASSERT_EQ(machine.state(), TestState::A1);
+    ASSERT_TRUE(machine.in(TestState::A));
+    ASSERT_TRUE(machine.in(TestState::Top));
+    ASSERT_FALSE(machine.in(TestState::B));
+}
+
+TEST(ControlTest, StateMachineTransition)
+{
+    machine.init(test_states, TestState::A1);
+
+    trace[0] = '\0';
+    machine.transition(TestState::A2); // Common ancestor A is left in place
+    ASSERT_STREQ(trace, "xA1 eA2 ");
+
+    trace[0] = '\0';
+    machine.transition(TestState::B1); // Exited up to Top, then entered down from it
+    ASSERT_STREQ(trace, "xA2 xA eB eB1 ");
+    ASSERT_EQ(machine.state(), TestState::B1);
+
+    trace[0] = '\0';
+    machine.transition(TestState::B1); // Self transition exits and re-enters
+    ASSERT_STREQ(trace, "xB1 eB1 ");
+
+    trace[0] = '\0';
+    machine.transition(TestState::B); // Transition to an ancestor exits and re-enters it
+    ASSERT_STREQ(trace, "xB1 xB eB ");
+    ASSERT_EQ(machine.state(), TestState::B);
+}
+
+TEST(ControlTest, StateMachineDispatch)
+{
+    machine.init(test_states, TestState::A1);
+
+    event::Event evt;
+    evt.id = event::ID::control_TestEvent;
+
+    trace[0] = '\0';
+    evt.arg  = (void *)2; // A1 doesn't handle it, so it goes to A
+    ASSERT_EQ(machine.dispatch(evt), control::HandleStatus::Handled);
+    ASSERT_STREQ(trace, "hA1 hA ");
+
+    trace[0] = '\0';
+    evt.arg  = (void *)3; // Neither A1 nor A handle it, so it goes to Top
+    ASSERT_EQ(machine.dispatch(evt), control::HandleStatus::Handled);
+    ASSERT_STREQ(trace, "hA1 hTop ");
+
+    trace[0] = '\0';
+    evt.arg  = (void *)1; // Transition runs once the handler returns, before dispatch does
+    ASSERT_EQ(machine.dispatch(evt), control::HandleStatus::Handled);
+    ASSERT_STREQ(trace, "hA1 hA xA1 xA eB eB1 ");
+    ASSERT_EQ(machine.state(), TestState::B1);
+
+    trace[0] = '\0';
+    evt.arg  = (void *)2; // B1 and B have no handler
+    ASSERT_EQ(machine.dispatch(evt), control::HandleStatus::Handled);
+    ASSERT_STREQ(trace, "hTop ");
+}
+
+TEST(ControlTest, StateMachineTooManyTransitions)
+{
+    machine.init(test_states, TestState::A1);
+
+    TEST_ERROR(machine.transition(TestState::Loop1)); // Entry actions transition back and forth
+}
+
+TEST(ControlTest, StateMachinePreCond)
+{
+    machine.init(test_states, TestState::A1);
+
+    TEST_ERROR(machine.transition(TestState::NumStates));
+}
+
 // End of File
\ No newline at end of file
@@ -0,0 +1,210 @@
+/// @file cpu_usage_test.cpp
+/// @author Denver Hoggatt
+/// @brief Unit tests for CPU usage.
+///
+/// Copyright (c) 2025 Denver Hoggatt. All rights reserved.
+///
+/// This software is licensed under terms that can be found in the LICENSE file
+/// in the root directory of this software component.
+/// If no LICENSE file comes with this software, it is provided AS-IS.
+///
+
+#include "cpu_usage.hpp"
+#include "mutex.hpp"
+#include "periodic.hpp"
+#include "systime.hpp"
+#include "task_osal.hpp"
+#include "macros.hpp"
+#include "fff.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cstring>
+
+//--------------------------------------------------------------------------------------------------
+//  Private Constants
+//--------------------------------------------------------------------------------------------------
+
+constexpr uint32_t IDLE_NUMBER = 4;
+
+//--------------------------------------------------------------------------------------------------
+//  File Variables
+//--------------------------------------------------------------------------------------------------
+
+char     captured[2048];
+uint32_t captured_len = 0;
+
+// What the RTOS reports next
+task_osal::RunStats rtos_stats[cpu_usage::MAX_TASKS];
+uint32_t            rtos_num_tasks = 0;
+uint32_t            rtos_time      = 0;
+uint32_t            rtos_wakes     = 0;
+
+//--------------------------------------------------------------------------------------------------
+//  Fakes/Mocks
+//--------------------------------------------------------------------------------------------------
+
+DEFINE_FFF_GLOBALS;
+
+namespace task_osal
+{
+    FAKE_VALUE_FUNC(uint32_t, get_run_stats, RunStats *, uint32_t, uint32_t *);
+    FAKE_VALUE_FUNC(uint32_t, get_idle_wakes);
+}
+
+namespace mutex
+{
+    FAKE_VOID_FUNC(take, ID);
+    FAKE_VOID_FUNC(give, ID);
+}
+
+namespace periodic
+{
+    FAKE_VOID_FUNC(start, ID);
+    FAKE_VOID_FUNC(create, ID, CallbackFunc);
+}
+
+namespace systime
+{
+    FAKE_VALUE_FUNC(uint32_t, ticks_to_us, uint32_t);
+}
+
+//--------------------------------------------------------------------------------------------------
+//  Private Functions
+//--------------------------------------------------------------------------------------------------
+
+uint32_t get_rtos_stats(task_osal::RunStats *stats, uint32_t max_stats, uint32_t *total_time)
+{
+    EXPECT_GE(max_stats, rtos_num_tasks);
+
+    memcpy(stats, rtos_stats, rtos_num_tasks * sizeof(rtos_stats[0]));
+    *total_time = rtos_time;
+
+    task_osal::get_idle_wakes_fake.return_val = rtos_wakes;
+
+    return rtos_num_tasks;
+}
+
+uint32_t ticks_as_us(uint32_t ticks)
+{
+    return ticks;
+}
+
+void capture_chunk(void *context, const char *chunk)
+{
+    UNUSED(context);
+
+    uint32_t len = strlen(chunk);
+    ASSERT_LT(captured_len + len, sizeof(captured));
+
+    memcpy(&captured[captured_len], chunk, len + 1);
+    captured_len += len;
+}
+
+const char *write_usage()
+{
+    captured[0]  = '\0';
+    captured_len = 0;
+
+    utility::Writer out;
+    out.init(capture_chunk, nullptr);
+    cpu_usage::write(&out);
+    out.flush();
+
+    return captured;
+}
+
+/// @brief Sets what the RTOS reports for a task.
+///
+void set_task(uint32_t index, uint32_t number, const char *name, uint32_t run, uint32_t switches)
+{
+    rtos_stats[index].number   = number;
+    rtos_stats[index].name     = name;
+    rtos_stats[index].run_time = run;
+    rtos_stats[index].switches = switches;
+}
+
+void reset()
+{
+    RESET_FAKE(task_osal::get_run_stats);
+    RESET_FAKE(task_osal::get_idle_wakes);
+    RESET_FAKE(mutex::take);
+    RESET_FAKE(mutex::give);
+    RESET_FAKE(periodic::start);
+    RESET_FAKE(periodic::create);
+    RESET_FAKE(systime::ticks_to_us);
+
+    task_osal::get_run_stats_fake.custom_fake = get_rtos_stats;
+    systime::ticks_to_us_fake.custom_fake     = ticks_as_us;
+}
+
+//--------------------------------------------------------------------------------------------------
+//  Tests
+//--------------------------------------------------------------------------------------------------
+
+TEST(CPUUsageTest, Window)
+{
+    reset();
+
+    // Start of the window
+    rtos_num_tasks = 2;
+    rtos_time      = 0xFFFFF000; // Run time counter is about to wrap
+    rtos_wakes     = 100;
+    set_task(0, 1, "Task0", 0xFFFFF000, 10);
+    set_task(1, IDLE_NUMBER, "IDLE", 0, 5);
+
+    cpu_usage::init();
+    ASSERT_EQ(periodic::create_fake.arg0_val, periodic::ID::CPUSample);
+    ASSERT_EQ(periodic::start_fake.arg0_val, periodic::ID::CPUSample);
+
+    // 10ms on, 2.5ms in Task0, 7.5ms idle, and a task that started in the middle of the window
+    rtos_num_tasks = 3;
+    rtos_time      = 0xFFFFF000 + 10000;
+    rtos_wakes     = 105;
+    set_task(0, 1, "Task0", 0xFFFFF000 + 2500, 12);
+    set_task(1, IDLE_NUMBER, "IDLE", 7500, 8);
+    set_task(2, 5, "Tmr Svc", 0, 1);
+
+    const char *ret_val = write_usage();
+    ASSERT_NE(strstr(ret_val, "over the last 10 ms"), nullptr);
+    ASSERT_NE(strstr(ret_val, "Task0               25.0%          2\r\n"), nullptr);
+    ASSERT_NE(strstr(ret_val, "IDLE                75.0%          3\r\n"), nullptr);
+    ASSERT_NE(strstr(ret_val, "Tmr Svc              0.0%          1\r\n"), nullptr);
+    ASSERT_NE(strstr(ret_val, "Idle wake ups: 5 (500/s)\r\n"), nullptr);
+    ASSERT_EQ(mutex::take_fake.call_count, mutex::give_fake.call_count);
+}
+
+TEST(CPUUsageTest, Slide)
+{
+    reset();
+
+    rtos_num_tasks = 1;
+    set_task(0, IDLE_NUMBER, "IDLE", 0, 0);
+
+    cpu_usage::init();
+    periodic::CallbackFunc callback = periodic::create_fake.arg1_val;
+
+    // Fill the window with samples a second apart, with one more to push the first one out
+    for (uint32_t i = 1; i <= cpu_usage::WINDOW_SAMPLES; i++)
+    {
+        rtos_time = i * 1000000;
+        set_task(0, IDLE_NUMBER, "IDLE", rtos_time, 0);
+        callback(0);
+    }
+
+    // Window starts at the oldest sample kept, i.e. the second one
+    rtos_time += 1000000;
+    set_task(0, IDLE_NUMBER, "IDLE", rtos_time, 0);
+
+    const char *ret_val = write_usage();
+    ASSERT_NE(strstr(ret_val, "over the last 5000 ms"), nullptr);
+    ASSERT_NE(strstr(ret_val, "IDLE               100.0%"), nullptr);
+}
+
+TEST(CPUUsageTest, InvalidWriter)
+{
+    TEST_ERROR(cpu_usage::write(nullptr));
+}
+
+// End of File
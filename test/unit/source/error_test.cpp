@@ -53,6 +53,7 @@ TEST(ErrorTest, RequireFail)
 {
     bool test_val = false;
     TEST_ERROR(REQUIRE(test_val, error::TestFailed));
+    ASSERT_FALSE(error::handling()); // Execution carried on past it
 }
 
 TEST(ErrorTest, InvariantPass)
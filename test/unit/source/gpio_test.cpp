@@ -11,6 +11,7 @@
 
 #include "gpio_hal.hpp"
 #include "error.hpp"
+#include "logging.hpp"
 #include "macros.hpp"
 #include "fff.h"
 
@@ -35,13 +36,9 @@ bool init_output_called;
 
 DEFINE_FFF_GLOBALS;
 
-namespace io
+namespace logging
 {
-    FAKE_VOID_FUNC(print_override, const char *, const char *, IOID, char *, IODirection);
-    void print(const char *io, const char *name, IOID id, char *data, IODirection dir)
-    {
-        print_override(io, name, id, data, dir);
-    }
+    FAKE_VOID_FUNC(record, ID, uint8_t, uint32_t, const uintptr_t *);
 }
 
 namespace input
@@ -118,10 +115,15 @@ TEST(GPIOTest, OutputData)
     gpio::GPIO test_gpio = gpio::GPIO();
     test_gpio.init();
 
+    RESET_FAKE(logging::record);
+
     test_gpio.print_io = true;
     test_gpio.set<bool>(true);
     ASSERT_EQ(gpio_hal::set_fake.call_count, 1);
     ASSERT_EQ(gpio_hal::reset_fake.call_count, 0);
+    ASSERT_EQ(logging::record_fake.call_count, 1u);
+    ASSERT_EQ(logging::record_fake.arg0_val, logging::ID::GPIOSent);
+    ASSERT_EQ(logging::record_fake.arg2_val, 3u);
 
     RESET_FAKE(gpio_hal::set);
     RESET_FAKE(gpio_hal::reset);
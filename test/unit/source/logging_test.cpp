@@ -0,0 +1,312 @@
+/// @file logging_test.cpp
+/// @author Denver Hoggatt
+/// @brief Unit tests for deferred logging.
+///
+/// Copyright (c) 2025 Denver Hoggatt. All rights reserved.
+///
+/// This software is licensed under terms that can be found in the LICENSE file
+/// in the root directory of this software component.
+/// If no LICENSE file comes with this software, it is provided AS-IS.
+///
+
+#include "logging.hpp"
+#include "isr_hal.hpp"
+#include "periodic.hpp"
+#include "protocol.hpp"
+#include "task.hpp"
+#include "uart.hpp"
+#include "macros.hpp"
+#include "fff.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cstring>
+
+//--------------------------------------------------------------------------------------------------
+//  Private Constants
+//--------------------------------------------------------------------------------------------------
+
+constexpr uint16_t TEST_CRC = 0xBEEF;
+
+//--------------------------------------------------------------------------------------------------
+//  File Variables
+//--------------------------------------------------------------------------------------------------
+
+uint8_t  sent[4096];
+uint32_t sent_len = 0;
+
+//--------------------------------------------------------------------------------------------------
+//  Fakes/Mocks
+//--------------------------------------------------------------------------------------------------
+
+DEFINE_FFF_GLOBALS;
+
+namespace protocol
+{
+    FAKE_VALUE_FUNC(uint16_t, crc16, const uint8_t *, uint32_t);
+    FAKE_VALUE_FUNC(uint32_t, cobs_encode, const uint8_t *, uint32_t, uint8_t *);
+}
+
+namespace uart
+{
+    FAKE_VALUE_FUNC(bool, write_stdout, const char *, uint32_t);
+}
+
+namespace periodic
+{
+    FAKE_VOID_FUNC(start, ID);
+    FAKE_VOID_FUNC(stop, ID);
+    FAKE_VOID_FUNC(create, ID, CallbackFunc);
+}
+
+namespace isr_hal
+{
+    FAKE_VALUE_FUNC(bool, is_in_interrupt);
+}
+
+namespace task
+{
+    FAKE_VOID_FUNC(send_signal, ID, Signal);
+}
+
+//--------------------------------------------------------------------------------------------------
+//  Private Functions
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Leaves frames unencoded, so the tests can read them as-is.
+///
+uint32_t copy_frame(const uint8_t *data, uint32_t len, uint8_t *encoded)
+{
+    memcpy(encoded, data, len);
+
+    return len;
+}
+
+bool capture_write(const char *data, uint32_t len)
+{
+    EXPECT_LT(sent_len + len, sizeof(sent));
+
+    memcpy(&sent[sent_len], data, len);
+    sent_len += len;
+
+    return true;
+}
+
+/// @brief Sends anything left over from the last test, and starts capturing from scratch.
+///
+void reset()
+{
+    RESET_FAKE(protocol::crc16);
+    RESET_FAKE(protocol::cobs_encode);
+    RESET_FAKE(uart::write_stdout);
+    RESET_FAKE(periodic::start);
+    RESET_FAKE(periodic::stop);
+    RESET_FAKE(periodic::create);
+    RESET_FAKE(isr_hal::is_in_interrupt);
+    RESET_FAKE(task::send_signal);
+
+    protocol::crc16_fake.return_val        = TEST_CRC;
+    protocol::cobs_encode_fake.custom_fake = copy_frame;
+    uart::write_stdout_fake.custom_fake    = capture_write;
+
+    logging::flush();
+    sent_len = 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+//  Tests
+//--------------------------------------------------------------------------------------------------
+
+TEST(LoggingTest, ArgTypes)
+{
+    ASSERT_EQ(logging::arg_type<uint32_t>(), logging::ArgType::Int);
+    ASSERT_EQ(logging::arg_type<void *>(), logging::ArgType::Int);
+    ASSERT_EQ(logging::arg_type<float>(), logging::ArgType::Float);
+    ASSERT_EQ(logging::arg_type<const char *>(), logging::ArgType::String);
+    ASSERT_EQ(logging::arg_type<char *>(), logging::ArgType::String);
+
+    ASSERT_EQ((logging::arg_types<uint32_t, const char *, float>()), 0x18);
+    ASSERT_EQ(logging::arg_types<>(), 0);
+}
+
+TEST(LoggingTest, FormatMatches)
+{
+    static_assert(logging::format_matches<uint32_t, const char *, float>("%u %s %f"));
+    static_assert(logging::format_matches<int32_t, void *>("%-4d %% %08p"));
+    static_assert(logging::format_matches<>("100%% done"));
+
+    static_assert(!logging::format_matches<float>("%u"));
+    static_assert(!logging::format_matches<uint32_t>("%s"));
+    static_assert(!logging::format_matches<uint32_t, uint32_t>("%u"));
+    static_assert(!logging::format_matches<uint32_t>("%u %u"));
+    static_assert(!logging::format_matches<uint32_t>("%y"));
+}
+
+TEST(LoggingTest, WriteFlush)
+{
+    reset();
+
+    ASSERT_FALSE(logging::pending());
+
+    logging::write<logging::ID::Test>(300u, "abc", 1.5f);
+    ASSERT_TRUE(logging::pending());
+    ASSERT_EQ(uart::write_stdout_fake.call_count, 0u); // Nothing is sent until flushed
+
+    logging::write<logging::ID::Dropped>(7u);
+    logging::flush();
+    ASSERT_FALSE(logging::pending());
+
+    const uint8_t expected[] = {
+        0x00,                                       // Delimiter
+        (uint8_t)protocol::FrameType::Log, 0x00,    // Header
+        (uint8_t)logging::ID::Test, 0xAC, 0x02,     // 300 as a varint
+        3, 'a', 'b', 'c',                           // String
+        0x00, 0x00, 0xC0, 0x3F,                     // 1.5f
+        (uint8_t)logging::ID::Dropped, 7,           // Second message, same frame
+        (uint8_t)TEST_CRC, (uint8_t)(TEST_CRC >> 8), // CRC
+        0x00,                                       // Delimiter
+    };
+
+    ASSERT_EQ(uart::write_stdout_fake.call_count, 1u);
+    ASSERT_EQ(sent_len, sizeof(expected));
+    ASSERT_EQ(memcmp(sent, expected, sizeof(expected)), 0);
+
+    // Next frame has the next sequence number, and long strings are cut off
+    sent_len = 0;
+    logging::write<logging::ID::Test>(0u, "0123456789012345678901234567890123456789", 0.0f);
+    logging::flush();
+
+    ASSERT_EQ(sent[2], 1);
+    ASSERT_EQ(sent[5], logging::MAX_STR_LEN);
+    ASSERT_EQ(sent_len, 1 + 2 + 2 + 1 + logging::MAX_STR_LEN + 4 + 2 + 1);
+}
+
+TEST(LoggingTest, Full)
+{
+    reset();
+
+    constexpr uint32_t EXTRA = 3;
+    for (uint32_t i = 0; i < logging::RING_SIZE + EXTRA; i++)
+    {
+        logging::write<logging::ID::Dropped>(i);
+    }
+
+    logging::flush();
+    ASSERT_FALSE(logging::pending());
+
+    // The drop count goes first, followed by the messages that made it
+    ASSERT_EQ(sent[3], (uint8_t)logging::ID::Dropped);
+    ASSERT_EQ(sent[4], EXTRA);
+    ASSERT_EQ(sent[5], (uint8_t)logging::ID::Dropped);
+    ASSERT_EQ(sent[6], 0);
+
+    // Still room in the ring after draining it
+    sent_len = 0;
+    logging::write<logging::ID::Dropped>(1u);
+    logging::flush();
+    ASSERT_EQ(sent_len, 1 + 2 + 2 + 2 + 1u);
+}
+
+TEST(LoggingTest, PortClosed)
+{
+    reset();
+
+    logging::write<logging::ID::Dropped>(0u);
+    logging::flush();
+    uint8_t seq = sent[2];
+    sent_len    = 0;
+
+    uart::write_stdout_fake.custom_fake = nullptr;
+    uart::write_stdout_fake.return_val  = false;
+
+    logging::write<logging::ID::Dropped>(1u);
+    logging::write<logging::ID::Dropped>(2u);
+    logging::flush();
+    ASSERT_TRUE(logging::pending()); // Lost messages are still reported
+
+    uart::write_stdout_fake.custom_fake = capture_write;
+    logging::flush();
+
+    ASSERT_EQ(sent[2], seq + 1); // Failed frame doesn't use up a sequence number
+    ASSERT_EQ(sent[3], (uint8_t)logging::ID::Dropped);
+    ASSERT_EQ(sent[4], 2);
+    ASSERT_FALSE(logging::pending());
+}
+
+TEST(LoggingTest, Init)
+{
+    reset();
+
+    logging::init();
+    ASSERT_EQ(periodic::create_fake.arg0_val, periodic::ID::LogDrain);
+    ASSERT_EQ(periodic::start_fake.call_count, 0u); // Nothing logged yet
+
+    periodic::CallbackFunc callback = periodic::create_fake.arg1_val;
+    ASSERT_NE(callback, nullptr);
+
+    logging::write<logging::ID::Test>(1u, "", 0.0f);
+    ASSERT_EQ(periodic::start_fake.call_count, 1u);
+    ASSERT_EQ(periodic::start_fake.arg0_val, periodic::ID::LogDrain);
+
+    logging::write<logging::ID::Test>(2u, "", 0.0f);
+    ASSERT_EQ(periodic::start_fake.call_count, 1u); // Already armed
+
+    callback(20);
+    ASSERT_EQ(periodic::stop_fake.call_count, 1u);
+    ASSERT_EQ(periodic::stop_fake.arg0_val, periodic::ID::LogDrain);
+    ASSERT_EQ(task::send_signal_fake.call_count, 1u);
+    ASSERT_EQ(task::send_signal_fake.arg0_val, task::ID::log);
+    ASSERT_EQ(task::send_signal_fake.arg1_val, task::Signal::GlobalEvent);
+
+    logging::flush();
+    ASSERT_FALSE(logging::pending());
+    ASSERT_EQ(periodic::start_fake.call_count, 1u); // Stays stopped once drained
+
+    callback(40);
+    ASSERT_EQ(task::send_signal_fake.call_count, 1u); // Nothing to send
+}
+
+TEST(LoggingTest, ArmFromISR)
+{
+    reset();
+    logging::init();
+
+    isr_hal::is_in_interrupt_fake.return_val = true;
+    logging::write<logging::ID::Test>(1u, "", 0.0f);
+    isr_hal::is_in_interrupt_fake.return_val = false;
+
+    ASSERT_EQ(periodic::start_fake.call_count, 0u);
+    ASSERT_EQ(task::send_signal_fake.call_count, 1u);
+    ASSERT_EQ(task::send_signal_fake.arg0_val, task::ID::log);
+    ASSERT_EQ(task::send_signal_fake.arg1_val, task::Signal::GlobalEvent);
+
+    logging::flush();
+}
+
+TEST(LoggingTest, RearmWhenPortClosed)
+{
+    reset();
+    logging::init();
+
+    uart::write_stdout_fake.custom_fake = nullptr;
+    uart::write_stdout_fake.return_val  = false;
+
+    logging::write<logging::ID::Test>(1u, "", 0.0f);
+    RESET_FAKE(periodic::start);
+
+    logging::flush();
+    ASSERT_TRUE(logging::pending()); // Dropped count still to send
+    ASSERT_EQ(periodic::start_fake.call_count, 1u);
+
+    uart::write_stdout_fake.custom_fake = capture_write;
+    logging::flush();
+    ASSERT_FALSE(logging::pending());
+}
+
+TEST(LoggingTest, InvalidID)
+{
+    TEST_ERROR(logging::record(logging::ID::NumIDs, 0, 0, nullptr)); // write() won't compile
+}
+
+// End of File
@@ -28,6 +28,7 @@
 output::Output *output_list[2];
 void           *outputted_data;
 bool            has_outputted = false;
+uint32_t        output_count  = 0;
 
 //--------------------------------------------------------------------------------------------------
 //  Fakes/Mocks
@@ -42,6 +43,7 @@ class TestOutput : public output::Output
         {
             has_outputted  = true;
             outputted_data = data;
+            output_count++;
         }
 
         void print(void *data, io::IODirection dir)
@@ -127,6 +129,34 @@ TEST(OutputTest, SetOutput)
     ASSERT_STREQ(str, test_str);
 }
 
+TEST(OutputTest, StagedOutput)
+{
+    TestOutput out1  = TestOutput();
+    out1.output_type = &typeid(uint32_t);
+    out1.staged      = true;
+
+    output_list[0] = &out1;
+    output::init_output_list(output_list, 1);
+
+    has_outputted = false;
+    output_count  = 0;
+
+    out1.set<uint32_t>(1);
+    out1.set<uint32_t>(2);
+    out1.set<uint32_t>(3);
+
+    ASSERT_FALSE(has_outputted);
+
+    output::commit();
+
+    ASSERT_EQ(output_count, 1);
+    ASSERT_EQ((uint32_t)(uintptr_t)outputted_data, 3);
+
+    output::commit(); // Nothing new staged
+
+    ASSERT_EQ(output_count, 1);
+}
+
 TEST(OutputTest, InitOutputInfo)
 {
     TestOutput test_out = TestOutput();
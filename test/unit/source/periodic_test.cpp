@@ -13,6 +13,9 @@
 #include "mutex.hpp"
 #include "error.hpp"
 #include "timer_osal.hpp"
+#include "alarm_hal.hpp"
+#include "event.hpp"
+#include "systime.hpp"
 #include "macros.hpp"
 #include "fff.h"
 
@@ -28,7 +31,8 @@
 //  File Variables
 //--------------------------------------------------------------------------------------------------
 
-static bool callback_called;
+static bool     callback_called;
+static uint32_t calls_2 = 0;
 
 //--------------------------------------------------------------------------------------------------
 //  Fakes/Mocks
@@ -44,11 +48,26 @@ namespace mutex
 
 namespace timer_osal
 {
-    FAKE_VALUE_FUNC(error::Error, start, TimerID);
+    FAKE_VALUE_FUNC(error::Error, set_period, TimerID, uint32_t);
     FAKE_VALUE_FUNC(error::Error, stop, TimerID);
     FAKE_VALUE_FUNC(error::Error, create, TimerID, TimerCallbackFunc, uint32_t, bool);
-    FAKE_VALUE_FUNC(uint32_t, curr_time_ms);
-    FAKE_VALUE_FUNC(bool, is_running, TimerID);
+}
+
+namespace alarm_hal
+{
+    FAKE_VALUE_FUNC(error::Error, arm, uint32_t, AlarmFunc);
+    FAKE_VOID_FUNC(disarm);
+}
+
+namespace event
+{
+    FAKE_VOID_FUNC(post, ID, void *);
+}
+
+namespace systime
+{
+    FAKE_VALUE_FUNC(uint32_t, now_ms);
+    FAKE_VALUE_FUNC(uint64_t, now_us);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -65,6 +84,30 @@ void periodic_callback(uint32_t curr_time_ms)
 void periodic_callback_2(uint32_t curr_time_ms)
 {
     UNUSED(curr_time_ms);
+
+    calls_2++;
+}
+
+/// @brief Runs the timer callback at the given time, with callbacks taking no time to run.
+///
+void expire(uint32_t curr_time_ms)
+{
+    systime::now_ms_fake.return_val = curr_time_ms;
+    systime::now_us_fake.return_val = (uint64_t)curr_time_ms * systime::US_PER_MS;
+
+    timer_osal::TimerCallbackFunc callback = timer_osal::create_fake.arg1_val;
+    callback(0);
+}
+
+/// @brief Runs the alarm interrupt at the given time.
+///
+void fire_alarm(uint32_t curr_time_ms)
+{
+    systime::now_ms_fake.return_val = curr_time_ms;
+    systime::now_us_fake.return_val = (uint64_t)curr_time_ms * systime::US_PER_MS;
+
+    alarm_hal::AlarmFunc isr = alarm_hal::arm_fake.arg1_val;
+    isr();
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -75,7 +118,7 @@ TEST(PeriodicTest, Create)
 {
     ASSERT_FALSE(periodic_test::get_enabled(periodic::ID::Test));
 
-    periodic::create(periodic::ID::Test, 10, periodic_callback);
+    periodic::create(periodic::ID::Test, periodic_callback);
 
     ASSERT_FALSE(periodic_test::get_enabled(periodic::ID::Test));
     ASSERT_EQ(periodic_test::get_period(periodic::ID::Test), 10);
@@ -85,19 +128,19 @@ TEST(PeriodicTest, Start)
 {
     ASSERT_FALSE(periodic_test::get_enabled(periodic::ID::Test));
 
-    periodic::create(periodic::ID::Test, 10, periodic_callback);
+    periodic::create(periodic::ID::Test, periodic_callback);
     periodic::start(periodic::ID::Test);
 
     ASSERT_TRUE(periodic_test::get_enabled(periodic::ID::Test));
 
     ASSERT_EQ(timer_osal::create_fake.call_count, 1);
-    ASSERT_TRUE(timer_osal::start_fake.call_count);
+    ASSERT_FALSE(timer_osal::create_fake.arg3_val); // One-shot, armed for each deadline
+    ASSERT_EQ(timer_osal::set_period_fake.arg1_val, 10u);
 
     periodic::start(periodic::ID::Test);
 
     ASSERT_TRUE(periodic_test::get_enabled(periodic::ID::Test));
     ASSERT_EQ(timer_osal::create_fake.call_count, 1);
-    ASSERT_TRUE(timer_osal::start_fake.call_count);
 
     periodic::stop(periodic::ID::Test);
 }
@@ -108,55 +151,263 @@ TEST(PeriodicTest, Run)
 
     callback_called = false;
 
-    periodic::create(periodic::ID::Test, 10, periodic_callback);
+    systime::now_ms_fake.return_val = 0;
+
+    periodic::create(periodic::ID::Test, periodic_callback);
     periodic::start(periodic::ID::Test);
 
-    timer_osal::curr_time_ms_fake.return_val = 0;
+    // Time comes from the monotonic clock, not the timer
+    expire(5);
+    ASSERT_FALSE(callback_called);
+    ASSERT_EQ(timer_osal::set_period_fake.arg1_val, 5u);
 
-    ASSERT_TRUE(timer_osal::create_fake.call_count);
+    expire(10);
+    ASSERT_TRUE(callback_called);
+    ASSERT_EQ(timer_osal::set_period_fake.arg1_val, 10u);
 
-    timer_osal::TimerCallbackFunc callback = timer_osal::create_fake.arg1_val;
-    callback(5);
+    // Only called once per period, not on every tick after the first one
+    callback_called = false;
+    expire(11);
+    ASSERT_FALSE(callback_called);
+
+    // Late calls don't move the phase
+    expire(23);
+    ASSERT_TRUE(callback_called);
+    ASSERT_EQ(timer_osal::set_period_fake.arg1_val, 7u);
+
+    // Missed periods are skipped, not made up for
+    callback_called = false;
+    expire(55);
+    ASSERT_TRUE(callback_called);
+    ASSERT_EQ(timer_osal::set_period_fake.arg1_val, 5u);
+
+    callback_called = false;
+    expire(56);
+    ASSERT_FALSE(callback_called);
+
+    periodic::stop(periodic::ID::Test);
+}
+
+TEST(PeriodicTest, Order)
+{
+    callback_called = false;
+    calls_2         = 0;
+
+    systime::now_ms_fake.return_val = 1000;
+
+    periodic::create(periodic::ID::Test, periodic_callback);
+    periodic::create(periodic::ID::IOWatch, periodic_callback_2);
+    periodic::set_period(periodic::ID::IOWatch, 4);
+    periodic::start(periodic::ID::Test);
+    periodic::start(periodic::ID::IOWatch);
+
+    // Armed for the earliest deadline
+    ASSERT_EQ(timer_osal::set_period_fake.arg1_val, 4u);
+
+    expire(1004);
+    ASSERT_EQ(calls_2, 1u);
     ASSERT_FALSE(callback_called);
+    ASSERT_EQ(timer_osal::set_period_fake.arg1_val, 4u);
 
-    callback(10);
+    expire(1008);
+    ASSERT_EQ(calls_2, 2u);
+    ASSERT_EQ(timer_osal::set_period_fake.arg1_val, 2u);
+
+    expire(1010);
     ASSERT_TRUE(callback_called);
+    ASSERT_EQ(timer_osal::set_period_fake.arg1_val, 2u);
+
+    // Stopping the earliest one re-arms for the next
+    periodic::stop(periodic::ID::IOWatch);
+    ASSERT_EQ(timer_osal::set_period_fake.arg1_val, 10u);
+
+    periodic::stop(periodic::ID::Test);
+}
 
+TEST(PeriodicTest, Wrap)
+{
     callback_called = false;
-    callback(25);
+
+    systime::now_ms_fake.return_val = 0xFFFFFFFA;
+
+    periodic::create(periodic::ID::Test, periodic_callback);
+    periodic::start(periodic::ID::Test);
+
+    expire(0xFFFFFFFF);
+    ASSERT_FALSE(callback_called);
+
+    expire(4);
     ASSERT_TRUE(callback_called);
+    ASSERT_EQ(timer_osal::set_period_fake.arg1_val, 10u);
+
+    periodic::stop(periodic::ID::Test);
+}
+
+TEST(PeriodicTest, Stats)
+{
+    systime::now_ms_fake.return_val = 0;
+
+    periodic::create(periodic::ID::Test, periodic_callback);
+    periodic::start(periodic::ID::Test);
+    periodic::reset_stats();
+
+    // Starts 300us late and runs for 12ms, longer than the period
+    uint64_t times_us[] = { 10300, 22300 };
+    SET_RETURN_SEQ(systime::now_us, times_us, 2);
+    systime::now_ms_fake.return_val = 10;
+
+    timer_osal::TimerCallbackFunc callback = timer_osal::create_fake.arg1_val;
+    callback(0);
+
+    RESET_FAKE(systime::now_us);
+
+    // The call at 55 is for the deadline at 20, and the ones at 30, 40 and 50 are skipped
+    expire(55);
+
+    periodic::Stats stats = periodic::get_stats(periodic::ID::Test);
+    ASSERT_EQ(stats.calls, 2u);
+    ASSERT_EQ(stats.late_min_us, 300u);
+    ASSERT_EQ(stats.late_max_us, 35000u);
+    ASSERT_EQ(stats.late_bins[1], 1u);
+    ASSERT_EQ(stats.late_bins[periodic::NUM_LATENESS_BINS - 1], 1u);
+    ASSERT_EQ(stats.exec_max_us, 12000u);
+    ASSERT_EQ(stats.exec_mean_us, 6000u);
+    ASSERT_EQ(stats.overruns, 1u);
+    ASSERT_EQ(stats.skipped, 3u);
+
+    periodic::reset_stats();
+
+    stats = periodic::get_stats(periodic::ID::Test);
+    ASSERT_EQ(stats.calls, 0u);
+    ASSERT_EQ(stats.late_max_us, 0u);
+    ASSERT_EQ(stats.skipped, 0u);
 
     periodic::stop(periodic::ID::Test);
 }
 
+TEST(PeriodicTest, ISR)
+{
+    callback_called = false;
+
+    RESET_FAKE(alarm_hal::arm);
+    RESET_FAKE(alarm_hal::disarm);
+    RESET_FAKE(timer_osal::set_period);
+
+    systime::now_ms_fake.return_val = 100;
+    systime::now_us_fake.return_val = 100250;
+
+    periodic::create(periodic::ID::TestISR, periodic_callback);
+    periodic::start(periodic::ID::TestISR);
+
+    // Armed on the alarm to the microsecond, not the timer
+    ASSERT_EQ(alarm_hal::arm_fake.call_count, 1u);
+    ASSERT_EQ(alarm_hal::arm_fake.arg0_val, 9750u);
+    ASSERT_EQ(timer_osal::set_period_fake.call_count, 0u);
+
+    fire_alarm(105);
+    ASSERT_FALSE(callback_called);
+    ASSERT_EQ(alarm_hal::arm_fake.arg0_val, 5000u);
+
+    fire_alarm(110);
+    ASSERT_TRUE(callback_called);
+    ASSERT_EQ(alarm_hal::arm_fake.arg0_val, 10000u);
+    ASSERT_EQ(periodic::get_stats(periodic::ID::TestISR).calls, 1u);
+
+    periodic::stop(periodic::ID::TestISR);
+    ASSERT_EQ(alarm_hal::disarm_fake.call_count, 1u);
+    ASSERT_FALSE(periodic_test::get_enabled(periodic::ID::TestISR));
+}
+
+TEST(PeriodicTest, Task)
+{
+    callback_called = false;
+
+    RESET_FAKE(event::post);
+
+    systime::now_ms_fake.return_val = 0;
+
+    periodic::create(periodic::ID::TestTask, periodic_callback);
+    periodic::start(periodic::ID::TestTask);
+    periodic::reset_stats();
+
+    // Posted to the owner rather than called from the timer
+    expire(10);
+    ASSERT_FALSE(callback_called);
+    ASSERT_EQ(event::post_fake.call_count, 1u);
+    ASSERT_EQ(event::post_fake.arg0_val, event::ID::control_RunPeriodic);
+    ASSERT_EQ((uintptr_t)event::post_fake.arg1_val, (uintptr_t)periodic::ID::TestTask);
+
+    // Owner hasn't run it yet, so the next period is skipped rather than queued up
+    expire(20);
+    ASSERT_EQ(event::post_fake.call_count, 1u);
+
+    systime::now_us_fake.return_val = 23000;
+    periodic::run(periodic::ID::TestTask);
+    ASSERT_TRUE(callback_called);
+
+    periodic::Stats stats = periodic::get_stats(periodic::ID::TestTask);
+    ASSERT_EQ(stats.calls, 1u);
+    ASSERT_EQ(stats.late_max_us, 13000u); // Late for the deadline at 10
+    ASSERT_EQ(stats.skipped, 1u);
+
+    // Runs posted before a stop are dropped
+    expire(30);
+    ASSERT_EQ(event::post_fake.call_count, 2u);
+    periodic::stop(periodic::ID::TestTask);
+
+    callback_called = false;
+    periodic::run(periodic::ID::TestTask);
+    ASSERT_FALSE(callback_called);
+
+    TEST_ERROR(periodic::run(periodic::ID::Test));
+}
+
 TEST(PeriodicTest, Stop)
 {
     ASSERT_FALSE(periodic_test::get_enabled(periodic::ID::Test));
 
-    periodic::create(periodic::ID::Test, 10, periodic_callback);
+    periodic::create(periodic::ID::Test, periodic_callback);
     periodic::start(periodic::ID::Test);
 
     ASSERT_TRUE(periodic_test::get_enabled(periodic::ID::Test));
 
+    RESET_FAKE(timer_osal::stop);
+
     periodic::stop(periodic::ID::Test);
-    ASSERT_TRUE(timer_osal::stop_fake.call_count);
+    ASSERT_EQ(timer_osal::stop_fake.call_count, 1u); // Nothing left to run
     ASSERT_FALSE(periodic_test::get_enabled(periodic::ID::Test));
 
     periodic::stop(periodic::ID::Test);
     ASSERT_FALSE(periodic_test::get_enabled(periodic::ID::Test));
 }
 
+TEST(PeriodicTest, Declared)
+{
+    ASSERT_STREQ(periodic::name(periodic::ID::Test), "Test");
+    ASSERT_EQ(periodic::budget_us(periodic::ID::Test), 100u);
+
+    periodic::create(periodic::ID::Test, periodic_callback);
+    periodic::set_period(periodic::ID::Test, 25);
+    ASSERT_EQ(periodic_test::get_period(periodic::ID::Test), 25);
+
+    // Shorter than periodics.def allows
+    TEST_ERROR(periodic::set_period(periodic::ID::Test, 9));
+
+    // Creating again goes back to the declared period
+    periodic::create(periodic::ID::Test, periodic_callback);
+    ASSERT_EQ(periodic_test::get_period(periodic::ID::Test), 10);
+}
+
 TEST(PeriodicTest, CreateMultiple)
 {
-    periodic::create(periodic::ID::Test, 10, periodic_callback);
-    periodic::create(periodic::ID::Test, 10, periodic_callback);
+    periodic::create(periodic::ID::Test, periodic_callback);
+    periodic::create(periodic::ID::Test, periodic_callback);
 
     periodic::start(periodic::ID::Test);
 
-    periodic::create(periodic::ID::Test, 10, periodic_callback);
+    periodic::create(periodic::ID::Test, periodic_callback);
 
-    TEST_ERROR(periodic::create(periodic::ID::Test, 20, periodic_callback));
-    TEST_ERROR(periodic::create(periodic::ID::Test, 10, periodic_callback_2));
+    TEST_ERROR(periodic::create(periodic::ID::Test, periodic_callback_2));
 
     periodic::stop(periodic::ID::Test);
 }
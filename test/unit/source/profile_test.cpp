@@ -0,0 +1,134 @@
+/// @file profile_test.cpp
+/// @author Denver Hoggatt
+/// @brief Unit tests for profiling zones.
+///
+/// Copyright (c) 2025 Denver Hoggatt. All rights reserved.
+///
+/// This software is licensed under terms that can be found in the LICENSE file
+/// in the root directory of this software component.
+/// If no LICENSE file comes with this software, it is provided AS-IS.
+///
+
+#include "profile.hpp"
+#include "systime.hpp"
+#include "macros.hpp"
+#include "fff.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cstring>
+
+//--------------------------------------------------------------------------------------------------
+//  Private Constants
+//--------------------------------------------------------------------------------------------------
+
+
+//--------------------------------------------------------------------------------------------------
+//  File Variables
+//--------------------------------------------------------------------------------------------------
+
+
+//--------------------------------------------------------------------------------------------------
+//  Fakes/Mocks
+//--------------------------------------------------------------------------------------------------
+
+DEFINE_FFF_GLOBALS;
+
+namespace systime
+{
+    FAKE_VALUE_FUNC(uint32_t, ticks);
+    FAKE_VALUE_FUNC(uint32_t, ticks_to_us, uint32_t);
+}
+
+//--------------------------------------------------------------------------------------------------
+//  Private Functions
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Ticks are microseconds, to keep the numbers easy to follow.
+///
+uint32_t ticks_as_us(uint32_t ticks)
+{
+    return ticks;
+}
+
+void reset()
+{
+    RESET_FAKE(systime::ticks);
+    RESET_FAKE(systime::ticks_to_us);
+
+    systime::ticks_to_us_fake.custom_fake = ticks_as_us;
+
+    profile::init();
+}
+
+//--------------------------------------------------------------------------------------------------
+//  Tests
+//--------------------------------------------------------------------------------------------------
+
+TEST(ProfileTest, Record)
+{
+    reset();
+
+    profile::Stats stats = profile::get(profile::Zone::EventPost);
+    ASSERT_EQ(stats.count, 0u);
+    ASSERT_EQ(stats.min_us, 0u);
+    ASSERT_EQ(stats.max_us, 0u);
+    ASSERT_EQ(stats.mean_us, 0u);
+
+    profile::record(profile::Zone::EventPost, 10);
+    profile::record(profile::Zone::EventPost, 30);
+    profile::record(profile::Zone::EventPost, 5);
+
+    stats = profile::get(profile::Zone::EventPost);
+    ASSERT_EQ(stats.count, 3u);
+    ASSERT_EQ(stats.min_us, 5u);
+    ASSERT_EQ(stats.max_us, 30u);
+    ASSERT_EQ(stats.mean_us, 15u);
+
+    // Zones are kept apart
+    ASSERT_EQ(profile::get(profile::Zone::DisperseEvent).count, 0u);
+
+    profile::reset();
+    ASSERT_EQ(profile::get(profile::Zone::EventPost).count, 0u);
+}
+
+TEST(ProfileTest, Scope)
+{
+    reset();
+
+    uint32_t ticks[] = { 0xFFFFFFF0, 0x10 }; // Across a wrap of the clock
+    SET_RETURN_SEQ(systime::ticks, ticks, 2);
+
+    {
+        profile::Scope scope;
+        scope.open(profile::Zone::SettingsWrite);
+    }
+
+    profile::Stats stats = profile::get(profile::Zone::SettingsWrite);
+    ASSERT_EQ(stats.count, 1u);
+    ASSERT_EQ(stats.max_us, 0x20u);
+
+    // Nothing is recorded for a scope that was never opened
+    {
+        profile::Scope scope;
+        UNUSED(scope);
+    }
+
+    ASSERT_EQ(systime::ticks_fake.call_count, 2u);
+}
+
+TEST(ProfileTest, Names)
+{
+    ASSERT_STREQ(profile::name(profile::Zone::DisperseEvent), "disperse_event");
+    ASSERT_STREQ(profile::name(profile::Zone::EventPost), "event::post");
+}
+
+TEST(ProfileTest, InvalidZone)
+{
+    TEST_ERROR(profile::record(profile::Zone::NumZones, 0));
+    TEST_ERROR(profile::get(profile::Zone::NumZones));
+    TEST_ERROR(profile::name(profile::Zone::NumZones));
+}
+
+// End of File
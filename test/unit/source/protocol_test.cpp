@@ -0,0 +1,525 @@
+/// @file protocol_test.cpp
+/// @author Denver Hoggatt
+/// @brief Unit tests for the binary host protocol.
+///
+/// Copyright (c) 2025 Denver Hoggatt. All rights reserved.
+///
+/// This software is licensed under terms that can be found in the LICENSE file
+/// in the root directory of this software component.
+/// If no LICENSE file comes with this software, it is provided AS-IS.
+///
+
+#include "protocol.hpp"
+#include "command.hpp"
+#include "settings.hpp"
+#include "input.hpp"
+#include "output.hpp"
+#include "macros.hpp"
+#include "fff.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cstring>
+
+//--------------------------------------------------------------------------------------------------
+//  Private Constants
+//--------------------------------------------------------------------------------------------------
+
+constexpr uint8_t  TEST_SEQ = 0x5A; // Arbitrarily chosen.
+constexpr uint16_t SETTING  = (uint16_t)settings::ID::TestInt;
+constexpr uint16_t IO       = (uint16_t)io::IOID::INPUT_1;
+
+//--------------------------------------------------------------------------------------------------
+//  File Variables
+//--------------------------------------------------------------------------------------------------
+
+uint8_t  sent[protocol::MAX_ENCODED_LEN + 1];
+uint32_t sent_len = 0;
+
+uint8_t  response[protocol::MAX_FRAME_LEN];
+uint32_t response_len = 0;
+
+char set_value[settings::MAX_STR_LEN + 1];
+
+uint32_t input_val = 0;
+void    *out_data  = nullptr;
+
+//--------------------------------------------------------------------------------------------------
+//  Fakes/Mocks
+//--------------------------------------------------------------------------------------------------
+
+DEFINE_FFF_GLOBALS;
+
+namespace settings
+{
+    FAKE_VALUE_FUNC(int32_t, set, settings::ID, const char *, bool);
+    FAKE_VALUE_FUNC(int32_t, get, settings::ID, char *);
+}
+
+namespace input
+{
+    FAKE_VALUE_FUNC(Input *, get_by_id, io::IOID);
+
+    char *Input::cmd_input()
+    {
+        return nullptr;
+    }
+}
+
+namespace output
+{
+    FAKE_VALUE_FUNC(Output *, get_by_id, io::IOID);
+
+    void Output::cmd_output(uint32_t argc, char **argv)
+    {
+        UNUSED(argc);
+        UNUSED(argv);
+    }
+}
+
+namespace command
+{
+    FAKE_VALUE_FUNC(int32_t, find, const char *, uint32_t);
+    FAKE_VALUE_FUNC(bool, pending);
+    FAKE_VOID_FUNC(resume, utility::Writer *);
+    FAKE_VOID_FUNC(test_cmd, utility::Writer *, uint32_t, char **);
+
+    CommandFunc *get_func_list(uint32_t *size)
+    {
+        static CommandFunc cmd_func_list[] = { test_cmd };
+
+        *size = sizeof(cmd_func_list) / sizeof(cmd_func_list[0]);
+
+        return cmd_func_list;
+    }
+}
+
+class TestInput : public input::Input
+{
+    public:
+        void *get_by_id()
+        {
+            return (void *)(uintptr_t)input_val;
+        }
+
+        void init()
+        {
+            this->type       = io::IOType::ADC;
+            this->input_type = &typeid(uint32_t);
+        }
+
+        void print(void *data, io::IODirection dir)
+        {
+            UNUSED(data);
+            UNUSED(dir);
+        }
+};
+
+class TestOutput : public output::Output
+{
+    public:
+        void set_output(void *data)
+        {
+            out_data = data;
+        }
+
+        void print(void *data, io::IODirection dir)
+        {
+            UNUSED(data);
+            UNUSED(dir);
+        }
+
+        void init()
+        {
+            this->type        = io::IOType::GPIO;
+            this->output_type = &typeid(bool);
+        }
+};
+
+//--------------------------------------------------------------------------------------------------
+//  Private Functions
+//--------------------------------------------------------------------------------------------------
+
+void capture_frame(void *context, const char *data, uint32_t len)
+{
+    UNUSED(context);
+
+    ASSERT_LE(len, sizeof(sent));
+
+    memcpy(sent, data, len);
+    sent_len = len;
+}
+
+/// @brief Frames the given records as a request, sends it, and decodes the response.
+/// @return Number of bytes used by the protocol.
+///
+uint32_t request(const uint8_t *records, uint32_t len, bool corrupt = false)
+{
+    uint8_t frame[protocol::MAX_FRAME_LEN];
+    frame[0] = (uint8_t)protocol::FrameType::Request;
+    frame[1] = TEST_SEQ;
+    memcpy(&frame[2], records, len);
+
+    uint16_t crc    = protocol::crc16(frame, len + 2);
+    frame[len + 2]  = (uint8_t)crc;
+    frame[len + 3]  = (uint8_t)(crc >> 8);
+    frame[len + 2] ^= corrupt ? 0xFF : 0x00;
+
+    uint8_t  encoded[protocol::MAX_ENCODED_LEN + 1];
+    uint32_t encoded_len = protocol::cobs_encode(frame, len + 4, encoded);
+    encoded[encoded_len] = protocol::FRAME_DELIMITER;
+
+    sent_len         = 0;
+    uint32_t used    = protocol::receive((const char *)encoded, encoded_len + 1);
+    int32_t  decoded = protocol::cobs_decode(sent, sent_len - 1, response);
+
+    EXPECT_EQ(sent[sent_len - 1], (uint8_t)protocol::FRAME_DELIMITER);
+    EXPECT_GE(decoded, 5);
+
+    response_len = decoded - protocol::CRC_LEN;
+    uint16_t crc_rcvd
+        = (uint16_t)(response[response_len] | (response[response_len + 1] << 8));
+    EXPECT_EQ(crc_rcvd, protocol::crc16(response, response_len));
+
+    return used;
+}
+
+int32_t get_setting(settings::ID id, char *value)
+{
+    UNUSED(id);
+
+    strcpy(value, "42");
+
+    return (int32_t)error::NoError;
+}
+
+int32_t set_setting(settings::ID id, const char *value, bool save)
+{
+    UNUSED(id);
+    UNUSED(save);
+
+    strcpy(set_value, value);
+
+    return (int32_t)error::NoError;
+}
+
+void write_ok(utility::Writer *out, uint32_t argc, char **argv)
+{
+    ASSERT_EQ(argc, 2u);
+    ASSERT_STREQ(argv[0], "a");
+    ASSERT_STREQ(argv[1], "b");
+
+    out->write("ok");
+}
+
+void init_protocol()
+{
+    protocol::init(capture_frame, nullptr);
+    protocol::start();
+}
+
+//--------------------------------------------------------------------------------------------------
+//  Tests
+//--------------------------------------------------------------------------------------------------
+
+TEST(ProtocolTest, CRC)
+{
+    const char check[] = "123456789";
+
+    ASSERT_EQ(protocol::crc16((const uint8_t *)check, strlen(check)), 0x29B1);
+    ASSERT_EQ(protocol::crc16(nullptr, 0), 0xFFFF);
+}
+
+TEST(ProtocolTest, COBS)
+{
+    const uint8_t data[]     = { 0x11, 0x22, 0x00, 0x33 };
+    const uint8_t expected[] = { 0x03, 0x11, 0x22, 0x02, 0x33 };
+
+    uint8_t encoded[sizeof(data) + 2];
+    ASSERT_EQ(protocol::cobs_encode(data, sizeof(data), encoded), sizeof(expected));
+    ASSERT_EQ(memcmp(encoded, expected, sizeof(expected)), 0);
+
+    uint8_t decoded[sizeof(encoded)];
+    ASSERT_EQ(protocol::cobs_decode(encoded, sizeof(expected), decoded), (int32_t)sizeof(data));
+    ASSERT_EQ(memcmp(decoded, data, sizeof(data)), 0);
+
+    uint8_t long_data[300]; // Spans more than one 254 byte block
+    memset(long_data, 0xAB, sizeof(long_data));
+    long_data[100] = 0;
+
+    uint8_t  long_encoded[sizeof(long_data) + (sizeof(long_data) / 254) + 1];
+    uint32_t len = protocol::cobs_encode(long_data, sizeof(long_data), long_encoded);
+    ASSERT_EQ(memchr(long_encoded, 0, len), nullptr);
+
+    uint8_t long_decoded[sizeof(long_encoded)];
+    ASSERT_EQ(protocol::cobs_decode(long_encoded, len, long_decoded), (int32_t)sizeof(long_data));
+    ASSERT_EQ(memcmp(long_decoded, long_data, sizeof(long_data)), 0);
+
+    const uint8_t invalid[] = { 0x05, 0x11 };
+    ASSERT_EQ(protocol::cobs_decode(invalid, sizeof(invalid), decoded), -1);
+}
+
+TEST(ProtocolTest, Settings)
+{
+    init_protocol();
+
+    RESET_FAKE(settings::get);
+    RESET_FAKE(settings::set);
+    settings::get_fake.custom_fake = get_setting;
+    settings::set_fake.custom_fake = set_setting;
+
+    const uint8_t records[] = {
+        (uint8_t)protocol::Op::SettingGet, (uint8_t)SETTING, 0,
+        (uint8_t)protocol::Op::SettingSet, (uint8_t)SETTING, 0, 2, '1', '2',
+        (uint8_t)protocol::Op::SettingGet, 0xFF, 0xFF,
+    };
+    request(records, sizeof(records));
+
+    const uint8_t expected[] = {
+        (uint8_t)protocol::FrameType::Response, TEST_SEQ, (uint8_t)protocol::Status::Ok,
+        (uint8_t)protocol::Op::SettingGet, (uint8_t)protocol::Status::Ok, (uint8_t)SETTING, 0, 2,
+        '4', '2',
+        (uint8_t)protocol::Op::SettingSet, (uint8_t)protocol::Status::Ok, (uint8_t)SETTING, 0,
+        (uint8_t)protocol::Op::SettingGet, (uint8_t)protocol::Status::InvalidID,
+    };
+    ASSERT_EQ(response_len, sizeof(expected));
+    ASSERT_EQ(memcmp(response, expected, sizeof(expected)), 0);
+
+    ASSERT_EQ(settings::set_fake.call_count, 1u);
+    ASSERT_STREQ(set_value, "12");
+    ASSERT_TRUE(settings::set_fake.arg2_val);
+}
+
+TEST(ProtocolTest, IO)
+{
+    init_protocol();
+
+    TestInput test_input;
+    test_input.init();
+    test_input.print_io              = false;
+    input::get_by_id_fake.return_val = &test_input;
+    input_val                        = 0x12345678;
+
+    TestOutput test_output;
+    test_output.init();
+    test_output.print_io              = false;
+    output::get_by_id_fake.return_val = &test_output;
+    out_data                          = nullptr;
+
+    const uint8_t records[] = {
+        (uint8_t)protocol::Op::IOGet, (uint8_t)IO, 0,
+        (uint8_t)protocol::Op::IOSet, (uint8_t)IO, 0, 1, 0, 0, 0,
+    };
+    request(records, sizeof(records));
+
+    const uint8_t expected[] = {
+        (uint8_t)protocol::FrameType::Response, TEST_SEQ, (uint8_t)protocol::Status::Ok,
+        (uint8_t)protocol::Op::IOGet, (uint8_t)protocol::Status::Ok, (uint8_t)IO, 0, 0x78, 0x56,
+        0x34, 0x12,
+        (uint8_t)protocol::Op::IOSet, (uint8_t)protocol::Status::Ok, (uint8_t)IO, 0,
+    };
+    ASSERT_EQ(response_len, sizeof(expected));
+    ASSERT_EQ(memcmp(response, expected, sizeof(expected)), 0);
+    ASSERT_EQ(out_data, (void *)1);
+
+    test_input.input_type            = &typeid(const char *);
+    input::get_by_id_fake.return_val = nullptr;
+
+    const uint8_t bad_records[] = {
+        (uint8_t)protocol::Op::IOGet, (uint8_t)IO, 0,
+        (uint8_t)protocol::Op::IOGet, 0xFF, 0xFF,
+    };
+    request(bad_records, sizeof(bad_records));
+
+    ASSERT_EQ(response[4], (uint8_t)protocol::Status::InvalidID);
+    ASSERT_EQ(response[6], (uint8_t)protocol::Status::InvalidID);
+
+    input::get_by_id_fake.return_val = &test_input;
+    request(bad_records, 3);
+    ASSERT_EQ(response[4], (uint8_t)protocol::Status::UnknownType);
+
+    RESET_FAKE(input::get_by_id);
+    RESET_FAKE(output::get_by_id);
+}
+
+TEST(ProtocolTest, Command)
+{
+    init_protocol();
+
+    RESET_FAKE(command::find);
+    RESET_FAKE(command::test_cmd);
+    command::test_cmd_fake.custom_fake = write_ok;
+
+    const uint8_t records[] = {
+        (uint8_t)protocol::Op::Command, 8, 't', 'e', 's', 't', ' ', 'a', ' ', 'b',
+    };
+    request(records, sizeof(records));
+
+    const uint8_t expected[] = {
+        (uint8_t)protocol::FrameType::Response, TEST_SEQ, (uint8_t)protocol::Status::Ok,
+        (uint8_t)protocol::Op::Command, (uint8_t)protocol::Status::Ok, 2, 'o', 'k',
+    };
+    ASSERT_EQ(response_len, sizeof(expected));
+    ASSERT_EQ(memcmp(response, expected, sizeof(expected)), 0);
+    ASSERT_EQ(command::test_cmd_fake.call_count, 1u);
+    ASSERT_EQ(command::find_fake.arg1_val, 4u);
+
+    command::find_fake.return_val = -1;
+    request(records, sizeof(records));
+    ASSERT_EQ(response[4], (uint8_t)protocol::Status::InvalidID);
+
+    RESET_FAKE(command::find);
+}
+
+TEST(ProtocolTest, SlicedCommand)
+{
+    init_protocol();
+
+    RESET_FAKE(command::find);
+    RESET_FAKE(command::test_cmd);
+    RESET_FAKE(command::pending);
+    RESET_FAKE(command::resume);
+    RESET_FAKE(settings::get);
+    command::test_cmd_fake.custom_fake = write_ok;
+    settings::get_fake.custom_fake     = get_setting;
+
+    bool pending_seq[] = { true, true, false };
+    SET_RETURN_SEQ(command::pending, pending_seq, 3);
+
+    // The response is only sent once the command is done, one slice per resume()
+    const uint8_t records[] = {
+        (uint8_t)protocol::Op::Command, 8, 't', 'e', 's', 't', ' ', 'a', ' ', 'b',
+        (uint8_t)protocol::Op::SettingGet, (uint8_t)SETTING, 0,
+    };
+    uint8_t frame[sizeof(records) + 4] = { (uint8_t)protocol::FrameType::Request, TEST_SEQ };
+    memcpy(&frame[2], records, sizeof(records));
+    uint16_t crc               = protocol::crc16(frame, sizeof(records) + 2);
+    frame[sizeof(records) + 2] = (uint8_t)crc;
+    frame[sizeof(records) + 3] = (uint8_t)(crc >> 8);
+
+    char     stream[protocol::MAX_ENCODED_LEN + 2];
+    uint32_t len    = protocol::cobs_encode(frame, sizeof(frame), (uint8_t *)stream);
+    stream[len]     = protocol::FRAME_DELIMITER;
+    stream[len + 1] = protocol::FRAME_DELIMITER;
+
+    sent_len      = 0;
+    uint32_t used = protocol::receive(stream, len + 2);
+    ASSERT_EQ(used, len + 1); // The rest waits until the response is sent
+    ASSERT_TRUE(protocol::pending());
+    ASSERT_EQ(sent_len, 0u);
+
+    protocol::resume();
+    ASSERT_TRUE(protocol::pending());
+    ASSERT_EQ(command::resume_fake.call_count, 1u);
+    ASSERT_EQ(sent_len, 0u);
+
+    protocol::resume();
+    ASSERT_FALSE(protocol::pending());
+    ASSERT_EQ(command::resume_fake.call_count, 2u);
+    ASSERT_GT(sent_len, 0u);
+
+    int32_t       decoded    = protocol::cobs_decode(sent, sent_len - 1, response);
+    const uint8_t expected[] = {
+        (uint8_t)protocol::FrameType::Response, TEST_SEQ, (uint8_t)protocol::Status::Ok,
+        (uint8_t)protocol::Op::Command, (uint8_t)protocol::Status::Ok, 2, 'o', 'k',
+        (uint8_t)protocol::Op::SettingGet, (uint8_t)protocol::Status::Ok,
+    };
+    ASSERT_GE(decoded, (int32_t)sizeof(expected));
+    ASSERT_EQ(memcmp(response, expected, sizeof(expected)), 0);
+
+    RESET_FAKE(command::find);
+    RESET_FAKE(command::pending);
+    RESET_FAKE(command::resume);
+    RESET_FAKE(settings::get);
+}
+
+TEST(ProtocolTest, BadFrames)
+{
+    init_protocol();
+
+    const uint8_t records[] = { (uint8_t)protocol::Op::SettingGet, (uint8_t)SETTING, 0 };
+    request(records, sizeof(records), true);
+    ASSERT_EQ(response[2], (uint8_t)protocol::Status::BadCRC);
+    ASSERT_EQ(response_len, 3u);
+
+    const uint8_t unknown[] = { 0x7F, 1, 2, 3 };
+    request(unknown, sizeof(unknown));
+    ASSERT_EQ(response[2], (uint8_t)protocol::Status::UnknownOp);
+    ASSERT_EQ(response[4], (uint8_t)protocol::Status::UnknownOp);
+
+    const uint8_t short_record[] = { (uint8_t)protocol::Op::IOSet, (uint8_t)IO, 0 };
+    request(short_record, sizeof(short_record));
+    ASSERT_EQ(response[2], (uint8_t)protocol::Status::BadFrame);
+
+    const char garbage[] = { 0x01, protocol::FRAME_DELIMITER };
+    sent_len             = 0;
+    protocol::receive(garbage, sizeof(garbage));
+    ASSERT_GT(sent_len, 0u);
+
+    sent_len = 0;
+    protocol::receive(garbage + 1, 1); // Empty frames are ignored
+    ASSERT_EQ(sent_len, 0u);
+
+    char overflow[protocol::MAX_ENCODED_LEN + 2];
+    memset(overflow, 0x01, sizeof(overflow));
+    overflow[sizeof(overflow) - 1] = protocol::FRAME_DELIMITER;
+    protocol::receive(overflow, sizeof(overflow));
+    protocol::cobs_decode(sent, sent_len - 1, response);
+    ASSERT_EQ(response[2], (uint8_t)protocol::Status::BadFrame);
+}
+
+TEST(ProtocolTest, Exit)
+{
+    init_protocol();
+    ASSERT_TRUE(protocol::active());
+
+    uint8_t frame[] = {
+        (uint8_t)protocol::FrameType::Request, TEST_SEQ, (uint8_t)protocol::Op::Exit, 0, 0,
+    };
+    uint16_t crc = protocol::crc16(frame, 3);
+    frame[3]     = (uint8_t)crc;
+    frame[4]     = (uint8_t)(crc >> 8);
+
+    char     stream[sizeof(frame) + 8];
+    uint32_t len = protocol::cobs_encode(frame, sizeof(frame), (uint8_t *)stream);
+    stream[len]  = protocol::FRAME_DELIMITER;
+    strcpy(&stream[len + 1], "help");
+
+    uint32_t used = protocol::receive(stream, len + 5);
+
+    ASSERT_EQ(used, len + 1); // Text after the frame is left for the CLI
+    ASSERT_FALSE(protocol::active());
+}
+
+TEST(ProtocolTest, Telemetry)
+{
+    init_protocol();
+
+    protocol::Sample samples[] = {
+        { io::IOID::INPUT_1, 0x01020304 },
+        { io::IOID::INPUT_2, 0xFFFFFFFF },
+    };
+
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        sent_len = 0;
+        protocol::send_telemetry(samples, 2);
+
+        int32_t len = protocol::cobs_decode(sent, sent_len - 1, response);
+        ASSERT_EQ(len, 3 + 12 + 2);
+        ASSERT_EQ(response[0], (uint8_t)protocol::FrameType::Telemetry);
+        ASSERT_EQ(response[1], i);
+        ASSERT_EQ(response[3], (uint8_t)io::IOID::INPUT_1);
+        ASSERT_EQ(response[5], 0x04);
+    }
+
+    protocol::Sample many[64];
+    memset(many, 0, sizeof(many));
+    sent_len = 0;
+    protocol::send_telemetry(many, 64);
+    protocol::cobs_decode(sent, sent_len - 1, response);
+    ASSERT_EQ(response[2], (uint8_t)protocol::Status::Truncated);
+}
+
+// End of File
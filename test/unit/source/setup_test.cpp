@@ -62,6 +62,16 @@ namespace settings
     FAKE_VOID_FUNC(init);
 }
 
+namespace profile
+{
+    FAKE_VOID_FUNC(init);
+}
+
+namespace cpu_usage
+{
+    FAKE_VOID_FUNC(init);
+}
+
 namespace power
 {
     FAKE_VOID_FUNC(init);
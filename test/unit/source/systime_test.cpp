@@ -0,0 +1,108 @@
+/// @file systime_test.cpp
+/// @author Denver Hoggatt
+/// @brief Unit tests for the monotonic system time.
+///
+/// Copyright (c) 2025 Denver Hoggatt. All rights reserved.
+///
+/// This software is licensed under terms that can be found in the LICENSE file
+/// in the root directory of this software component.
+/// If no LICENSE file comes with this software, it is provided AS-IS.
+///
+
+#include "systime.hpp"
+#include "clock_hal.hpp"
+#include "fff.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+//--------------------------------------------------------------------------------------------------
+//  Private Constants
+//--------------------------------------------------------------------------------------------------
+
+constexpr uint32_t RATE_1MHZ  = 1000000;
+constexpr uint32_t RATE_24MHZ = 24000000;
+
+//--------------------------------------------------------------------------------------------------
+//  File Variables
+//--------------------------------------------------------------------------------------------------
+
+
+//--------------------------------------------------------------------------------------------------
+//  Fakes/Mocks
+//--------------------------------------------------------------------------------------------------
+
+DEFINE_FFF_GLOBALS;
+
+namespace clock_hal
+{
+    FAKE_VALUE_FUNC(uint32_t, ticks);
+    FAKE_VALUE_FUNC(uint32_t, rate_hz);
+}
+
+//--------------------------------------------------------------------------------------------------
+//  Private Functions
+//--------------------------------------------------------------------------------------------------
+
+void reset(uint32_t rate_hz)
+{
+    RESET_FAKE(clock_hal::ticks);
+    RESET_FAKE(clock_hal::rate_hz);
+
+    clock_hal::rate_hz_fake.return_val = rate_hz;
+}
+
+//--------------------------------------------------------------------------------------------------
+//  Tests
+//--------------------------------------------------------------------------------------------------
+
+TEST(SystimeTest, Convert)
+{
+    reset(RATE_1MHZ);
+    ASSERT_EQ(systime::ticks_to_us(1234), 1234u);
+
+    reset(RATE_24MHZ);
+    ASSERT_EQ(systime::ticks_to_us(24), 1u);
+    ASSERT_EQ(systime::ticks_to_us(23), 0u);
+    ASSERT_EQ(systime::ticks_to_us(0xFFFFFFFF), 178956970u); // No overflow on the way
+}
+
+TEST(SystimeTest, Extend)
+{
+    reset(RATE_1MHZ);
+
+    // Counter crosses its half way point, then wraps
+    uint32_t ticks[] = {0x10, 0x7FFFFFFF, 0x80000000, 0xFFFFFFFF, 0x10, 0x80000000};
+    SET_RETURN_SEQ(clock_hal::ticks, ticks, sizeof(ticks) / sizeof(ticks[0]));
+
+    uint64_t base = systime::now_us() - 0x10;
+    ASSERT_EQ(base & 0xFFFFFFFF, 0u);
+
+    ASSERT_EQ(systime::now_us() - base, 0x7FFFFFFFu);
+    ASSERT_EQ(systime::now_us() - base, 0x80000000u);
+    ASSERT_EQ(systime::now_us() - base, 0xFFFFFFFFu);
+    ASSERT_EQ(systime::now_us() - base, 0x100000010u);
+    ASSERT_EQ(systime::now_us() - base, 0x180000000u);
+}
+
+TEST(SystimeTest, Milliseconds)
+{
+    reset(RATE_24MHZ);
+
+    // Sub-second part isn't lost, unlike counting whole seconds
+    clock_hal::ticks_fake.return_val = 1500 * (RATE_24MHZ / 1000); // 1.5s, lower half of range
+    uint32_t start_ms = systime::now_ms();
+
+    clock_hal::ticks_fake.return_val += 7 * (RATE_24MHZ / 1000) + 1;
+    ASSERT_EQ(systime::now_ms() - start_ms, 7u);
+}
+
+TEST(SystimeTest, Ticks)
+{
+    reset(RATE_1MHZ);
+
+    clock_hal::ticks_fake.return_val = 42;
+    ASSERT_EQ(systime::ticks(), 42u);
+}
+
+// End of File
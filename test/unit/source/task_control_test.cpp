@@ -13,8 +13,10 @@
 #include "task.hpp"
 #include "event.hpp"
 #include "input.hpp"
+#include "output.hpp"
 #include "io.hpp"
 #include "control.hpp"
+#include "periodic.hpp"
 #include "adc_hal.hpp"
 #include "macros.hpp"
 #include "fff.h"
@@ -57,11 +59,21 @@ namespace input
     FAKE_VALUE_FUNC(input::Input *, get_by_id, io::IOID);
 }
 
+namespace output
+{
+    FAKE_VOID_FUNC(commit);
+}
+
 namespace control
 {
     FAKE_VOID_FUNC(disperse_event, event::Event);
 }
 
+namespace periodic
+{
+    FAKE_VOID_FUNC(run, ID);
+}
+
 namespace adc_hal
 {
     FAKE_VOID_FUNC(start_conversions);
@@ -112,6 +124,23 @@ TEST(TaskControlTest, Event)
         {
             case event::ID::control_ADCInput:
                 task_control::task_func(nullptr);
+                ASSERT_TRUE(output::commit_fake.call_count);
+                break;
+
+            case event::ID::control_RunPeriodic:
+                RESET_FAKE(control::disperse_event);
+                RESET_FAKE(periodic::run);
+                RESET_FAKE(event::handle);
+                RESET_FAKE(task::wait_any);
+
+                evts[0].arg = (void *)(uintptr_t)periodic::ID::TestTask;
+                SET_RETURN_SEQ(event::handle, evts, sizeof(evts) / sizeof(evts[0]));
+                SET_RETURN_SEQ(task::wait_any, signals, 2);
+
+                task_control::task_func(nullptr);
+                ASSERT_EQ(periodic::run_fake.call_count, 1u);
+                ASSERT_EQ(periodic::run_fake.arg0_val, periodic::ID::TestTask);
+                ASSERT_EQ(control::disperse_event_fake.call_count, 0u);
                 break;
 
             default:
@@ -0,0 +1,74 @@
+/// @file task_log_test.cpp
+/// @author Denver Hoggatt
+/// @brief Unit tests for the log task.
+///
+/// Copyright (c) 2025 Denver Hoggatt. All rights reserved.
+///
+/// This software is licensed under terms that can be found in the LICENSE file
+/// in the root directory of this software component.
+/// If no LICENSE file comes with this software, it is provided AS-IS.
+///
+
+#include "task_log.hpp"
+#include "task.hpp"
+#include "logging.hpp"
+#include "macros.hpp"
+#include "fff.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+//--------------------------------------------------------------------------------------------------
+//  Private Constants
+//--------------------------------------------------------------------------------------------------
+
+
+//--------------------------------------------------------------------------------------------------
+//  File Variables
+//--------------------------------------------------------------------------------------------------
+
+
+//--------------------------------------------------------------------------------------------------
+//  Fakes/Mocks
+//--------------------------------------------------------------------------------------------------
+
+DEFINE_FFF_GLOBALS;
+
+namespace task
+{
+    FAKE_VOID_FUNC(wait_strict, Signal);
+    FAKE_VOID_FUNC(send_open_signal, Func);
+
+    FAKE_VALUE_FUNC(uint32_t, wait_any);
+}
+
+namespace logging
+{
+    FAKE_VOID_FUNC(init);
+    FAKE_VOID_FUNC(flush);
+}
+
+//--------------------------------------------------------------------------------------------------
+//  Private Functions
+//--------------------------------------------------------------------------------------------------
+
+
+//--------------------------------------------------------------------------------------------------
+//  Tests
+//--------------------------------------------------------------------------------------------------
+
+TEST(TaskLogTest, TaskFunc)
+{
+    uint32_t signals[2]
+        = { (uint32_t)task::Signal::GlobalEvent, (uint32_t)task::Signal::GlobalTerminate };
+    SET_RETURN_SEQ(task::wait_any, signals, 2);
+
+    task_log::task_func(nullptr);
+
+    ASSERT_EQ(task::wait_strict_fake.call_count, 2u);
+    ASSERT_EQ(task::send_open_signal_fake.call_count, 1u);
+    ASSERT_EQ(logging::init_fake.call_count, 1u);
+    ASSERT_EQ(logging::flush_fake.call_count, 1u);
+}
+
+// End of File
@@ -31,6 +31,7 @@ constexpr uint32_t  UNIQUE_SIGNAL = 32; // Arbitrarily chosen.
 //  File Variables
 //--------------------------------------------------------------------------------------------------
 
+uint32_t chunks = 0;
 
 //--------------------------------------------------------------------------------------------------
 //  Fakes/Mocks
@@ -61,10 +62,22 @@ namespace task_control
     FAKE_VOID_FUNC(task_func, void *);
 }
 
+namespace task_log
+{
+    FAKE_VOID_FUNC(task_func, void *);
+}
+
 //--------------------------------------------------------------------------------------------------
 //  Private Functions
 //--------------------------------------------------------------------------------------------------
 
+void discard_chunk(void *context, const char *chunk)
+{
+    UNUSED(context);
+    UNUSED(chunk);
+
+    chunks++;
+}
 
 //--------------------------------------------------------------------------------------------------
 //  Tests
@@ -157,6 +170,17 @@ TEST(TaskTest, SendSignal)
     ASSERT_EQ(task_osal::send_signal_fake.call_count, 1);
 }
 
+TEST(TaskTest, SendSignalRoutesByID)
+{
+    RESET_FAKE(task_osal::send_signal);
+    task_test::set_handle_by_id(task::ID::control, (void *)UNIQUE_HANDLE);
+    task::send_signal(task::ID::control, task::Signal::GlobalEvent);
+
+    ASSERT_EQ(task_osal::send_signal_fake.call_count, 1);
+    ASSERT_EQ(task_osal::send_signal_fake.arg0_history[0], (void *)UNIQUE_HANDLE);
+    ASSERT_EQ(task_osal::send_signal_fake.arg1_history[0], (uint32_t)task::Signal::GlobalEvent);
+}
+
 TEST(TaskTest, SendOpenSignalPreConds)
 {
     TEST_ERROR(task::send_open_signal(nullptr));
@@ -187,15 +211,40 @@ TEST(TaskTest, GetID)
     ASSERT_EQ(id, task::ID::open);
 }
 
-TEST(TaskTest, PrintStackUsage)
+TEST(TaskTest, WriteStackUsage)
 {
     uint8_t              stack[configMINIMAL_STACK_SIZE];
     task_osal::StackInfo stack_info           = { stack, sizeof(stack), 0 };
     task_osal::get_stack_info_fake.return_val = stack_info;
 
-    task::print_maximum_stack_usage(true);
+    utility::Writer out;
+    out.init(discard_chunk, nullptr);
+
+    task::write_stack_usage(&out, task::ID::open);
 
     ASSERT_TRUE(task_osal::get_stack_info_fake.call_count);
+    ASSERT_TRUE(chunks);
+}
+
+TEST(TaskTest, WriteStackDump)
+{
+    uint8_t              stack[40];
+    task_osal::StackInfo stack_info           = { stack, sizeof(stack), 0 };
+    task_osal::get_stack_info_fake.return_val = stack_info;
+
+    utility::Writer out;
+    out.init(discard_chunk, nullptr);
+
+    uint32_t offset = 0;
+    ASSERT_FALSE(task::write_stack_dump(&out, task::ID::open, &offset, 16));
+    ASSERT_EQ(offset, 16u);
+    ASSERT_FALSE(task::write_stack_dump(&out, task::ID::open, &offset, 16));
+    ASSERT_EQ(offset, 32u);
+    ASSERT_TRUE(task::write_stack_dump(&out, task::ID::open, &offset, 16));
+    ASSERT_EQ(offset, sizeof(stack));
+
+    offset = sizeof(stack) + 1;
+    TEST_ERROR(task::write_stack_dump(&out, task::ID::open, &offset, 16));
 }
 
 // End of File
\ No newline at end of file
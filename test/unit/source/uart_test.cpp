@@ -11,6 +11,9 @@
 
 #include "uart.hpp"
 #include "event.hpp"
+#include "mutex.hpp"
+#include "timer_osal.hpp"
+#include "isr_hal.hpp"
 #include "macros.hpp"
 #include "fff.h"
 
@@ -26,6 +29,9 @@
 //  File Variables
 //--------------------------------------------------------------------------------------------------
 
+char     transmitted[1024];
+uint32_t transmitted_len = 0;
+
 
 //--------------------------------------------------------------------------------------------------
 //  Fakes/Mocks
@@ -82,6 +88,23 @@ namespace uart_hal
 {
     FAKE_VALUE_FUNC(error::Error, open, uart::VirtualPort);
     FAKE_VALUE_FUNC(error::Error, send, uart::VirtualPort, const char *);
+    FAKE_VALUE_FUNC(error::Error, transmit, uart::VirtualPort);
+}
+
+namespace mutex
+{
+    FAKE_VOID_FUNC(take, ID);
+    FAKE_VOID_FUNC(give, ID);
+}
+
+namespace isr_hal
+{
+    FAKE_VALUE_FUNC(bool, is_in_interrupt);
+}
+
+namespace timer_osal
+{
+    FAKE_VOID_FUNC(delay_ms, uint32_t);
 }
 
 namespace event
@@ -90,10 +113,24 @@ namespace event
     FAKE_VALUE_FUNC(uint32_t, count, ID);
 }
 
+extern "C" int __io_write(const char *ptr, int len);
+
 //--------------------------------------------------------------------------------------------------
 //  Private Functions
 //--------------------------------------------------------------------------------------------------
 
+static error::Error drain_transmit(uart::VirtualPort id)
+{
+    char c;
+    while (uart::isr_transmit(id, &c))
+    {
+        transmitted[transmitted_len++] = c;
+    }
+    transmitted[transmitted_len] = '\0';
+
+    return error::NoError;
+}
+
 
 //--------------------------------------------------------------------------------------------------
 //  Tests
@@ -117,13 +154,164 @@ TEST(TaskUARTTest, SetOutput)
 {
     uart_hal::open_fake.return_val = error::NoError;
     uart::UART uart                = uart::UART();
+    uart.uart_port                 = uart::VirtualPort::UART_CLI;
     uart.init();
     uart.print_io = true;
 
+    RESET_FAKE(uart_hal::transmit);
+    uart_hal::transmit_fake.custom_fake = drain_transmit;
+    transmitted_len                     = 0;
+
     char str[32] = "Test String";
     uart.set<const char *>(str);
 
-    ASSERT_STREQ(str, uart_hal::send_fake.arg1_val);
+    ASSERT_STREQ(str, transmitted);
+    ASSERT_EQ(uart_hal::send_fake.call_count, 0u);
+    mutex::ID tx_mutex
+        = (mutex::ID)((uint32_t)mutex::ID::UARTTransmit + (uint32_t)uart::VirtualPort::UART_CLI);
+    ASSERT_EQ(mutex::take_fake.arg0_val, tx_mutex);
+    ASSERT_EQ(mutex::give_fake.arg0_val, tx_mutex);
+}
+
+TEST(TaskUARTTest, SetOutputQueueFull)
+{
+    uart_hal::open_fake.return_val = error::NoError;
+    uart::UART uart                = uart::UART();
+    uart.init();
+
+    RESET_FAKE(uart_hal::transmit);
+    uart_hal::transmit_fake.custom_fake = drain_transmit;
+    transmitted_len                     = 0;
+
+    char str[601];
+    memset(str, 'a', sizeof(str) - 1);
+    str[sizeof(str) - 1] = '\0';
+    uart.set<const char *>(str);
+
+    ASSERT_STREQ(str, transmitted);
+    ASSERT_GT(uart_hal::transmit_fake.call_count, 1u);
+}
+
+TEST(TaskUARTTest, SetOutputQueueFullBlocks)
+{
+    uart_hal::open_fake.return_val = error::NoError;
+    uart::UART uart                = uart::UART();
+    uart.uart_port                 = uart::VirtualPort::UART_CLI;
+    uart.init();
+
+    // The HAL doesn't keep up, so it's the TX interrupt that makes room while the task is blocked
+    RESET_FAKE(uart_hal::transmit);
+    RESET_FAKE(timer_osal::delay_ms);
+    timer_osal::delay_ms_fake.custom_fake = [](uint32_t) { drain_transmit(uart::VirtualPort::UART_CLI); };
+    transmitted_len                       = 0;
+
+    char str[601];
+    memset(str, 'a', sizeof(str) - 1);
+    str[sizeof(str) - 1] = '\0';
+    uart.set<const char *>(str);
+
+    ASSERT_GT(timer_osal::delay_ms_fake.call_count, 0u);
+    ASSERT_EQ(transmitted_len, 511u); // Room for all but one, the rest is still queued
+
+    drain_transmit(uart::VirtualPort::UART_CLI);
+    ASSERT_STREQ(str, transmitted);
+}
+
+TEST(TaskUARTTest, QueueFullReleasesMutex)
+{
+    uart::UART aux = uart::UART();
+    aux.uart_port  = uart::VirtualPort::UART_AUX;
+    aux.init();
+
+    // The aux port is full, and its TX mutex must not be held while waiting for room
+    RESET_FAKE(uart_hal::transmit);
+    RESET_FAKE(mutex::take);
+    RESET_FAKE(mutex::give);
+    RESET_FAKE(timer_osal::delay_ms);
+    timer_osal::delay_ms_fake.custom_fake = [](uint32_t)
+    {
+        ASSERT_EQ(mutex::take_fake.call_count, mutex::give_fake.call_count);
+        drain_transmit(uart::VirtualPort::UART_AUX);
+    };
+    transmitted_len = 0;
+
+    char str[601];
+    memset(str, 'a', sizeof(str) - 1);
+    str[sizeof(str) - 1] = '\0';
+    aux.set<const char *>(str);
+
+    mutex::ID aux_mutex
+        = (mutex::ID)((uint32_t)mutex::ID::UARTTransmit + (uint32_t)uart::VirtualPort::UART_AUX);
+    ASSERT_GT(timer_osal::delay_ms_fake.call_count, 0u);
+    ASSERT_EQ(mutex::take_fake.call_count, mutex::give_fake.call_count);
+    for (uint32_t i = 0; i < mutex::take_fake.call_count; i++)
+    {
+        ASSERT_EQ(mutex::take_fake.arg0_history[i], aux_mutex);
+    }
+
+    drain_transmit(uart::VirtualPort::UART_AUX);
+    ASSERT_STREQ(str, transmitted);
+
+    // The console has its own queue and mutex, so it isn't held up by the aux port
+    uart::UART cli = uart::UART();
+    cli.uart_port  = uart::VirtualPort::UART_CLI;
+    cli.init();
+
+    RESET_FAKE(mutex::take);
+    RESET_FAKE(timer_osal::delay_ms);
+    cli.write("x", 1);
+    ASSERT_EQ(mutex::take_fake.arg0_val,
+              (mutex::ID)((uint32_t)mutex::ID::UARTTransmit
+                          + (uint32_t)uart::VirtualPort::UART_CLI));
+    ASSERT_EQ(timer_osal::delay_ms_fake.call_count, 0u);
+}
+
+TEST(TaskUARTTest, WriteBinary)
+{
+    uart_hal::open_fake.return_val = error::NoError;
+    uart::UART uart                = uart::UART();
+    uart.init();
+
+    RESET_FAKE(uart_hal::transmit);
+    uart_hal::transmit_fake.custom_fake = drain_transmit;
+    transmitted_len                     = 0;
+
+    const char data[] = { 'a', '\0', 'b', '\0' };
+    uart.write(data, sizeof(data));
+
+    ASSERT_EQ(transmitted_len, sizeof(data));
+    ASSERT_EQ(memcmp(transmitted, data, sizeof(data)), 0);
+}
+
+TEST(TaskUARTTest, WriteStdout)
+{
+    uart::UART aux = uart::UART();
+    aux.uart_port  = uart::VirtualPort::UART_AUX;
+    aux.init();
+
+    RESET_FAKE(uart_hal::transmit);
+    uart_hal::transmit_fake.custom_fake = drain_transmit;
+    transmitted_len                     = 0;
+
+    uart::UART cli = uart::UART();
+    cli.uart_port  = uart::VirtualPort::UART_CLI;
+    cli.init();
+
+    const char line[] = "line\r\nnot this";
+    ASSERT_EQ(__io_write(line, 6), 6); // Only len characters, no '\0' needed
+    ASSERT_EQ(transmitted_len, 6u);
+    ASSERT_STREQ(transmitted, "line\r\n");
+    ASSERT_EQ(uart_hal::transmit_fake.arg0_val, uart::VirtualPort::UART_CLI);
+
+    RESET_FAKE(uart_hal::transmit);
+    uart::drain(uart::VirtualPort::UART_CLI); // Nothing left to drain
+    ASSERT_EQ(uart_hal::transmit_fake.call_count, 0u);
+
+    // Interrupts can't take the TX mutex, so they're left to poll it out
+    isr_hal::is_in_interrupt_fake.return_val = true;
+    ASSERT_EQ(__io_write(line, 6), -1);
+    ASSERT_EQ(uart_hal::transmit_fake.call_count, 0u);
+    isr_hal::is_in_interrupt_fake.return_val = false;
 }
 
 TEST(TaskUARTTest, GetData)
@@ -135,16 +323,79 @@ TEST(TaskUARTTest, GetData)
 
     char test_str[] = "Test";
 
-    uart::isr_read(test_str[0]);
-    uart::isr_read(test_str[1]);
-    uart::isr_read(test_str[2]);
-    uart::isr_read(test_str[3]);
+    uart::isr_read(uart::VirtualPort::UART_CLI, &test_str[0], 1);
+    uart::isr_read(uart::VirtualPort::UART_CLI, &test_str[1], 3);
 
     const char *data = uart.get<const char *>();
 
     ASSERT_STREQ(data, test_str);
 }
 
+TEST(TaskUARTTest, PeekConsume)
+{
+    uart::UART uart = uart::UART();
+    uart.uart_port  = uart::VirtualPort::UART_CLI;
+    uart.init();
+
+    char fill[504]; // Leaves the queue 8 characters from the end
+    memset(fill, 'x', sizeof(fill));
+    uart::isr_read(uart::VirtualPort::UART_CLI, fill, sizeof(fill));
+
+    uart::Span spans[2];
+    ASSERT_EQ(uart.peek(spans), sizeof(fill));
+    uart.consume(sizeof(fill));
+    ASSERT_EQ(uart.peek(spans), 0u);
+
+    char test_str[] = "wrap around the end";
+    uart::isr_read(uart::VirtualPort::UART_CLI, test_str, strlen(test_str));
+
+    ASSERT_EQ(uart.peek(spans), strlen(test_str));
+    ASSERT_GT(spans[0].len, 0u);
+    ASSERT_GT(spans[1].len, 0u);
+    ASSERT_EQ(strncmp(spans[0].data, test_str, spans[0].len), 0);
+    ASSERT_EQ(strncmp(spans[1].data, &test_str[spans[0].len], spans[1].len), 0);
+
+    uart.consume(spans[0].len);
+
+    ASSERT_EQ(uart.peek(spans), strlen(test_str) - spans[0].len);
+    ASSERT_EQ(spans[1].len, 0u);
+
+    TEST_ERROR(uart.consume(spans[0].len + 1));
+}
+
+TEST(TaskUARTTest, PerPortQueues)
+{
+    uart::UART cli = uart::UART();
+    cli.uart_port  = uart::VirtualPort::UART_CLI;
+    cli.init();
+
+    uart::UART aux = uart::UART();
+    aux.uart_port  = uart::VirtualPort::UART_AUX;
+    aux.init();
+
+    RESET_FAKE(event::post);
+
+    uart::isr_read(uart::VirtualPort::UART_AUX, "aux", 3);
+    uart::isr_read(uart::VirtualPort::UART_CLI, "cli", 3);
+
+    ASSERT_EQ(event::post_fake.call_count, 2u);
+    ASSERT_EQ(event::post_fake.arg1_history[0], (void *)uart::VirtualPort::UART_AUX);
+    ASSERT_STREQ(aux.get<const char *>(), "aux");
+    ASSERT_STREQ(cli.get<const char *>(), "cli");
+
+    RESET_FAKE(uart_hal::transmit);
+    uart_hal::transmit_fake.custom_fake = drain_transmit;
+    transmitted_len                     = 0;
+
+    aux.set<const char *>("out");
+
+    ASSERT_STREQ(transmitted, "out");
+    ASSERT_EQ(uart_hal::transmit_fake.arg0_val, uart::VirtualPort::UART_AUX);
+
+    char c;
+    ASSERT_FALSE(uart::isr_transmit(uart::VirtualPort::UART_CLI, &c));
+}
+
 TEST(TaskUARTTest, ReadISR)
 {
     uart::UART uart = uart::UART();
@@ -152,9 +403,53 @@ TEST(TaskUARTTest, ReadISR)
     uart.init();
 
     char test_char = 'T';
-    uart::isr_read(test_char);
+    uart::isr_read(uart::VirtualPort::UART_CLI, &test_char, 1);
 
     ASSERT_TRUE(event::post_fake.call_count);
 }
 
+TEST(TaskUARTTest, ReadISRBatch)
+{
+    uart::UART uart = uart::UART();
+    uart.uart_port  = uart::VirtualPort::UART_CLI;
+    uart.init();
+
+    RESET_FAKE(event::post);
+
+    char test_str[] = "help\r";
+    uart::isr_read(uart::VirtualPort::UART_CLI, test_str, strlen(test_str));
+
+    ASSERT_EQ(event::post_fake.call_count, 1u);
+    ASSERT_EQ(event::post_fake.arg0_val, event::ID::control_UARTInput);
+    ASSERT_STREQ(uart.get<const char *>(), test_str);
+
+    uart::isr_read(uart::VirtualPort::UART_CLI, test_str, 0);
+
+    ASSERT_EQ(event::post_fake.call_count, 1u);
+}
+
+TEST(TaskUARTTest, ReadISROverflow)
+{
+    uart::UART uart = uart::UART();
+    uart.uart_port  = uart::VirtualPort::UART_CLI;
+    uart.init();
+
+    char fill[600];
+    memset(fill, 'x', sizeof(fill));
+    uart::isr_read(uart::VirtualPort::UART_CLI, fill, sizeof(fill));
+
+    uart::Span spans[2];
+    uint32_t   queued = uart.peek(spans);
+    ASSERT_LT(queued, sizeof(fill));
+    ASSERT_EQ(uart.dropped(), sizeof(fill) - queued); // Counted rather than fatal
+
+    uart.consume(queued);
+    uart::isr_read(uart::VirtualPort::UART_CLI, "ok", 2);
+    ASSERT_STREQ(uart.get<const char *>(), "ok");
+    ASSERT_EQ(uart.dropped(), sizeof(fill) - queued);
+
+    uart.init();
+    ASSERT_EQ(uart.dropped(), 0u);
+}
+
 // End of File
\ No newline at end of file
@@ -15,6 +15,8 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <cstring>
+
 //--------------------------------------------------------------------------------------------------
 //  Private Constants
 //--------------------------------------------------------------------------------------------------
@@ -24,6 +26,8 @@
 //  File Variables
 //--------------------------------------------------------------------------------------------------
 
+char     written[1024];
+uint32_t sink_calls = 0;
 
 //--------------------------------------------------------------------------------------------------
 //  Fakes/Mocks
@@ -36,6 +40,22 @@ DEFINE_FFF_GLOBALS;
 //  Private Functions
 //--------------------------------------------------------------------------------------------------
 
+void sink(void *context, const char *chunk)
+{
+    ASSERT_EQ(context, (void *)written);
+    ASSERT_LE(strlen(chunk), utility::WRITER_CHUNK_SIZE);
+
+    strcat(written, chunk);
+    sink_calls++;
+}
+
+void init_writer(utility::Writer *out)
+{
+    written[0] = '\0';
+    sink_calls = 0;
+
+    out->init(sink, written);
+}
 
 //--------------------------------------------------------------------------------------------------
 //  Tests
@@ -82,4 +102,53 @@ TEST(UtilityTest, SwapByteOrderZeroLen)
     ASSERT_EQ(data[3], 0x78);
 }
 
+TEST(UtilityTest, WriterChunks)
+{
+    utility::Writer out;
+    init_writer(&out);
+
+    char str[(utility::WRITER_CHUNK_SIZE * 2) + 11];
+    memset(str, 'a', sizeof(str) - 1);
+    str[sizeof(str) - 1] = '\0';
+
+    out.write(str);
+    ASSERT_EQ(sink_calls, 2u);
+
+    out.flush();
+    ASSERT_EQ(sink_calls, 3u);
+    ASSERT_STREQ(written, str);
+
+    out.flush();
+    ASSERT_EQ(sink_calls, 3u);
+}
+
+TEST(UtilityTest, WriterPrint)
+{
+    utility::Writer out;
+    init_writer(&out);
+
+    char str[utility::WRITER_CHUNK_SIZE - 4];
+    memset(str, 'b', sizeof(str) - 1);
+    str[sizeof(str) - 1] = '\0';
+
+    out.write(str);
+    out.print("%d %s", 12345, "end");
+    ASSERT_EQ(sink_calls, 1u); // Didn't fit, previous text was flushed first
+    ASSERT_STREQ(written, str);
+
+    out.flush();
+    ASSERT_EQ(sink_calls, 2u);
+    ASSERT_STREQ(&written[strlen(str)], "12345 end");
+
+    init_writer(&out);
+
+    char long_str[utility::WRITER_CHUNK_SIZE * 2];
+    memset(long_str, 'c', sizeof(long_str) - 1);
+    long_str[sizeof(long_str) - 1] = '\0';
+
+    out.print("%s", long_str);
+    out.flush();
+    ASSERT_EQ(strlen(written), utility::WRITER_CHUNK_SIZE); // Truncated
+}
+
 // End of File
\ No newline at end of file
@@ -0,0 +1,265 @@
+/// @file watch_test.cpp
+/// @author Denver Hoggatt
+/// @brief Unit tests for the input watch.
+///
+/// Copyright (c) 2025 Denver Hoggatt. All rights reserved.
+///
+/// This software is licensed under terms that can be found in the LICENSE file
+/// in the root directory of this software component.
+/// If no LICENSE file comes with this software, it is provided AS-IS.
+///
+
+#include "watch.hpp"
+#include "event.hpp"
+#include "input.hpp"
+#include "periodic.hpp"
+#include "protocol.hpp"
+#include "macros.hpp"
+#include "fff.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cstring>
+
+//--------------------------------------------------------------------------------------------------
+//  Private Constants
+//--------------------------------------------------------------------------------------------------
+
+
+//--------------------------------------------------------------------------------------------------
+//  File Variables
+//--------------------------------------------------------------------------------------------------
+
+uint32_t input_val = 0;
+
+char     captured[256];
+uint32_t captured_len = 0;
+
+protocol::Sample telemetry[watch::MAX_INPUTS];
+uint32_t         telemetry_count = 0;
+
+//--------------------------------------------------------------------------------------------------
+//  Fakes/Mocks
+//--------------------------------------------------------------------------------------------------
+
+DEFINE_FFF_GLOBALS;
+
+namespace input
+{
+    FAKE_VALUE_FUNC(Input *, get_by_id, io::IOID);
+
+    char *Input::cmd_input()
+    {
+        return nullptr;
+    }
+}
+
+namespace periodic
+{
+    FAKE_VOID_FUNC(stop, ID);
+    FAKE_VOID_FUNC(start, ID);
+    FAKE_VOID_FUNC(create, ID, CallbackFunc);
+    FAKE_VOID_FUNC(set_period, ID, uint32_t);
+}
+
+namespace event
+{
+    FAKE_VOID_FUNC(post, ID, void *);
+}
+
+namespace protocol
+{
+    FAKE_VALUE_FUNC(bool, active);
+    FAKE_VALUE_FUNC(Status, read_input, input::Input *, uint32_t *);
+    FAKE_VOID_FUNC(send_telemetry, const Sample *, uint32_t);
+}
+
+class TestInput : public input::Input
+{
+    public:
+        void *get_by_id()
+        {
+            return (void *)(uintptr_t)input_val;
+        }
+
+        void init()
+        {
+            this->type       = io::IOType::ADC;
+            this->input_type = &typeid(uint32_t);
+            this->print_io   = false;
+        }
+
+        void print(void *data, io::IODirection dir)
+        {
+            UNUSED(data);
+            UNUSED(dir);
+        }
+};
+
+//--------------------------------------------------------------------------------------------------
+//  Private Functions
+//--------------------------------------------------------------------------------------------------
+
+void capture_chunk(void *context, const char *chunk)
+{
+    UNUSED(context);
+
+    uint32_t len = strlen(chunk);
+    ASSERT_LT(captured_len + len, sizeof(captured));
+
+    memcpy(&captured[captured_len], chunk, len + 1);
+    captured_len += len;
+}
+
+/// @brief Takes a sample, returning everything written for it.
+///
+const char *sample(uint32_t time_ms)
+{
+    captured[0]  = '\0';
+    captured_len = 0;
+
+    utility::Writer out;
+    out.init(capture_chunk, nullptr);
+    watch::sample(&out, time_ms);
+    out.flush();
+
+    return captured;
+}
+
+protocol::Status read_test_input(input::Input *in, uint32_t *value)
+{
+    *value = in->get<uint32_t>();
+
+    return protocol::Status::Ok;
+}
+
+void capture_telemetry(const protocol::Sample *samples, uint32_t count)
+{
+    memcpy(telemetry, samples, count * sizeof(samples[0]));
+    telemetry_count = count;
+}
+
+void reset_fakes()
+{
+    RESET_FAKE(input::get_by_id);
+    RESET_FAKE(periodic::stop);
+    RESET_FAKE(periodic::start);
+    RESET_FAKE(periodic::create);
+    RESET_FAKE(periodic::set_period);
+    RESET_FAKE(event::post);
+    RESET_FAKE(protocol::active);
+    RESET_FAKE(protocol::read_input);
+    RESET_FAKE(protocol::send_telemetry);
+}
+
+//--------------------------------------------------------------------------------------------------
+//  Tests
+//--------------------------------------------------------------------------------------------------
+
+TEST(WatchTest, StartStop)
+{
+    reset_fakes();
+
+    TestInput test_input;
+    test_input.init();
+
+    const io::IOID ids[watch::MAX_INPUTS + 1] = { io::IOID::INPUT_1 };
+
+    input::get_by_id_fake.return_val = nullptr;
+    ASSERT_FALSE(watch::start(ids, 1, 10)); // Not an input
+
+    input::get_by_id_fake.return_val = &test_input;
+    ASSERT_FALSE(watch::start(ids, 0, 10));
+    ASSERT_FALSE(watch::start(ids, watch::MAX_INPUTS + 1, 10));
+    ASSERT_FALSE(watch::start(ids, 1, 0));
+    ASSERT_FALSE(watch::start(ids, 1, watch::MAX_RATE_HZ + 1));
+    ASSERT_FALSE(watch::start(ids, 1, 300)); // Would run at 333Hz
+    ASSERT_EQ(periodic::create_fake.call_count, 0u);
+    ASSERT_FALSE(watch::active());
+
+    ASSERT_TRUE(watch::start(ids, 1, 100));
+    ASSERT_TRUE(watch::active());
+    ASSERT_EQ(periodic::create_fake.arg0_val, periodic::ID::IOWatch);
+    ASSERT_EQ(periodic::set_period_fake.arg1_val, 10u);
+    ASSERT_EQ(periodic::start_fake.arg0_val, periodic::ID::IOWatch);
+
+    watch::stop();
+    ASSERT_FALSE(watch::active());
+    ASSERT_EQ(periodic::stop_fake.arg0_val, periodic::ID::IOWatch);
+    ASSERT_STREQ(sample(0), ""); // Sample posted before the stop is ignored
+}
+
+TEST(WatchTest, Text)
+{
+    reset_fakes();
+
+    TestInput test_input;
+    test_input.init();
+    input::get_by_id_fake.return_val = &test_input;
+    input_val                        = 7;
+
+    TestInput bool_input;
+    bool_input.init();
+    bool_input.input_type = &typeid(bool);
+
+    input::Input *inputs[] = { &test_input, &bool_input };
+    SET_RETURN_SEQ(input::get_by_id, inputs, 2);
+
+    const io::IOID ids[] = { io::IOID::INPUT_1, io::IOID::INPUT_1 };
+    ASSERT_TRUE(watch::start(ids, 2, 1000));
+
+    periodic::CallbackFunc callback = periodic::create_fake.arg1_val;
+    ASSERT_NE(callback, nullptr);
+
+    callback(123);
+    ASSERT_EQ(event::post_fake.call_count, 1u);
+    ASSERT_EQ(event::post_fake.arg0_val, event::ID::control_IOWatch);
+    ASSERT_EQ(event::post_fake.arg1_val, (void *)123);
+
+    callback(124); // Last sample not handled yet
+    ASSERT_EQ(event::post_fake.call_count, 1u);
+    ASSERT_EQ(watch::overruns(), 1u);
+
+    ASSERT_STREQ(sample(123), "123 7 1\r\n");
+
+    callback(125);
+    ASSERT_EQ(event::post_fake.call_count, 2u);
+
+    watch::stop();
+}
+
+TEST(WatchTest, Telemetry)
+{
+    reset_fakes();
+
+    TestInput test_input;
+    test_input.init();
+    input::get_by_id_fake.return_val = &test_input;
+    input_val                        = 0x1234;
+
+    protocol::active_fake.return_val          = true;
+    protocol::read_input_fake.custom_fake     = read_test_input;
+    protocol::send_telemetry_fake.custom_fake = capture_telemetry;
+    test_input.id                             = io::IOID::INPUT_1;
+
+    const io::IOID ids[] = { io::IOID::INPUT_1 };
+    ASSERT_TRUE(watch::start(ids, 1, 50));
+    ASSERT_EQ(periodic::set_period_fake.arg1_val, 20u);
+    ASSERT_EQ(watch::overruns(), 0u);
+
+    ASSERT_STREQ(sample(10), ""); // Goes out as a frame instead
+    ASSERT_EQ(protocol::send_telemetry_fake.call_count, 1u);
+    ASSERT_EQ(telemetry_count, 1u);
+    ASSERT_EQ(telemetry[0].id, io::IOID::INPUT_1);
+    ASSERT_EQ(telemetry[0].value, 0x1234u);
+
+    protocol::read_input_fake.custom_fake = nullptr;
+    protocol::read_input_fake.return_val  = protocol::Status::UnknownType;
+    sample(11);
+    ASSERT_EQ(telemetry_count, 0u); // Left out
+
+    watch::stop();
+}
+
+// End of File